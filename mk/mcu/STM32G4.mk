@@ -151,6 +151,7 @@ MCU_COMMON_SRC = \
             drivers/stm32/bus_i2c_hal_init.c \
             drivers/stm32/bus_i2c_hal.c \
             drivers/stm32/bus_spi_ll.c \
+            drivers/stm32/crc_stm32.c \
             drivers/stm32/debug.c \
             drivers/stm32/dma_reqmap_mcu.c \
             drivers/stm32/dma_stm32g4xx.c \
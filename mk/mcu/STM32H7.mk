@@ -307,6 +307,7 @@ MCU_COMMON_SRC = \
             drivers/stm32/bus_spi_ll.c \
             drivers/stm32/bus_quadspi_hal.c \
             drivers/stm32/bus_octospi_stm32h7xx.c \
+            drivers/stm32/crc_stm32.c \
             drivers/stm32/debug.c \
             drivers/stm32/dma_reqmap_mcu.c \
             drivers/stm32/dma_stm32h7xx.c \
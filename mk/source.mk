@@ -2,6 +2,7 @@ COMMON_SRC = \
             build/build_config.c \
             build/debug.c \
             build/debug_pin.c \
+            build/trace.c \
             build/version.c \
             $(TARGET_DIR_SRC) \
             main.c \
@@ -25,6 +26,7 @@ COMMON_SRC = \
             drivers/bus_spi.c \
             drivers/bus_spi_config.c \
             drivers/bus_spi_pinconfig.c \
+            drivers/bus_spi_queue.c \
             drivers/buttons.c \
             drivers/display.c \
             drivers/display_canvas.c \
@@ -48,6 +50,7 @@ COMMON_SRC = \
             drivers/transponder_ir_ilap.c \
             drivers/transponder_ir_erlt.c \
             fc/board_info.c \
+            fc/boot.c \
             fc/dispatch.c \
             fc/hardfaults.c \
             fc/tasks.c \
@@ -180,6 +183,7 @@ COMMON_SRC = \
             sensors/barometer.c \
             sensors/rangefinder.c \
             telemetry/telemetry.c \
+            telemetry/frame_scheduler.c \
             telemetry/crsf.c \
             telemetry/ghst.c \
             telemetry/srxl.c \
@@ -286,6 +290,7 @@ SPEED_OPTIMISED_SRC := ""
 SIZE_OPTIMISED_SRC  := ""
 
 SPEED_OPTIMISED_SRC := $(SPEED_OPTIMISED_SRC) \
+            build/trace.c \
             common/encoding.c \
             common/filter.c \
             common/maths.c \
@@ -308,6 +313,7 @@ SPEED_OPTIMISED_SRC := $(SPEED_OPTIMISED_SRC) \
             drivers/bus.c \
             drivers/bus_quadspi.c \
             drivers/bus_spi.c \
+            drivers/bus_spi_queue.c \
             drivers/exti.c \
             drivers/io.c \
             drivers/pwm_output.c \
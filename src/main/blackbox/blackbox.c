@@ -39,6 +39,7 @@
 #include "common/axis.h"
 #include "common/encoding.h"
 #include "common/maths.h"
+#include "common/printf.h"
 #include "common/time.h"
 #include "common/utils.h"
 
@@ -53,6 +54,7 @@
 #endif
 
 #include "fc/board_info.h"
+#include "fc/core.h"
 #include "fc/controlrate_profile.h"
 #include "fc/parameter_names.h"
 #include "fc/rc.h"
@@ -90,17 +92,21 @@
 #define DEFAULT_BLACKBOX_DEVICE     BLACKBOX_DEVICE_NONE
 #endif
 
-PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 3);
+PG_REGISTER_WITH_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig, PG_BLACKBOX_CONFIG, 4);
 
 PG_RESET_TEMPLATE(blackboxConfig_t, blackboxConfig,
     .fields_disabled_mask = 0, // default log all fields
     .sample_rate = BLACKBOX_RATE_QUARTER,
     .device = DEFAULT_BLACKBOX_DEVICE,
     .mode = BLACKBOX_MODE_NORMAL,
-    .high_resolution = false
+    .high_resolution = false,
+    .fields_rate = { 0 }, // default log all fields in every P-frame
+    .burst_duration_ms = 1000,
+    .burst_noise_percent = 300,
 );
 
 STATIC_ASSERT((sizeof(blackboxConfig()->fields_disabled_mask) * 8) >= FLIGHT_LOG_FIELD_SELECT_COUNT, too_many_flight_log_fields_selections);
+STATIC_ASSERT(BLACKBOX_FIELD_GROUP_COUNT >= FLIGHT_LOG_FIELD_SELECT_COUNT, too_many_flight_log_field_rates);
 
 #define BLACKBOX_SHUTDOWN_TIMEOUT_MILLIS 200
 
@@ -403,6 +409,12 @@ STATIC_UNIT_TESTED int8_t blackboxPInterval = 0;
 STATIC_UNIT_TESTED int32_t blackboxSInterval = 0;
 STATIC_UNIT_TESTED int32_t blackboxSlowFrameIterationTimer;
 static bool blackboxLoggedAnyFrames;
+// field groups logged at a fraction of the P-frame rate
+static uint16_t blackboxDecimatedFieldMask;
+STATIC_UNIT_TESTED bool blackboxBurstActive;
+static timeUs_t blackboxBurstEndUs;
+static int16_t blackboxBurstLastGyro[XYZ_AXIS_COUNT];
+static int32_t blackboxGyroNoiseAverage;
 static float blackboxHighResolutionScale;
 
 /*
@@ -441,6 +453,68 @@ static bool isFieldEnabled(FlightLogFieldSelect_e field)
     return (blackboxConfig()->fields_disabled_mask & (1 << field)) == 0;
 }
 
+static bool isFieldDecimated(FlightLogFieldSelect_e field)
+{
+    return blackboxDecimatedFieldMask & (1 << field);
+}
+
+/*
+ * Decimated field groups are only refreshed in every 2^fields_rate P-frames, counted from the last I-frame.
+ * In the other P-frames they repeat their previous value. See blackboxMainFieldPPredictor() for how that
+ * is kept down to a zero delta.
+ */
+STATIC_UNIT_TESTED bool blackboxShouldLogField(FlightLogFieldSelect_e field)
+{
+    if (!isFieldDecimated(field) || blackboxBurstActive || blackboxPInterval == 0) {
+        return true;
+    }
+
+    const unsigned pFrameNumber = blackboxLoopIndex / blackboxPInterval;
+    return (pFrameNumber & ((1 << blackboxConfig()->fields_rate[field]) - 1)) == 0;
+}
+
+/*
+ * A repeated value would not encode as a zero delta against the average of the two previous frames, so
+ * the noisy groups normally predicted that way are predicted from the previous frame while decimated.
+ * The predictor is announced in the log header, so decoders follow it.
+ */
+STATIC_UNIT_TESTED uint8_t blackboxMainFieldPPredictor(uint8_t predictor, uint8_t condition)
+{
+    if (predictor != PREDICT(AVERAGE_2)) {
+        return predictor;
+    }
+
+    FlightLogFieldSelect_e field;
+    switch (condition) {
+    case CONDITION(GYRO):
+        field = FIELD_SELECT(GYRO);
+        break;
+    case CONDITION(GYROUNFILT):
+        field = FIELD_SELECT(GYROUNFILT);
+        break;
+    case CONDITION(ACC):
+        field = FIELD_SELECT(ACC);
+        break;
+    case CONDITION(DEBUG_LOG):
+        field = FIELD_SELECT(DEBUG_LOG);
+        break;
+    case CONDITION(AT_LEAST_MOTORS_1):
+    case CONDITION(AT_LEAST_MOTORS_2):
+    case CONDITION(AT_LEAST_MOTORS_3):
+    case CONDITION(AT_LEAST_MOTORS_4):
+    case CONDITION(AT_LEAST_MOTORS_5):
+    case CONDITION(AT_LEAST_MOTORS_6):
+    case CONDITION(AT_LEAST_MOTORS_7):
+    case CONDITION(AT_LEAST_MOTORS_8):
+        field = FIELD_SELECT(MOTOR);
+        break;
+    default:
+        return predictor;
+    }
+
+    return isFieldDecimated(field) ? PREDICT(PREVIOUS) : predictor;
+}
+
 static bool testBlackboxConditionUncached(FlightLogFieldCondition condition)
 {
     switch (condition) {
@@ -719,12 +793,17 @@ static void writeIntraframe(void)
     blackboxLoggedAnyFrames = true;
 }
 
-static void blackboxWriteMainStateArrayUsingAveragePredictor(int arrOffsetInHistory, int count)
+static void blackboxWriteMainStateArrayUsingAveragePredictor(FlightLogFieldSelect_e field, int arrOffsetInHistory, int count)
 {
     int16_t *curr  = (int16_t*) ((char*) (blackboxHistory[0]) + arrOffsetInHistory);
     int16_t *prev1 = (int16_t*) ((char*) (blackboxHistory[1]) + arrOffsetInHistory);
     int16_t *prev2 = (int16_t*) ((char*) (blackboxHistory[2]) + arrOffsetInHistory);
 
+    // Decimated groups are predicted from the previous state instead, see blackboxMainFieldPPredictor()
+    if (isFieldDecimated(field)) {
+        prev2 = prev1;
+    }
+
     for (int i = 0; i < count; i++) {
         // Predictor is the average of the previous two history states
         int32_t predictor = (prev1[i] + prev2[i]) / 2;
@@ -831,20 +910,20 @@ static void writeInterframe(void)
 
     //Since gyros, accs and motors are noisy, base their predictions on the average of the history:
     if (testBlackboxCondition(CONDITION(GYRO))) {
-        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroADC),   XYZ_AXIS_COUNT);
+        blackboxWriteMainStateArrayUsingAveragePredictor(FIELD_SELECT(GYRO), offsetof(blackboxMainState_t, gyroADC),   XYZ_AXIS_COUNT);
     }
     if (testBlackboxCondition(CONDITION(GYROUNFILT))) {
-        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, gyroUnfilt),   XYZ_AXIS_COUNT);
+        blackboxWriteMainStateArrayUsingAveragePredictor(FIELD_SELECT(GYROUNFILT), offsetof(blackboxMainState_t, gyroUnfilt),   XYZ_AXIS_COUNT);
     }
     if (testBlackboxCondition(CONDITION(ACC))) {
-        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, accADC), XYZ_AXIS_COUNT);
+        blackboxWriteMainStateArrayUsingAveragePredictor(FIELD_SELECT(ACC), offsetof(blackboxMainState_t, accADC), XYZ_AXIS_COUNT);
     }
     if (testBlackboxCondition(CONDITION(DEBUG_LOG))) {
-        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, debug), DEBUG16_VALUE_COUNT);
+        blackboxWriteMainStateArrayUsingAveragePredictor(FIELD_SELECT(DEBUG_LOG), offsetof(blackboxMainState_t, debug), DEBUG16_VALUE_COUNT);
     }
 
     if (isFieldEnabled(FIELD_SELECT(MOTOR))) {
-        blackboxWriteMainStateArrayUsingAveragePredictor(offsetof(blackboxMainState_t, motor),     getMotorCount());
+        blackboxWriteMainStateArrayUsingAveragePredictor(FIELD_SELECT(MOTOR), offsetof(blackboxMainState_t, motor),     getMotorCount());
 
         if (testBlackboxCondition(FLIGHT_LOG_FIELD_CONDITION_TRICOPTER)) {
             blackboxWriteSignedVB(blackboxCurrent->servo[5] - blackboxLast->servo[5]);
@@ -961,6 +1040,8 @@ static void blackboxResetIterationTimers(void)
     blackboxIFrameIndex = 0;
     blackboxPFrameIndex = 0;
     blackboxSlowFrameIterationTimer = 0;
+    blackboxBurstActive = false;
+    blackboxGyroNoiseAverage = 0;
 }
 
 /**
@@ -1291,7 +1372,11 @@ static bool sendFieldDefinition(char mainFrameChar, char deltaFrameChar, const v
                 }
             } else {
                 //The other headers are integers
-                blackboxPrintf("%d", def->arr[xmitState.headerIndex - 1]);
+                uint8_t value = def->arr[xmitState.headerIndex - 1];
+                if (deltaFrameChar == 'P' && xmitState.headerIndex == BLACKBOX_SIMPLE_FIELD_HEADER_COUNT) {
+                    value = blackboxMainFieldPPredictor(value, conditions[conditionsStride * xmitState.u.fieldIndex]);
+                }
+                blackboxPrintf("%d", value);
             }
         }
     }
@@ -1532,7 +1617,8 @@ static bool blackboxWriteSysinfo(void)
 #endif
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_SOURCE, "%d",      positionConfig()->altitude_source);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_PREFER_BARO, "%d", positionConfig()->altitude_prefer_baro);
-        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_LPF, "%d",         positionConfig()->altitude_lpf);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_BARO_NOISE, "%d",  positionConfig()->altitude_baro_noise);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_ACC_NOISE, "%d",   positionConfig()->altitude_acc_noise);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_POSITION_ALTITUDE_D_LPF, "%d",       positionConfig()->altitude_d_lpf);
 
 #ifdef USE_MAG
@@ -1558,6 +1644,7 @@ static bool blackboxWriteSysinfo(void)
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_RC_SMOOTHING_THROTTLE_CUTOFF, "%d",    rcSmoothingData->throttleCutoffSetting);
 
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_RC_SMOOTHING_DEBUG_AXIS, "%d",         rcSmoothingData->debugAxis);
+        BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_RC_SMOOTHING_PREDICT, "%d",            rxConfig()->rc_smoothing_predict);
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_RC_SMOOTHING_ACTIVE_CUTOFFS, "%d,%d,%d", rcSmoothingData->feedforwardCutoffFrequency,
                                                                             rcSmoothingData->setpointCutoffFrequency,
                                                                             rcSmoothingData->throttleCutoffFrequency);
@@ -1567,6 +1654,16 @@ static bool blackboxWriteSysinfo(void)
 
         BLACKBOX_PRINT_HEADER_LINE("fields_disabled_mask", "%d",            blackboxConfig()->fields_disabled_mask);
         BLACKBOX_PRINT_HEADER_LINE("blackbox_high_resolution", "%d",        blackboxConfig()->high_resolution);
+        BLACKBOX_PRINT_HEADER_LINE_CUSTOM(
+            char rates[BLACKBOX_FIELD_GROUP_COUNT * 4];
+            char *ptr = rates;
+            for (unsigned i = 0; i < ARRAYLEN(blackboxConfig()->fields_rate); i++) {
+                ptr += tfp_sprintf(ptr, i ? ",%d" : "%d", blackboxConfig()->fields_rate[i]);
+            }
+            blackboxPrintfHeaderLine("fields_rate", "%s", rates);
+            );
+        BLACKBOX_PRINT_HEADER_LINE("blackbox_burst", "%d,%d",               blackboxConfig()->burst_duration_ms,
+                                                                            blackboxConfig()->burst_noise_percent);
 
 #ifdef USE_BATTERY_VOLTAGE_SAG_COMPENSATION
         BLACKBOX_PRINT_HEADER_LINE(PARAM_NAME_VBAT_SAG_COMPENSATION, "%d",   currentPidProfile->vbat_sag_compensation);
@@ -1775,6 +1872,85 @@ STATIC_UNIT_TESTED void blackboxAdvanceIterationTimers(void)
     }
 }
 
+#define BLACKBOX_NOISE_AVERAGE_SHIFT 6 // running average over 64 P-frames
+#define BLACKBOX_NOISE_FLOOR 30 // sum of the gyro steps between P-frames that never starts a burst, filters out noise at rest
+
+// Log every field group at the full P-frame rate for a while after a crash or a sudden rise in gyro noise
+STATIC_UNIT_TESTED void blackboxUpdateBurst(timeUs_t currentTimeUs)
+{
+    if (!blackboxDecimatedFieldMask || blackboxConfig()->burst_duration_ms == 0) {
+        blackboxBurstActive = false;
+        return;
+    }
+
+    bool trigger = crashRecoveryModeActive() || isFlipOverAfterCrashActive();
+
+    if (blackboxConfig()->burst_noise_percent) {
+        const int16_t *gyroADC = blackboxHistory[0]->gyroADC;
+        int32_t noise = 0;
+        for (int i = 0; i < XYZ_AXIS_COUNT; i++) {
+            noise += ABS(gyroADC[i] - blackboxBurstLastGyro[i]);
+            blackboxBurstLastGyro[i] = gyroADC[i];
+        }
+
+        const int32_t average = blackboxGyroNoiseAverage >> BLACKBOX_NOISE_AVERAGE_SHIFT;
+        if (noise > BLACKBOX_NOISE_FLOOR && noise * 100 > average * blackboxConfig()->burst_noise_percent) {
+            trigger = true;
+        }
+        blackboxGyroNoiseAverage += noise - average;
+    }
+
+    if (trigger) {
+        blackboxBurstEndUs = currentTimeUs + blackboxConfig()->burst_duration_ms * 1000;
+        blackboxBurstActive = true;
+    } else if (blackboxBurstActive && cmpTimeUs(currentTimeUs, blackboxBurstEndUs) >= 0) {
+        blackboxBurstActive = false;
+    }
+}
+
+#define HOLD_FIELD(field) memcpy(current->field, last->field, sizeof(current->field))
+
+// Replace the fields of decimated groups with the values logged in the previous frame
+static void blackboxHoldDecimatedFields(void)
+{
+    blackboxMainState_t *current = blackboxHistory[0];
+    const blackboxMainState_t *last = blackboxHistory[1];
+
+    if (!blackboxShouldLogField(FIELD_SELECT(PID))) {
+        HOLD_FIELD(axisPID_P);
+        HOLD_FIELD(axisPID_I);
+        HOLD_FIELD(axisPID_D);
+        HOLD_FIELD(axisPID_F);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(RC_COMMANDS))) {
+        HOLD_FIELD(rcCommand);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(SETPOINT))) {
+        HOLD_FIELD(setpoint);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(GYRO))) {
+        HOLD_FIELD(gyroADC);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(GYROUNFILT))) {
+        HOLD_FIELD(gyroUnfilt);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(ACC))) {
+        HOLD_FIELD(accADC);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(DEBUG_LOG))) {
+        HOLD_FIELD(debug);
+    }
+    if (!blackboxShouldLogField(FIELD_SELECT(MOTOR))) {
+        HOLD_FIELD(motor);
+        HOLD_FIELD(servo);
+    }
+#ifdef USE_DSHOT_TELEMETRY
+    if (!blackboxShouldLogField(FIELD_SELECT(RPM))) {
+        HOLD_FIELD(erpm);
+    }
+#endif
+}
+
 // Called once every FC loop in order to log the current state
 STATIC_UNIT_TESTED void blackboxLogIteration(timeUs_t currentTimeUs)
 {
@@ -1802,6 +1978,10 @@ STATIC_UNIT_TESTED void blackboxLogIteration(timeUs_t currentTimeUs)
             writeSlowFrameIfNeeded();
 
             loadMainState(currentTimeUs);
+            if (blackboxDecimatedFieldMask) {
+                blackboxUpdateBurst(currentTimeUs);
+                blackboxHoldDecimatedFields();
+            }
             writeInterframe();
         }
 #ifdef USE_GPS
@@ -2072,6 +2252,13 @@ void blackboxInit(void)
         blackboxPInterval = 0; // log only I frames if logging frequency is too low
     }
 
+    blackboxDecimatedFieldMask = 0;
+    for (int field = 0; field < FLIGHT_LOG_FIELD_SELECT_COUNT; field++) {
+        if (blackboxConfig()->fields_rate[field] != BLACKBOX_RATE_ONE) {
+            blackboxDecimatedFieldMask |= 1 << field;
+        }
+    }
+
     if (blackboxConfig()->device) {
         blackboxSetState(BLACKBOX_STATE_STOPPED);
     } else {
@@ -58,12 +58,17 @@ typedef enum FlightLogEvent {
     FLIGHT_LOG_EVENT_LOG_END = 255
 } FlightLogEvent;
 
+#define BLACKBOX_FIELD_GROUP_COUNT 16 // at least FLIGHT_LOG_FIELD_SELECT_COUNT
+
 typedef struct blackboxConfig_s {
     uint32_t fields_disabled_mask;
     uint8_t sample_rate; // sample rate
     uint8_t device;
     uint8_t mode;
     uint8_t high_resolution;
+    uint8_t fields_rate[BLACKBOX_FIELD_GROUP_COUNT]; // BlackboxSampleRate_e of each field group relative to the P-frame rate
+    uint16_t burst_duration_ms; // log every field group at the P-frame rate for this long after a crash or gyro noise spike, 0 to disable
+    uint16_t burst_noise_percent; // gyro noise rise over its running average that starts a burst, 0 to disable
 } blackboxConfig_t;
 
 PG_DECLARE(blackboxConfig_t, blackboxConfig);
@@ -0,0 +1,74 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+
+#include "platform.h"
+
+#ifdef USE_TRACE
+
+#include "drivers/system.h"
+
+#include "trace.h"
+
+static traceRecord_t traceBuffer[TRACE_BUFFER_SIZE];
+static volatile uint32_t traceHead;     // sequence number of the next record to be written
+
+// May be called from interrupt context. The slot is claimed atomically so nested writers never share
+// a record. The time is read before the slot is claimed, so a writer interrupted in between ends up
+// after the interrupt's record with an earlier time; the host sorts on time to restore the order.
+// A reader copying a record while it is being written may still see it part written.
+FAST_CODE void traceRecord(traceType_e type, uint8_t id, uint16_t arg)
+{
+    const uint32_t cycles = getCycleCounter();
+    const uint32_t sequence = __sync_fetch_and_add(&traceHead, 1);
+    traceRecord_t *record = &traceBuffer[sequence & (TRACE_BUFFER_SIZE - 1)];
+
+    record->cycles = cycles;
+    record->type = type;
+    record->id = id;
+    record->arg = arg;
+}
+
+uint32_t traceGetHead(void)
+{
+    return traceHead;
+}
+
+// Copy up to maxCount records starting at *sequence. If that record has already been overwritten
+// copying starts at the oldest record still held and *sequence is updated to match.
+unsigned traceGetRecords(uint32_t *sequence, traceRecord_t *records, unsigned maxCount)
+{
+    const uint32_t head = traceHead;
+    const uint32_t oldest = (head > TRACE_BUFFER_SIZE) ? head - TRACE_BUFFER_SIZE : 0;
+
+    if ((int32_t)(*sequence - oldest) < 0 || (int32_t)(head - *sequence) < 0) {
+        *sequence = oldest;
+    }
+
+    unsigned count = 0;
+    for (uint32_t i = *sequence; (i != head) && (count < maxCount); i++) {
+        records[count++] = traceBuffer[i & (TRACE_BUFFER_SIZE - 1)];
+    }
+
+    return count;
+}
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Hot path trace facility. Timestamped enter/exit/event records are written into a RAM ring
+// which is drained over MSP (MSP2_GET_TRACE) and converted to a Chrome/Perfetto timeline on
+// the host by src/utils/trace_to_chrome.py
+
+#define TRACE_BUFFER_SIZE   512     // Number of records held, must be a power of 2
+
+typedef enum {
+    TRACE_TYPE_TASK_START = 0,
+    TRACE_TYPE_TASK_END,
+    TRACE_TYPE_EVENT,
+} traceType_e;
+
+typedef enum {
+    TRACE_EVENT_GYRO_EXTI = 0,
+    TRACE_EVENT_SPI_DMA_COMPLETE,   // arg is the SPI bus index
+    TRACE_EVENT_RX_FRAME,           // arg is the RX provider
+    TRACE_EVENT_COUNT
+} traceEvent_e;
+
+typedef struct traceRecord_s {
+    uint32_t cycles;                // cycle counter when the record was written
+    uint8_t type;                   // traceType_e
+    uint8_t id;                     // taskId_e or traceEvent_e
+    uint16_t arg;
+} traceRecord_t;
+
+#ifdef USE_TRACE
+void traceRecord(traceType_e type, uint8_t id, uint16_t arg);
+uint32_t traceGetHead(void);
+unsigned traceGetRecords(uint32_t *sequence, traceRecord_t *records, unsigned maxCount);
+
+#define TRACE_TASK_START(taskId)        traceRecord(TRACE_TYPE_TASK_START, (taskId), 0)
+#define TRACE_TASK_END(taskId)          traceRecord(TRACE_TYPE_TASK_END, (taskId), 0)
+#define TRACE_EVENT(event, arg)         traceRecord(TRACE_TYPE_EVENT, (event), (arg))
+#else
+#define TRACE_TASK_START(taskId)
+#define TRACE_TASK_END(taskId)
+#define TRACE_EVENT(event, arg)
+#endif
@@ -97,6 +97,7 @@ bool cliMode = false;
 #include "drivers/vtx_table.h"
 
 #include "fc/board_info.h"
+#include "fc/boot.h"
 #include "fc/controlrate_profile.h"
 #include "fc/core.h"
 #include "fc/rc.h"
@@ -133,6 +134,7 @@ bool cliMode = false;
 #include "pg/beeper.h"
 #include "pg/beeper_dev.h"
 #include "pg/board.h"
+#include "pg/boot.h"
 #include "pg/bus_i2c.h"
 #include "pg/bus_spi.h"
 #include "pg/gyrodev.h"
@@ -4839,12 +4841,109 @@ if (buildKey) {
     cliPrintLinefeed();
 }
 
-static void cliTasks(const char *cmdName, char *cmdline)
+#if defined(USE_TASK_HISTOGRAMS)
+static void cliPrintTaskHistogram(const char *name, const uint16_t *buckets)
+{
+    cliPrintf("  %-5s", name);
+    for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+        cliPrintf(" %5d", buckets[i]);
+    }
+    cliPrintLinef(" p50 %5d p99 %5d", taskHistogramPercentileUs(buckets, 50), taskHistogramPercentileUs(buckets, 99));
+}
+
+static void cliTaskHistograms(void)
+{
+    cliPrintf("Task histograms, buckets up to/us");
+    for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+        cliPrintf(" %d", 1 << i);
+    }
+    cliPrintLine("+");
+
+    for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+        taskInfo_t taskInfo;
+        getTaskInfo(taskId, &taskInfo);
+        if (taskInfo.isEnabled) {
+            taskHistogram_t histogram;
+            getTaskHistogram(taskId, &histogram);
+            cliPrintLinef("%02d - (%15s)", taskId, taskInfo.taskName);
+            cliPrintTaskHistogram("exec", histogram.execTime);
+            cliPrintTaskHistogram("start", histogram.startLatency);
+        }
+    }
+}
+#endif
+
+#if defined(USE_STACK_CHECK)
+static void cliTaskStacks(void)
+{
+    cliPrintLinef("Stack size: %d, used: %d", stackTotalSize(), stackUsedSize());
+    cliPrintLine("Task stack            peak/bytes");
+
+    for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+        taskInfo_t taskInfo;
+        getTaskInfo(taskId, &taskInfo);
+        if (taskInfo.isEnabled) {
+            if (taskInfo.stackPeakBytes) {
+                cliPrintLinef("%02d - (%15s) %10d", taskId, taskInfo.taskName, taskInfo.stackPeakBytes);
+            } else {
+                cliPrintLinef("%02d - (%15s) %10s", taskId, taskInfo.taskName, "-");
+            }
+        }
+    }
+}
+#endif
+
+#if defined(USE_BOOT_PROFILE)
+static void cliBoot(const char *cmdName, char *cmdline)
 {
     UNUSED(cmdName);
     UNUSED(cmdline);
+
+    cliPrintLinef("Boot timeline, fast boot %s", lookupTableOffOn[bootConfig()->fastBoot]);
+    cliPrintLine("     Phase     end/us  duration/us");
+
+    timeUs_t phaseStartUs = 0;
+    for (bootPhase_e phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        const timeUs_t phaseEndUs = bootProfileGetPhaseEndUs(phase);
+        if (phaseEndUs) {
+            cliPrintLinef("%10s %10u %12u", bootProfileGetPhaseName(phase), phaseEndUs, phaseEndUs - phaseStartUs);
+            phaseStartUs = phaseEndUs;
+        } else {
+            cliPrintLinef("%10s %10s", bootProfileGetPhaseName(phase), "-");
+        }
+    }
+}
+#endif
+
+static void cliTasks(const char *cmdName, char *cmdline)
+{
     int averageLoadSum = 0;
 
+#if defined(USE_STACK_CHECK)
+    if (strncasecmp(cmdline, "stack", 5) == 0) {
+        cliTaskStacks();
+        return;
+    }
+#endif
+#if defined(USE_TASK_HISTOGRAMS)
+    if (strncasecmp(cmdline, "hist", 4) == 0) {
+        cliTaskHistograms();
+        return;
+    } else if (strncasecmp(cmdline, "reset", 5) == 0) {
+        for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+            schedulerResetTaskHistogram(taskId);
+        }
+        cliPrintLine("Task histograms reset");
+        return;
+    } else if (!isEmpty(cmdline)) {
+        cliShowParseError(cmdName);
+        return;
+    }
+#else
+    UNUSED(cmdName);
+    UNUSED(cmdline);
+#endif
+
 #ifndef MINIMAL_CLI
     if (systemConfig()->task_statistics) {
 #if defined(USE_LATE_TASK_STATISTICS)
@@ -6475,6 +6574,9 @@ const clicmd_t cmdTable[] = {
 #if defined(USE_BOARD_INFO)
     CLI_COMMAND_DEF("board_name", "get / set the name of the board model", "[board name]", cliBoardName),
 #endif
+#if defined(USE_BOOT_PROFILE)
+    CLI_COMMAND_DEF("boot", "show boot timeline", NULL, cliBoot),
+#endif
 #ifdef USE_LED_STRIP_STATUS_MODE
         CLI_COMMAND_DEF("color", "configure colors", NULL, cliColor),
 #endif
@@ -6590,7 +6692,15 @@ const clicmd_t cmdTable[] = {
         "\treverse <servo> <source> r|n", cliServoMix),
 #endif
     CLI_COMMAND_DEF("status", "show status", NULL, cliStatus),
+#if defined(USE_TASK_HISTOGRAMS) && defined(USE_STACK_CHECK)
+    CLI_COMMAND_DEF("tasks", "show task stats", "<> | hist | reset | stack", cliTasks),
+#elif defined(USE_TASK_HISTOGRAMS)
+    CLI_COMMAND_DEF("tasks", "show task stats", "<> | hist | reset", cliTasks),
+#elif defined(USE_STACK_CHECK)
+    CLI_COMMAND_DEF("tasks", "show task stats", "<> | stack", cliTasks),
+#else
     CLI_COMMAND_DEF("tasks", "show task stats", NULL, cliTasks),
+#endif
 #ifdef USE_TIMER_MGMT
     CLI_COMMAND_DEF("timer", "show/set timers", "<> | <pin> list | <pin> [af<alternate function>|none|<option(deprecated)>] | list | show", cliTimer),
 #endif
@@ -29,9 +29,9 @@
  * Source below found here: http://www.kasperkamperman.com/blog/arduino/arduino-programming-hsb-to-rgb/
  */
 
-rgbColor24bpp_t* hsvToRgb24(const hsvColor_t* c)
+static void hsvToRgb24Convert(const hsvColor_t* c, rgbColor24bpp_t *result)
 {
-    static rgbColor24bpp_t r;
+    rgbColor24bpp_t r = *result;
 
     uint16_t val = c->v;
     uint16_t sat = 255 - c->s;
@@ -84,5 +84,29 @@ rgbColor24bpp_t* hsvToRgb24(const hsvColor_t* c)
 
         }
     }
-    return &r;
+    *result = r;
+}
+
+// LED strips only show a handful of distinct colors, so conversions are cached by color
+#define HSV_RGB_CACHE_SIZE 8
+#define HSV_RGB_CACHE_VALID (1U << 31)
+
+typedef struct hsvRgbCacheEntry_s {
+    uint32_t hsv;
+    rgbColor24bpp_t rgb;
+} hsvRgbCacheEntry_t;
+
+static hsvRgbCacheEntry_t hsvRgbCache[HSV_RGB_CACHE_SIZE];
+
+rgbColor24bpp_t* hsvToRgb24(const hsvColor_t* c)
+{
+    const uint32_t hsv = HSV_RGB_CACHE_VALID | (c->h << 16) | (c->s << 8) | c->v;
+    hsvRgbCacheEntry_t *entry = &hsvRgbCache[(hsv ^ (hsv >> 8) ^ (hsv >> 16)) % HSV_RGB_CACHE_SIZE];
+
+    if (entry->hsv != hsv) {
+        hsvToRgb24Convert(c, &entry->rgb);
+        entry->hsv = hsv;
+    }
+
+    return &entry->rgb;
 }
@@ -18,26 +18,100 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "common/crc.h"
 
 #include "platform.h"
 
+#include "drivers/crc_hw.h"
+
 #include "streambuf.h"
 
+/*
+ * The lookup tables below are generated by the preprocessor.
+ *
+ * A CRC is linear in its input, so the table entry for byte i is the xor of the entries for
+ * each bit set in i. The entry for a single bit is the register after that bit has been
+ * shifted out through the polynomial, so only the chain of shifts of the register's top bit
+ * is needed: <name>_<k>_<j> is the top bit shifted 8 * k + j + 1 times. Slice k of a table
+ * gives the CRC of a byte followed by k zero bytes, which is what slice-by-4 consumes.
+ */
+
+#define CRC8_SHIFT(c, poly)     ((((c) & 0x80) ? (((c) << 1) ^ (poly)) : ((c) << 1)) & 0xFF)
+#define CRC16_SHIFT(c, poly)    ((((c) & 0x8000) ? (((c) << 1) ^ (poly)) : ((c) << 1)) & 0xFFFF)
+
+#define CRC_SHIFT_BYTE(name, k, prev, SHIFT, poly) \
+    name##_##k##_0 = SHIFT(prev, poly), \
+    name##_##k##_1 = SHIFT(name##_##k##_0, poly), \
+    name##_##k##_2 = SHIFT(name##_##k##_1, poly), \
+    name##_##k##_3 = SHIFT(name##_##k##_2, poly), \
+    name##_##k##_4 = SHIFT(name##_##k##_3, poly), \
+    name##_##k##_5 = SHIFT(name##_##k##_4, poly), \
+    name##_##k##_6 = SHIFT(name##_##k##_5, poly), \
+    name##_##k##_7 = SHIFT(name##_##k##_6, poly)
+
+#define CRC_SHIFT_CHAIN(name, top, SHIFT, poly) \
+    CRC_SHIFT_BYTE(name, 0, top, SHIFT, poly), \
+    CRC_SHIFT_BYTE(name, 1, name##_0_7, SHIFT, poly), \
+    CRC_SHIFT_BYTE(name, 2, name##_1_7, SHIFT, poly), \
+    CRC_SHIFT_BYTE(name, 3, name##_2_7, SHIFT, poly)
+
+#define CRC_TABLE_ENTRY(i, name, k) ( \
+      (((i) & 0x01) ? name##_##k##_0 : 0) ^ (((i) & 0x02) ? name##_##k##_1 : 0) \
+    ^ (((i) & 0x04) ? name##_##k##_2 : 0) ^ (((i) & 0x08) ? name##_##k##_3 : 0) \
+    ^ (((i) & 0x10) ? name##_##k##_4 : 0) ^ (((i) & 0x20) ? name##_##k##_5 : 0) \
+    ^ (((i) & 0x40) ? name##_##k##_6 : 0) ^ (((i) & 0x80) ? name##_##k##_7 : 0))
+
+#define CRC_TABLE_ROW(r, name, k) \
+    CRC_TABLE_ENTRY((r) + 0x0, name, k), CRC_TABLE_ENTRY((r) + 0x1, name, k), \
+    CRC_TABLE_ENTRY((r) + 0x2, name, k), CRC_TABLE_ENTRY((r) + 0x3, name, k), \
+    CRC_TABLE_ENTRY((r) + 0x4, name, k), CRC_TABLE_ENTRY((r) + 0x5, name, k), \
+    CRC_TABLE_ENTRY((r) + 0x6, name, k), CRC_TABLE_ENTRY((r) + 0x7, name, k), \
+    CRC_TABLE_ENTRY((r) + 0x8, name, k), CRC_TABLE_ENTRY((r) + 0x9, name, k), \
+    CRC_TABLE_ENTRY((r) + 0xA, name, k), CRC_TABLE_ENTRY((r) + 0xB, name, k), \
+    CRC_TABLE_ENTRY((r) + 0xC, name, k), CRC_TABLE_ENTRY((r) + 0xD, name, k), \
+    CRC_TABLE_ENTRY((r) + 0xE, name, k), CRC_TABLE_ENTRY((r) + 0xF, name, k)
+
+#define CRC_TABLE(name, k) { \
+    CRC_TABLE_ROW(0x00, name, k), CRC_TABLE_ROW(0x10, name, k), \
+    CRC_TABLE_ROW(0x20, name, k), CRC_TABLE_ROW(0x30, name, k), \
+    CRC_TABLE_ROW(0x40, name, k), CRC_TABLE_ROW(0x50, name, k), \
+    CRC_TABLE_ROW(0x60, name, k), CRC_TABLE_ROW(0x70, name, k), \
+    CRC_TABLE_ROW(0x80, name, k), CRC_TABLE_ROW(0x90, name, k), \
+    CRC_TABLE_ROW(0xA0, name, k), CRC_TABLE_ROW(0xB0, name, k), \
+    CRC_TABLE_ROW(0xC0, name, k), CRC_TABLE_ROW(0xD0, name, k), \
+    CRC_TABLE_ROW(0xE0, name, k), CRC_TABLE_ROW(0xF0, name, k) }
+
+#define CRC16_CCITT_POLY    0x1021
+#define CRC8_DVB_S2_POLY    0xD5
+#define CRC8_0xBA_POLY      0xBA
+
+enum {
+    CRC_SHIFT_CHAIN(CRC16_CCITT, 0x8000, CRC16_SHIFT, CRC16_CCITT_POLY),
+    CRC_SHIFT_CHAIN(CRC8_DVB_S2, 0x80, CRC8_SHIFT, CRC8_DVB_S2_POLY),
+    CRC_SHIFT_CHAIN(CRC8_0xBA, 0x80, CRC8_SHIFT, CRC8_0xBA_POLY),
+};
+
+#ifdef USE_CRC_SLICE_BY_4
+#define CRC_SLICES 4
+static const uint16_t crc16CcittTable[CRC_SLICES][256] = {
+    CRC_TABLE(CRC16_CCITT, 0), CRC_TABLE(CRC16_CCITT, 1), CRC_TABLE(CRC16_CCITT, 2), CRC_TABLE(CRC16_CCITT, 3)
+};
+static const uint8_t crc8DvbS2Table[CRC_SLICES][256] = {
+    CRC_TABLE(CRC8_DVB_S2, 0), CRC_TABLE(CRC8_DVB_S2, 1), CRC_TABLE(CRC8_DVB_S2, 2), CRC_TABLE(CRC8_DVB_S2, 3)
+};
+#else
+#define CRC_SLICES 1
+static const uint16_t crc16CcittTable[CRC_SLICES][256] = { CRC_TABLE(CRC16_CCITT, 0) };
+static const uint8_t crc8DvbS2Table[CRC_SLICES][256] = { CRC_TABLE(CRC8_DVB_S2, 0) };
+#endif
+static const uint8_t crc8PolyBATable[256] = CRC_TABLE(CRC8_0xBA, 0);
 
 uint16_t crc16_ccitt(uint16_t crc, unsigned char a)
 {
-    crc ^= (uint16_t)a << 8;
-    for (int ii = 0; ii < 8; ++ii) {
-        if (crc & 0x8000) {
-            crc = (crc << 1) ^ 0x1021;
-        } else {
-            crc = crc << 1;
-        }
-    }
-    return crc;
+    return (crc << 8) ^ crc16CcittTable[0][(crc >> 8) ^ a];
 }
 
 uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
@@ -45,6 +119,18 @@ uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
     const uint8_t *p = (const uint8_t *)data;
     const uint8_t *pend = p + length;
 
+#ifdef USE_CRC_HW
+    if (length >= CRC_HW_MIN_LENGTH && crcHwUpdate16(&crc, CRC16_CCITT_POLY, p, length)) {
+        return crc;
+    }
+#endif
+
+#ifdef USE_CRC_SLICE_BY_4
+    for (; pend - p >= 4; p += 4) {
+        crc ^= (p[0] << 8) | p[1];
+        crc = crc16CcittTable[3][crc >> 8] ^ crc16CcittTable[2][crc & 0xFF] ^ crc16CcittTable[1][p[2]] ^ crc16CcittTable[0][p[3]];
+    }
+#endif
     for (; p != pend; p++) {
         crc = crc16_ccitt(crc, *p);
     }
@@ -53,15 +139,12 @@ uint16_t crc16_ccitt_update(uint16_t crc, const void *data, uint32_t length)
 
 void crc16_ccitt_sbuf_append(sbuf_t *dst, uint8_t *start)
 {
-    uint16_t crc = 0;
     const uint8_t * const end = sbufPtr(dst);
-    for (const uint8_t *ptr = start; ptr < end; ++ptr) {
-        crc = crc16_ccitt(crc, *ptr);
-    }
-    sbufWriteU16(dst, crc);
+    sbufWriteU16(dst, crc16_ccitt_update(0, start, end - start));
 }
 
-uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
+// Reference implementation, used for polynomials without a table
+static uint8_t crc8_calc_bitwise(uint8_t crc, unsigned char a, uint8_t poly)
 {
     crc ^= a;
     for (int ii = 0; ii < 8; ++ii) {
@@ -74,11 +157,27 @@ uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
     return crc;
 }
 
+uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly)
+{
+    switch (poly) {
+    case CRC8_DVB_S2_POLY:
+        return crc8_dvb_s2(crc, a);
+    case CRC8_0xBA_POLY:
+        return crc8_poly_0xba(crc, a);
+    default:
+        return crc8_calc_bitwise(crc, a, poly);
+    }
+}
+
 uint8_t crc8_update(uint8_t crc, const void *data, uint32_t length, uint8_t poly)
 {
     const uint8_t *p = (const uint8_t *)data;
     const uint8_t *pend = p + length;
 
+    if (poly == CRC8_DVB_S2_POLY) {
+        return crc8_dvb_s2_update(crc, data, length);
+    }
+
     for (; p != pend; p++) {
         crc = crc8_calc(crc, *p, poly);
     }
@@ -87,12 +186,52 @@ uint8_t crc8_update(uint8_t crc, const void *data, uint32_t length, uint8_t poly
 
 void crc8_sbuf_append(sbuf_t *dst, uint8_t *start, uint8_t poly)
 {
-    uint8_t crc = 0;
     const uint8_t * const end = dst->ptr;
-    for (const uint8_t *ptr = start; ptr < end; ++ptr) {
-        crc = crc8_calc(crc, *ptr, poly);
+    sbufWriteU8(dst, crc8_update(0, start, end - start, poly));
+}
+
+uint8_t crc8_dvb_s2(uint8_t crc, unsigned char a)
+{
+    return crc8DvbS2Table[0][crc ^ a];
+}
+
+uint8_t crc8_dvb_s2_update(uint8_t crc, const void *data, uint32_t length)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    const uint8_t *pend = p + length;
+
+#ifdef USE_CRC_HW
+    if (length >= CRC_HW_MIN_LENGTH && crcHwUpdate8(&crc, CRC8_DVB_S2_POLY, p, length)) {
+        return crc;
     }
-    sbufWriteU8(dst, crc);
+#endif
+
+#ifdef USE_CRC_SLICE_BY_4
+    for (; pend - p >= 4; p += 4) {
+        crc = crc8DvbS2Table[3][crc ^ p[0]] ^ crc8DvbS2Table[2][p[1]] ^ crc8DvbS2Table[1][p[2]] ^ crc8DvbS2Table[0][p[3]];
+    }
+#endif
+    for (; p != pend; p++) {
+        crc = crc8DvbS2Table[0][crc ^ *p];
+    }
+    return crc;
+}
+
+void crc8_dvb_s2_sbuf_append(sbuf_t *dst, uint8_t *start)
+{
+    const uint8_t * const end = dst->ptr;
+    sbufWriteU8(dst, crc8_dvb_s2_update(0, start, end - start));
+}
+
+uint8_t crc8_poly_0xba(uint8_t crc, unsigned char a)
+{
+    return crc8PolyBATable[crc ^ a];
+}
+
+void crc8_poly_0xba_sbuf_append(sbuf_t *dst, uint8_t *start)
+{
+    const uint8_t * const end = dst->ptr;
+    sbufWriteU8(dst, crc8_update(0, start, end - start, CRC8_0xBA_POLY));
 }
 
 uint8_t crc8_xor_update(uint8_t crc, const void *data, uint32_t length)
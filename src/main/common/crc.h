@@ -30,11 +30,13 @@ void crc16_ccitt_sbuf_append(struct sbuf_s *dst, uint8_t *start);
 uint8_t crc8_calc(uint8_t crc, unsigned char a, uint8_t poly);
 uint8_t crc8_update(uint8_t crc, const void *data, uint32_t length, uint8_t poly);
 void crc8_sbuf_append(struct sbuf_s *dst, uint8_t *start, uint8_t poly);
-#define crc8_dvb_s2(crc, a)                         crc8_calc(crc, a, 0xD5)
-#define crc8_dvb_s2_update(crc, data, length)       crc8_update(crc, data, length, 0xD5)
-#define crc8_dvb_s2_sbuf_append(dst, start)         crc8_sbuf_append(dst, start, 0xD5)
-#define crc8_poly_0xba(crc, a)                      crc8_calc(crc, a, 0xBA)
-#define crc8_poly_0xba_sbuf_append(dst, start)      crc8_sbuf_append(dst, start, 0xBA)
+
+// Table driven, with slice-by-4 and hardware variants for buffers where available
+uint8_t crc8_dvb_s2(uint8_t crc, unsigned char a);
+uint8_t crc8_dvb_s2_update(uint8_t crc, const void *data, uint32_t length);
+void crc8_dvb_s2_sbuf_append(struct sbuf_s *dst, uint8_t *start);
+uint8_t crc8_poly_0xba(uint8_t crc, unsigned char a);
+void crc8_poly_0xba_sbuf_append(struct sbuf_s *dst, uint8_t *start);
 
 uint8_t crc8_xor_update(uint8_t crc, const void *data, uint32_t length);
 void crc8_xor_sbuf_append(struct sbuf_s *dst, uint8_t *start);
@@ -101,3 +101,66 @@ float pow_approx(float a, float b)
 {
     return exp_approx(b * log_approx(a));
 }
+
+/* The fast and precise tiers reduce exactly, exp(x) = 2^k * 2^t and log(x) = k * log(2) + log(1 + t)
+   with 0 <= t < 1, and differ only in the order of the minimax polynomial used for 2^t and log(1 + t) */
+
+static inline float exp2Scale(float val, float *t)
+{
+  union { int32_t i; float f; } scale;
+  const float val2 = fminf(fmaxf(val * 1.44269504089f, -126.0f), 127.0f);  /* val / log(2) */
+  const int32_t k = (int32_t)val2 - (val2 < 0.0f);                            /* floor */
+  *t = val2 - k;
+  scale.i = (k + 127) << 23;
+  return scale.f;
+}
+
+float exp_approx_fast(float val)
+{
+  float t;
+  const float scale = exp2Scale(val, &t);
+  return scale * (1.0017247203f + t * (6.5763670333e-1f + t * 3.3718897246e-1f));
+}
+
+float exp_approx_precise(float val)
+{
+  float t;
+  const float scale = exp2Scale(val, &t);
+  return scale * (1.0000000019f + t * (6.9314698383e-1f + t * (2.4022983649e-1f + t * (5.5483340989e-2f
+    + t * (9.6788430272e-3f + t * (1.2439669136e-3f + t * 2.1702319219e-4f))))));
+}
+
+static inline float log2Split(float val, float *t)
+{
+  union { float f; int32_t i; } valu;
+  valu.f = val;
+  const int32_t k = ((valu.i >> 23) & 0xFF) - 127;
+  valu.i = (valu.i & 0x7FFFFF) | 0x3F800000;
+  *t = valu.f - 1.0f;
+  return val > 0 ? 0.69314718056f * k : -(float)INFINITY;
+}
+
+float log_approx_fast(float val)
+{
+  float t;
+  const float base = log2Split(val, &t);
+  return base + t * (9.8745262484e-1f + t * (-4.0840501504e-1f + t * 1.1463389765e-1f));
+}
+
+float log_approx_precise(float val)
+{
+  float t;
+  const float base = log2Split(val, &t);
+  return base + t * (9.9999640796e-1f + t * (-4.9987365213e-1f + t * (3.3179489599e-1f + t * (-2.4071711185e-1f
+    + t * (1.6761816335e-1f + t * (-9.5286942595e-2f + t * (3.6062445534e-2f + t * -6.4470576209e-3f)))))));
+}
+
+float pow_approx_fast(float a, float b)
+{
+    return exp_approx_fast(b * log_approx_fast(a));
+}
+
+float pow_approx_precise(float a, float b)
+{
+    return exp_approx_precise(b * log_approx_precise(a));
+}
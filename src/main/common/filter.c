@@ -312,6 +312,40 @@ FAST_CODE float slewFilterApply(slewFilter_t *filter, float input)
 }
 
 
+// Frame predictor
+// The change between the last two frames, scaled by gain, is spread over the PID loops expected
+// before the next frame. A gain of 1 removes the average half frame lag of a held value on a ramp
+// at the cost of overshooting by up to one frame step when the input stops.
+
+void framePredictorInit(framePredictor_t *filter, float gain)
+{
+    filter->input = 0.0f;
+    filter->output = 0.0f;
+    filter->increment = 0.0f;
+    filter->gain = gain;
+    filter->loopsRemaining = 0;
+}
+
+// loopsPerFrame of zero holds the input until the next frame, use when the frame interval is not valid
+FAST_CODE void framePredictorNewFrame(framePredictor_t *filter, float input, uint16_t loopsPerFrame)
+{
+    const float step = input - filter->input;
+    filter->input = input;
+    filter->output = input;
+    filter->increment = loopsPerFrame ? filter->gain * step / loopsPerFrame : 0.0f;
+    filter->loopsRemaining = loopsPerFrame;
+}
+
+FAST_CODE float framePredictorApply(framePredictor_t *filter)
+{
+    if (filter->loopsRemaining) {
+        filter->loopsRemaining--;
+        filter->output += filter->increment;
+    }
+    return filter->output;
+}
+
+
 // Moving average
 
 void laggedMovingAverageInit(laggedMovingAverage_t *filter, uint16_t windowSize, float *buf)
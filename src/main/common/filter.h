@@ -76,6 +76,15 @@ typedef struct slewFilter_s {
     float threshold;
 } slewFilter_t;
 
+// Predicts a value sampled at a low rate between samples by continuing the last change
+typedef struct framePredictor_s {
+    float input;
+    float output;
+    float increment;
+    float gain;
+    uint16_t loopsRemaining;
+} framePredictor_t;
+
 typedef struct laggedMovingAverage_s {
     uint16_t movingWindowIndex;
     uint16_t windowSize;
@@ -129,6 +138,10 @@ float phaseCompApply(phaseComp_t *filter, const float input);
 void slewFilterInit(slewFilter_t *filter, float slewLimit, float threshold);
 float slewFilterApply(slewFilter_t *filter, float input);
 
+void framePredictorInit(framePredictor_t *filter, float gain);
+void framePredictorNewFrame(framePredictor_t *filter, float input, uint16_t loopsPerFrame);
+float framePredictorApply(framePredictor_t *filter);
+
 void laggedMovingAverageInit(laggedMovingAverage_t *filter, uint16_t windowSize, float *buf);
 float laggedMovingAverageUpdate(laggedMovingAverage_t *filter, float input);
 
@@ -18,6 +18,7 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <math.h>
@@ -48,23 +49,82 @@
 #define sinPolyCoef7 -1.980661520e-4f                                          // Double: -1.980661520135080504411629636078917643846e-4
 #define sinPolyCoef9  2.600054768e-6f                                          // Double:  2.600054767890361277123254766503271638682e-6
 #endif
-float sin_approx(float x)
+
+// Wraps the input angle to -PI..PI, without data dependent loops
+static inline float sinWrap(float x)
+{
+    return x - (2.0f * M_PIf) * (int32_t)(x * (0.5f / M_PIf) + (x >= 0.0f ? 0.5f : -0.5f));
+}
+
+// Picks the -90..+90 Degree angle with the same sine as an angle in -PI..PI
+static inline float sinFold(float x)
 {
-    int32_t xint = x;
-    if (xint < -32 || xint > 32) return 0.0f;                               // Stop here on error input (5 * 360 Deg)
-    while (x >  M_PIf) x -= (2.0f * M_PIf);                                 // always wrap input angle to -PI..PI
-    while (x < -M_PIf) x += (2.0f * M_PIf);
-    if (x >  (0.5f * M_PIf)) x =  (0.5f * M_PIf) - (x - (0.5f * M_PIf));   // We just pick -90..+90 Degree
-    else if (x < -(0.5f * M_PIf)) x = -(0.5f * M_PIf) - ((0.5f * M_PIf) + x);
-    float x2 = x * x;
+    if (x > (0.5f * M_PIf)) {
+        x = M_PIf - x;
+    } else if (x < -(0.5f * M_PIf)) {
+        x = -M_PIf - x;
+    }
+    return x;
+}
+
+// Wraps the input angle to -PI..PI and then picks -90..+90 Degree
+static inline float sinReduce(float x)
+{
+    return sinFold(sinWrap(x));
+}
+
+static inline bool sinInputInvalid(float x)
+{
+    const int32_t xint = x;
+    return xint < -32 || xint > 32;                                         // error input (5 * 360 Deg)
+}
+
+// Input in -90..+90 Degree
+static inline float sinPoly(float x)
+{
+    const float x2 = x * x;
     return x + x * x2 * (sinPolyCoef3 + x2 * (sinPolyCoef5 + x2 * (sinPolyCoef7 + x2 * sinPolyCoef9)));
 }
 
+float sin_approx(float x)
+{
+    if (sinInputInvalid(x)) return 0.0f;
+    return sinPoly(sinReduce(x));
+}
+
 float cos_approx(float x)
 {
     return sin_approx(x + (0.5f * M_PIf));
 }
 
+// Minimax odd polynomial of order 5
+float sin_approx_fast(float x)
+{
+    if (sinInputInvalid(x)) return 0.0f;
+    x = sinReduce(x);
+    const float x2 = x * x;
+    return x * (9.996967862e-1f + x2 * (-1.656730973e-1f + x2 * 7.514382539e-3f));
+}
+
+float cos_approx_fast(float x)
+{
+    return sin_approx_fast(x + (0.5f * M_PIf));
+}
+
+// Minimax odd polynomial of order 9
+float sin_approx_precise(float x)
+{
+    if (sinInputInvalid(x)) return 0.0f;
+    x = sinReduce(x);
+    const float x2 = x * x;
+    return x * (9.999999766e-1f + x2 * (-1.666664764e-1f + x2 * (8.332899881e-3f + x2 * (-1.980090075e-4f + x2 * 2.590493746e-6f))));
+}
+
+float cos_approx_precise(float x)
+{
+    return sin_approx_precise(x + (0.5f * M_PIf));
+}
+
 // Initial implementation by Crashpilot1000 (https://github.com/Crashpilot1000/HarakiriWebstore1/blob/396715f73c6fcf859e0db0f34e12fe44bace6483/src/mw.c#L1292)
 // Polynomial coefficients by Andor (http://www.dsprelated.com/showthread/comp.dsp/21872-1.php) optimized by Ledvinap to save one multiplication
 // Max absolute error 0,000027 degree
@@ -92,6 +152,44 @@ float atan2_approx(float y, float x)
     return res;
 }
 
+// atan2 is reduced to the atan of a ratio in 0..1 and the octant unfolded afterwards
+static inline float atan2Ratio(float absY, float absX)
+{
+    const float maxXY = MAX(absX, absY);
+    return maxXY ? MIN(absX, absY) / maxXY : 0.0f;
+}
+
+static inline float atan2Unfold(float res, float y, float x, float absY, float absX)
+{
+    if (absY > absX) res = (M_PIf / 2.0f) - res;
+    if (x < 0) res = M_PIf - res;
+    if (y < 0) res = -res;
+    return res;
+}
+
+// Minimax odd polynomial of order 5 for atan
+float atan2_approx_fast(float y, float x)
+{
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    const float r = atan2Ratio(absY, absX);
+    const float r2 = r * r;
+    const float res = r * (9.953579607e-1f + r2 * (-2.886901573e-1f + r2 * 7.933893911e-2f));
+    return atan2Unfold(res, y, x, absY, absX);
+}
+
+// Minimax odd polynomial of order 15 for atan, no division other than the ratio
+float atan2_approx_precise(float y, float x)
+{
+    const float absX = fabsf(x);
+    const float absY = fabsf(y);
+    const float r = atan2Ratio(absY, absX);
+    const float r2 = r * r;
+    const float res = r * (9.999993358e-1f + r2 * (-3.332986145e-1f + r2 * (1.994657215e-1f + r2 * (-1.390865816e-1f
+        + r2 * (9.642262918e-2f + r2 * (-5.591314012e-2f + r2 * (2.186347547e-2f + r2 * -4.054699765e-3f)))))));
+    return atan2Unfold(res, y, x, absY, absX);
+}
+
 // http://http.developer.nvidia.com/Cg/acos.html
 // Handbook of Mathematical Functions
 // M. Abramowitz and I.A. Stegun, Ed.
@@ -105,6 +203,69 @@ float acos_approx(float x)
     else
         return result;
 }
+
+// sqrt(1 - x) times a minimax polynomial of order 1
+float acos_approx_fast(float x)
+{
+    const float xa = fabsf(x);
+    const float result = sqrtf(1.0f - xa) * (1.567589199f - 0.1682573451f * xa);
+    return (x < 0.0f) ? M_PIf - result : result;
+}
+
+// sqrt(1 - x) times a minimax polynomial of order 7
+float acos_approx_precise(float x)
+{
+    const float xa = fabsf(x);
+    const float result = sqrtf(1.0f - xa) * (1.570796314f + xa * (-2.145998910e-1f + xa * (8.899923822e-2f + xa * (-5.031260514e-2f
+        + xa * (3.133490283e-2f + xa * (-1.780807123e-2f + xa * (7.244725564e-3f + xa * -1.441256780e-3f)))))));
+    return (x < 0.0f) ? M_PIf - result : result;
+}
+
+// Batched forms evaluate independent angles together so the polynomial evaluations can be interleaved.
+// Each angle is wrapped once for both results: with x in -PI..PI, cos(x) = sin(PI/2 - |x|), which needs
+// no further folding.
+static inline void sinCosApprox(float x, float *sinX, float *cosX)
+{
+    if (sinInputInvalid(x)) {
+        *sinX = 0.0f;
+        *cosX = 0.0f;
+        return;
+    }
+
+    x = sinWrap(x);
+    *sinX = sinPoly(sinFold(x));
+    *cosX = sinPoly((0.5f * M_PIf) - fabsf(x));
+}
+
+void sin_cos_approx3(const float x[3], float sinX[3], float cosX[3])
+{
+    for (int i = 0; i < 3; i++) {
+        sinCosApprox(x[i], &sinX[i], &cosX[i]);
+    }
+}
+
+void sin_cos_approx4(const float x[4], float sinX[4], float cosX[4])
+{
+    for (int i = 0; i < 4; i++) {
+        sinCosApprox(x[i], &sinX[i], &cosX[i]);
+    }
+}
+#else
+void sin_cos_approx3(const float x[3], float sinX[3], float cosX[3])
+{
+    for (int i = 0; i < 3; i++) {
+        sinX[i] = sinf(x[i]);
+        cosX[i] = cosf(x[i]);
+    }
+}
+
+void sin_cos_approx4(const float x[4], float sinX[4], float cosX[4])
+{
+    for (int i = 0; i < 4; i++) {
+        sinX[i] = sinf(x[i]);
+        cosX[i] = cosf(x[i]);
+    }
+}
 #endif
 
 int gcd(int num, int denom)
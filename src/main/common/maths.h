@@ -130,6 +130,15 @@ float quickMedianFilter5f(float * v);
 float quickMedianFilter7f(float * v);
 float quickMedianFilter9f(float * v);
 
+// Each approximation comes in three precision tiers, callers should pick the cheapest that meets their need.
+// Maximum errors, verified by maths_unittest over every 256th float of the domain:
+//
+//                  domain          _fast       (standard)  _precise
+//  sin, cos        -PI..PI         7.0e-05     1.0e-06     2.0e-07     absolute
+//  atan2           any             6.2e-04     7.5e-07     5.0e-07     absolute, radians
+//  acos            -1..1           3.3e-03     7.0e-05     3.5e-07     absolute, radians
+//  exp             -10..10         1.8e-03     1.0e-05     6.5e-07     relative
+//  log             1e-3..1e3       5.5e-04     1.4e-05     5.0e-07     absolute
 #if defined(FAST_MATH) || defined(VERY_FAST_MATH)
 float sin_approx(float x);
 float cos_approx(float x);
@@ -139,6 +148,22 @@ float acos_approx(float x);
 float exp_approx(float val);
 float log_approx(float val);
 float pow_approx(float a, float b);
+
+float sin_approx_fast(float x);
+float cos_approx_fast(float x);
+float atan2_approx_fast(float y, float x);
+float acos_approx_fast(float x);
+float exp_approx_fast(float val);
+float log_approx_fast(float val);
+float pow_approx_fast(float a, float b);
+
+float sin_approx_precise(float x);
+float cos_approx_precise(float x);
+float atan2_approx_precise(float y, float x);
+float acos_approx_precise(float x);
+float exp_approx_precise(float val);
+float log_approx_precise(float val);
+float pow_approx_precise(float a, float b);
 #else
 #define sin_approx(x)       sinf(x)
 #define cos_approx(x)       cosf(x)
@@ -147,9 +172,29 @@ float pow_approx(float a, float b);
 #define tan_approx(x)       tanf(x)
 #define exp_approx(x)       expf(x)
 #define log_approx(x)       logf(x)
-#define pow_approx(a, b)    powf(b, a)
+#define pow_approx(a, b)    powf(a, b)
+
+#define sin_approx_fast(x)          sinf(x)
+#define cos_approx_fast(x)          cosf(x)
+#define atan2_approx_fast(y,x)      atan2f(y,x)
+#define acos_approx_fast(x)         acosf(x)
+#define exp_approx_fast(x)          expf(x)
+#define log_approx_fast(x)          logf(x)
+#define pow_approx_fast(a, b)       powf(a, b)
+
+#define sin_approx_precise(x)       sinf(x)
+#define cos_approx_precise(x)       cosf(x)
+#define atan2_approx_precise(y,x)   atan2f(y,x)
+#define acos_approx_precise(x)      acosf(x)
+#define exp_approx_precise(x)       expf(x)
+#define log_approx_precise(x)       logf(x)
+#define pow_approx_precise(a, b)    powf(a, b)
 #endif
 
+// Batched sin and cos of 3 and 4 angles at standard precision
+void sin_cos_approx3(const float x[3], float sinX[3], float cosX[3]);
+void sin_cos_approx4(const float x[4], float sinX[4], float cosX[4]);
+
 void arraySubInt32(int32_t *dest, int32_t *array1, int32_t *array2, int count);
 
 int16_t qPercent(fix12_t q);
@@ -419,14 +419,49 @@ static const configRecord_t *findEEPROM(const pgRegistry_t *reg, configRecordFla
 }
 
 // Initialize all PG records from EEPROM.
-// This functions processes all PGs sequentially, scanning EEPROM for each one. This is suboptimal,
-//   but each PG is loaded/initialized exactly once and in defined order.
+// EEPROM is scanned once to map each record to its PG, then all PGs are processed sequentially,
+//   so each PG is loaded/initialized exactly once and in defined order.
+// This function assumes that EEPROM content is valid.
 bool loadEEPROM(void)
 {
+    // record offsets from the start of the config area by registry position, 0 when there is no record
+    uint16_t recordOffset[PG_REGISTRY_INDEX_SIZE];
+    const bool indexed = PG_REGISTRY_SIZE <= PG_REGISTRY_INDEX_SIZE;
+
+    if (indexed) {
+        memset(recordOffset, 0, sizeof(recordOffset));
+
+        const uint8_t *p = &__config_start;
+        p += sizeof(configHeader_t);             // skip header
+        while (true) {
+            const configRecord_t *record = (const configRecord_t *)p;
+            if (record->size == 0
+                || p + record->size >= &__config_end
+                || record->size < sizeof(*record))
+                break;
+            if ((record->flags & CR_CLASSIFICATION_MASK) == CR_CLASSICATION_SYSTEM) {
+                const int index = pgRegistryIndex(record->pgn);
+                // the first record for a PG wins
+                if (index >= 0 && recordOffset[index] == 0) {
+                    recordOffset[index] = p - &__config_start;
+                }
+            }
+            p += record->size;
+        }
+    }
+
     bool success = true;
 
     PG_FOREACH(reg) {
-        const configRecord_t *rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+        const configRecord_t *rec = NULL;
+        if (indexed) {
+            const uint16_t offset = recordOffset[reg - __pg_registry_start];
+            if (offset) {
+                rec = (const configRecord_t *)(&__config_start + offset);
+            }
+        } else {
+            rec = findEEPROM(reg, CR_CLASSICATION_SYSTEM);
+        }
         if (rec) {
             // config from EEPROM is available, use it to initialize PG. pgLoad will handle version mismatch
             if (!pgLoad(reg, rec->pg, rec->size - offsetof(configRecord_t, pg), rec->version)) {
@@ -106,6 +106,7 @@ typedef struct gyroDev_s {
     int16_t gyroADCRaw[XYZ_AXIS_COUNT];                      // raw data from sensor
     int16_t temperature;
     mpuDetectionResult_t mpuDetectionResult;
+    uint8_t spiDetectHint;                                   // SPI detection table entry + 1 to try first, set to the entry which found the gyro
     sensor_align_e gyroAlign;
     gyroRateKHz_e gyroRateKHz;
     gyroModeSPI_e gyroModeSPI;
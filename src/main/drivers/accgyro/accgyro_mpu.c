@@ -28,6 +28,7 @@
 #include "build/atomic.h"
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/trace.h"
 
 #include "common/maths.h"
 #include "common/utils.h"
@@ -140,6 +141,8 @@ static void mpuIntExtiHandler(extiCallbackRec_t *cb)
     // not have an associated timer
     uint32_t nowCycles = getCycleCounter();
     int32_t gyroLastPeriod = cmpTimeCycles(nowCycles, gyro->gyroLastEXTI);
+
+    TRACE_EVENT(TRACE_EVENT_GYRO_EXTI, 0);
     // This detects the short (~79us) EXTI interval of an MPU6xxx gyro
     if ((gyro->gyroShortPeriod == 0) || (gyroLastPeriod < gyro->gyroShortPeriod)) {
         gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
@@ -379,6 +382,7 @@ static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyro
     }
 
     gyro->dev.busType_u.spi.csnPin = IOGetByTag(config->csnTag);
+    gyro->dev.priority = BUS_PRIORITY_REALTIME;
 
     IOInit(gyro->dev.busType_u.spi.csnPin, OWNER_GYRO_CS, RESOURCE_INDEX(config->index));
     IOConfigGPIO(gyro->dev.busType_u.spi.csnPin, SPI_IO_CS_CFG);
@@ -395,17 +399,25 @@ static bool detectSPISensorsAndUpdateDetectionResult(gyroDev_t *gyro, const gyro
 
     // It is hard to use hardware to optimize the detection loop here,
     // as hardware type and detection function name doesn't match.
-    // May need a bitmap of hardware to detection function to do it right?
+    // Instead start with the detection function which found the gyro last time, when known,
+    // and carry on through the rest of the table from there.
+
+    const size_t detectFnCount = ARRAYLEN(gyroSpiDetectFnTable) - 1;
+    const size_t firstIndex = (gyro->spiDetectHint && gyro->spiDetectHint <= detectFnCount) ? gyro->spiDetectHint - 1 : 0;
 
-    for (size_t index = 0 ; gyroSpiDetectFnTable[index] ; index++) {
+    for (size_t i = 0; i < detectFnCount; i++) {
+        const size_t index = (firstIndex + i) % detectFnCount;
         sensor = (gyroSpiDetectFnTable[index])(&gyro->dev);
         if (sensor != MPU_NONE) {
             gyro->mpuDetectionResult.sensor = sensor;
+            gyro->spiDetectHint = index + 1;
             busDeviceRegister(&gyro->dev);
             return true;
         }
     }
 
+    gyro->spiDetectHint = 0;
+
     // Detection failed, disable CS pin again
 
     spiPreinitByTag(config->csnTag);
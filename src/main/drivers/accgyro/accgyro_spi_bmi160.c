@@ -41,6 +41,8 @@
 
 #ifdef USE_ACCGYRO_BMI160
 
+#include "build/trace.h"
+
 #include "drivers/accgyro/accgyro.h"
 #include "drivers/accgyro/accgyro_spi_bmi160.h"
 #include "drivers/bus_spi.h"
@@ -292,6 +294,8 @@ void bmi160ExtiHandler(extiCallbackRec_t *cb)
     gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
     gyro->gyroLastEXTI = nowCycles;
 
+    TRACE_EVENT(TRACE_EVENT_GYRO_EXTI, 0);
+
     if (gyro->gyroModeSPI == GYRO_EXTI_INT_DMA) {
         spiSequence(dev, gyro->segments);
     }
@@ -27,6 +27,8 @@
 
 #ifdef USE_ACCGYRO_BMI270
 
+#include "build/trace.h"
+
 #include "drivers/accgyro/accgyro.h"
 #include "drivers/accgyro/accgyro_spi_bmi270.h"
 #include "drivers/bus_spi.h"
@@ -303,6 +305,8 @@ void bmi270ExtiHandler(extiCallbackRec_t *cb)
     gyro->gyroSyncEXTI = gyro->gyroLastEXTI + gyro->gyroDmaMaxDuration;
     gyro->gyroLastEXTI = nowCycles;
 
+    TRACE_EVENT(TRACE_EVENT_GYRO_EXTI, 0);
+
     if (gyro->gyroModeSPI == GYRO_EXTI_INT_DMA) {
         spiSequence(dev, gyro->segments);
     }
@@ -303,8 +303,10 @@ void uartIrqHandler(uartPort_t *s)
         if (s->port.rxCallback) {
             s->port.rxCallback(s->USARTx->dt, s->port.rxCallbackData);
         } else {
-            s->port.rxBuffer[s->port.rxBufferHead] = s->USARTx->dt;
+            const uint8_t ch = s->USARTx->dt;
+            s->port.rxBuffer[s->port.rxBufferHead] = ch;
             s->port.rxBufferHead = (s->port.rxBufferHead + 1) % s->port.rxBufferSize;
+            serialRxEventCheck(&s->port, ch);
         }
     }
 
@@ -333,6 +335,7 @@ void uartIrqHandler(uartPort_t *s)
         if (s->port.idleCallback) {
             s->port.idleCallback();
         }
+        serialRxEventSignal(&s->port);
 
         (void) s->USARTx->sts;
         (void) s->USARTx->dt;
@@ -464,6 +464,43 @@ static void usbVcpEndWrite(serialPort_t *instance)
     usbVcpFlush(port);
 }
 
+static uint32_t usbVcpRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    UNUSED(instance);
+
+    if ((APP_Rx_ptr_in == 0) || (APP_Rx_ptr_out == APP_Rx_ptr_in)) {
+        APP_Rx_ptr_out = 0;
+        APP_Rx_ptr_in = usb_vcp_get_rxdata(&otg_core_struct.dev, APP_Rx_Buffer);
+    }
+    *data = &APP_Rx_Buffer[APP_Rx_ptr_out];
+    return APP_Rx_ptr_in - APP_Rx_ptr_out;
+}
+
+static void usbVcpRxConsume(serialPort_t *instance, uint32_t count)
+{
+    UNUSED(instance);
+
+    APP_Rx_ptr_out += count;
+}
+
+static uint32_t usbVcpTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    *data = &port->txBuf[port->txAt];
+    return ARRAYLEN(port->txBuf) - port->txAt;
+}
+
+static void usbVcpTxCommit(serialPort_t *instance, uint32_t count)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    port->txAt += count;
+    if (!port->buffering || port->txAt >= ARRAYLEN(port->txBuf)) {
+        usbVcpFlush(port);
+    }
+}
+
 static const struct serialPortVTable usbVTable[] = {
     {
         .serialWrite = usbVcpWrite,
@@ -477,7 +514,11 @@ static const struct serialPortVTable usbVTable[] = {
         .setBaudRateCb = usbVcpSetBaudRateCb,
         .writeBuf =  usbVcpWriteBuf,
         .beginWrite = usbVcpBeginWrite,
-        .endWrite = usbVcpEndWrite
+        .endWrite = usbVcpEndWrite,
+        .rxSpan = usbVcpRxSpan,
+        .rxConsume = usbVcpRxConsume,
+        .txSpan = usbVcpTxSpan,
+        .txCommit = usbVcpTxCommit,
     }
 };
 
@@ -203,7 +203,7 @@ static void busDeviceDeInit(const extDevice_t *dev)
 static void b2smpbStartUP(baroDev_t *baro)
 {
     // start a forced measurement
-    busWriteRegister(&baro->dev, REG_CTRL_MEAS, REG_CLT_MEAS_VAL_TAVG4X_PAVG32X_FORCED);
+    busWriteRegisterStart(&baro->dev, REG_CTRL_MEAS, REG_CLT_MEAS_VAL_TAVG4X_PAVG32X_FORCED);
 }
 
 static bool b2smpbReadUP(baroDev_t *baro)
@@ -30,6 +30,7 @@
 #include "barometer.h"
 #include "barometer_lps.h"
 
+#include "drivers/bus.h"
 #include "drivers/bus_spi.h"
 #include "drivers/io.h"
 #include "drivers/time.h"
@@ -233,17 +234,28 @@ static bool lpsNothingBool(baroDev_t *baro)
     return true;
 }
 
-static bool lpsRead(baroDev_t *baro)
+// STATUS is followed by the pressure and temperature output registers, so one burst reads the lot
+#define LPS_DATA_FRAME_SIZE 6
+static DMA_DATA_ZERO_INIT uint8_t lpsData[LPS_DATA_FRAME_SIZE];
+
+// The LPS is SPI only, where the Start read still runs the burst to completion before returning. It does not wait
+// for a bus that is in use though, and returns false so the read is tried again.
+static bool lpsReadUP(baroDev_t *baro)
+{
+    // Auto-increment the register address through the burst
+    return busReadRegisterBufferStart(&baro->dev, LPS_STATUS | 0x40, lpsData, LPS_DATA_FRAME_SIZE);
+}
+
+static bool lpsGetUP(baroDev_t *baro)
 {
-    uint8_t status = 0x00;
-    lpsReadCommand(&baro->dev, LPS_STATUS, &status, 1);
-    if (status & 0x03) {
-        uint8_t temp[5];
-        lpsReadCommand(&baro->dev, LPS_OUT_XL, temp, 5);
+    if (busBusy(&baro->dev, NULL)) {
+        return false;
+    }
 
+    if (lpsData[0] & 0x03) {
         /* Build the raw data */
-        rawP = temp[0] | (temp[1] << 8) | (temp[2] << 16) | ((temp[2] & 0x80) ? 0xff000000 : 0);
-        rawT = (temp[4] << 8) | temp[3];
+        rawP = lpsData[1] | (lpsData[2] << 8) | (lpsData[3] << 16) | ((lpsData[3] & 0x80) ? 0xff000000 : 0);
+        rawT = (lpsData[5] << 8) | lpsData[4];
     } else {
         rawP = 0;
         rawT = 0;
@@ -295,12 +307,14 @@ bool lpsDetect(baroDev_t *baro)
     baro->get_ut = lpsNothingBool;
     baro->read_ut = lpsNothingBool;
     baro->start_up = lpsNothing;
-    baro->get_up = lpsRead;
-    baro->read_up = lpsNothingBool;
+    baro->get_up = lpsGetUP;
+    baro->read_up = lpsReadUP;
     baro->calculate = lpsCalculate;
     uint32_t timeout = millis();
     do {
-        lpsRead(baro);
+        if (lpsReadUP(baro)) {
+            while (!lpsGetUP(baro));
+        }
         if ((millis() - timeout) > 500) return false;
     } while (rawT == 0 && rawP == 0);
     rawT = 0;
@@ -302,7 +302,7 @@ static bool qmp6988GetUT(baroDev_t *baro)
 static void qmp6988StartUP(baroDev_t *baro)
 {
     // start measurement
-    busWriteRegister(&baro->dev, QMP6988_CTRL_MEAS_REG, QMP6988_PWR_SAMPLE_MODE);
+    busWriteRegisterStart(&baro->dev, QMP6988_CTRL_MEAS_REG, QMP6988_PWR_SAMPLE_MODE);
 }
 
 static bool qmp6988ReadUP(baroDev_t *baro)
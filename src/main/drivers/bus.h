@@ -42,6 +42,14 @@ typedef enum {
     BUS_ABORT
 } busStatus_e;
 
+// Transfers queued on a shared SPI bus are started in priority order, and a higher priority transfer may
+// also run between the segments of a lower priority one where chip select is negated
+typedef enum {
+    BUS_PRIORITY_LOW,       // Bulk transfers such as OSD and flash
+    BUS_PRIORITY_NORMAL,
+    BUS_PRIORITY_REALTIME,  // Gyro
+} busPriority_e;
+
 struct extDevice_s;
 
 // Bus interface, independent of connected device
@@ -106,6 +114,7 @@ typedef struct extDevice_s {
 #endif // UNIT_TEST
     // Support disabling DMA on a per device basis
     bool useDMA;
+    busPriority_e priority;
     // Per device buffer reference if needed
     uint8_t *txBuf, *rxBuf;
     // Connected devices on the same bus may support different speeds
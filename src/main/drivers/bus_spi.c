@@ -25,12 +25,14 @@
 #include "platform.h"
 
 #include "build/atomic.h"
+#include "build/trace.h"
 
 #ifdef USE_SPI
 
 #include "drivers/bus.h"
 #include "drivers/bus_spi.h"
 #include "drivers/bus_spi_impl.h"
+#include "drivers/bus_spi_queue.h"
 #include "drivers/dma_reqmap.h"
 #include "drivers/exti.h"
 #include "drivers/io.h"
@@ -407,6 +409,11 @@ FAST_IRQ_HANDLER static void spiIrqHandler(const extDevice_t *dev)
     busDevice_t *bus = dev->bus;
     busSegment_t *nextSegment;
 
+    TRACE_EVENT(TRACE_EVENT_SPI_DMA_COMPLETE, bus - spiBusDevice);
+
+    // Chip select was negated if the completed segment requested it, even if the segment is to be repeated
+    const bool csNegated = bus->curSegment->negateCS;
+
     if (bus->curSegment->callback) {
         switch(bus->curSegment->callback(dev->callbackArg)) {
         case BUS_BUSY:
@@ -449,6 +456,18 @@ FAST_IRQ_HANDLER static void spiIrqHandler(const extDevice_t *dev)
         // Do as much processing as possible before asserting CS to avoid violating minimum high time
         bool negateCS = bus->curSegment->negateCS;
 
+        if (csNegated) {
+            // Let a waiting transfer of higher priority run before the rest of this one
+            busSegment_t *preemptSegments;
+            const extDevice_t *preemptDev = spiQueuePreempt(dev, nextSegment, &preemptSegments);
+
+            if (preemptDev) {
+                bus->curSegment = preemptSegments;
+                spiSequenceStart(preemptDev);
+                return;
+            }
+        }
+
         bus->curSegment = nextSegment;
 
         // After the completion of the first segment setup the init structure for the subsequent segment
@@ -540,6 +559,7 @@ bool spiSetBusInstance(extDevice_t *dev, uint32_t device)
 
     // By default each device should use SPI DMA if the bus supports it
     dev->useDMA = true;
+    dev->priority = BUS_PRIORITY_NORMAL;
 
     if (dev->bus->busType == BUS_TYPE_SPI) {
         // This bus has already been initialised
@@ -751,42 +771,10 @@ void spiSequence(const extDevice_t *dev, busSegment_t *segments)
 
     ATOMIC_BLOCK(NVIC_PRIO_MAX) {
         if (spiIsBusy(dev)) {
-            busSegment_t *endSegment;
-
-            // Defer this transfer to be triggered upon completion of the current transfer
-
-            // Find the last segment of the new transfer
-            for (endSegment = segments; endSegment->len; endSegment++);
-
+            // Defer this transfer to be triggered upon completion of the current transfer, and of any
+            // queued transfers of the same or higher priority.
             // Safe to discard the volatile qualifier as we're in an atomic block
-            busSegment_t *endCmpSegment = (busSegment_t *)bus->curSegment;
-
-            if (endCmpSegment) {
-                while (true) {
-                    // Find the last segment of the current transfer
-                    for (; endCmpSegment->len; endCmpSegment++);
-
-                    if (endCmpSegment == endSegment) {
-                        /* Attempt to use the new segment list twice in the same queue. Abort.
-                         * Note that this can only happen with non-blocking transfers so drivers must take
-                         * care to avoid this.
-                         * */
-                        return;
-                    }
-
-                    if (endCmpSegment->u.link.dev == NULL) {
-                        // End of the segment list queue reached
-                        break;
-                    } else {
-                        // Follow the link to the next queued segment list
-                        endCmpSegment = (busSegment_t *)endCmpSegment->u.link.segments;
-                    }
-                }
-
-                // Record the dev and segments parameters in the terminating segment entry
-                endCmpSegment->u.link.dev = dev;
-                endCmpSegment->u.link.segments = segments;
-            }
+            spiQueueTransfer((busSegment_t *)bus->curSegment, dev, segments);
 
             return;
         } else {
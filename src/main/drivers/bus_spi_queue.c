@@ -0,0 +1,98 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "drivers/bus.h"
+#include "drivers/bus_spi_queue.h"
+
+static busSegment_t *spiQueueListEnd(busSegment_t *segments)
+{
+    while (segments->len) {
+        segments++;
+    }
+
+    return segments;
+}
+
+// Link segments into the chain following the transfer at curSegment, ahead of any transfers of lower priority.
+// Returns false if the segment list is already queued.
+bool spiQueueTransfer(busSegment_t *curSegment, const extDevice_t *dev, busSegment_t *segments)
+{
+    busSegment_t *endSegment = spiQueueListEnd(segments);
+    busSegment_t *insertAt = NULL;
+
+    for (busSegment_t *endCmpSegment = spiQueueListEnd(curSegment); ; endCmpSegment = spiQueueListEnd((busSegment_t *)endCmpSegment->u.link.segments)) {
+        if (endCmpSegment == endSegment) {
+            /* Attempt to use the new segment list twice in the same queue. Abort.
+             * Note that this can only happen with non-blocking transfers so drivers must take
+             * care to avoid this.
+             * */
+            return false;
+        }
+
+        const extDevice_t *queuedDev = endCmpSegment->u.link.dev;
+
+        if (!insertAt && (!queuedDev || queuedDev->priority < dev->priority)) {
+            insertAt = endCmpSegment;
+        }
+
+        if (!queuedDev) {
+            // End of the segment list queue reached
+            break;
+        }
+    }
+
+    // Take over the link of the transfer we follow
+    endSegment->u.link.dev = insertAt->u.link.dev;
+    endSegment->u.link.segments = insertAt->u.link.segments;
+    insertAt->u.link.dev = dev;
+    insertAt->u.link.segments = segments;
+
+    return true;
+}
+
+// Called between two segments of the transfer for dev with chip select negated. If the transfer at the head of the
+// queue has a higher priority it is unlinked and returned, with the rest of this transfer queued to follow it.
+const extDevice_t *spiQueuePreempt(const extDevice_t *dev, busSegment_t *nextSegment, busSegment_t **segments)
+{
+    busSegment_t *endSegment = spiQueueListEnd(nextSegment);
+    const extDevice_t *queuedDev = endSegment->u.link.dev;
+
+    if (!queuedDev || queuedDev->priority <= dev->priority) {
+        return NULL;
+    }
+
+    busSegment_t *queuedSegments = (busSegment_t *)endSegment->u.link.segments;
+    busSegment_t *queuedEndSegment = spiQueueListEnd(queuedSegments);
+
+    endSegment->u.link.dev = queuedEndSegment->u.link.dev;
+    endSegment->u.link.segments = queuedEndSegment->u.link.segments;
+    queuedEndSegment->u.link.dev = dev;
+    queuedEndSegment->u.link.segments = nextSegment;
+
+    *segments = queuedSegments;
+
+    return queuedDev;
+}
@@ -0,0 +1,30 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#pragma once
+
+#include "drivers/bus.h"
+
+// Transfers waiting for a busy bus are chained through the terminating segment of each segment list.
+// The chain is kept in order of device priority, first come first served within a priority.
+
+bool spiQueueTransfer(busSegment_t *curSegment, const extDevice_t *dev, busSegment_t *segments);
+const extDevice_t *spiQueuePreempt(const extDevice_t *dev, busSegment_t *nextSegment, busSegment_t **segments);
@@ -282,17 +282,51 @@ static bool ak8963WriteRegister(const extDevice_t *dev, uint8_t reg, uint8_t dat
     return busWriteRegister(dev, reg, data);
 }
 
+static bool ak8963WriteRegisterStart(const extDevice_t *dev, uint8_t reg, uint8_t data)
+{
+#if defined(USE_MAG_AK8963) && (defined(USE_GYRO_SPI_MPU6500) || defined(USE_GYRO_SPI_MPU9250))
+    if (dev->bus->busType == BUS_TYPE_MPU_SLAVE) {
+        return ak8963SlaveWriteRegister(dev, reg, data);
+    }
+#endif
+    return busWriteRegisterStart(dev, reg, data);
+}
+
 static bool ak8963DirectReadData(const extDevice_t *dev, uint8_t *buf)
 {
-    uint8_t status;
+    static uint8_t status;
+    static enum {
+        STATE_READ_STATUS1,
+        STATE_WAIT_STATUS1,
+        STATE_WAIT_DATA,
+    } state = STATE_READ_STATUS1;
+
+    // compassUpdate() only calls back once the bus is idle, so each state finds the previous transfer complete.
+    // A read refused because the bus is in use is tried again from the same state.
+    switch (state) {
+        default:
+        case STATE_READ_STATUS1:
+            if (busReadRegisterBufferStart(dev, AK8963_MAG_REG_ST1, &status, sizeof(status))) {
+                state = STATE_WAIT_STATUS1;
+            }
+            return false;
 
-    bool ack = ak8963ReadRegisterBuffer(dev, AK8963_MAG_REG_ST1, &status, 1);
+        case STATE_WAIT_STATUS1:
+            if ((status & ST1_DATA_READY) == 0) {
+                state = STATE_READ_STATUS1;
+                return false;
+            }
 
-    if (!ack || (status & ST1_DATA_READY) == 0) {
-        return false;
-    }
+            // read the 6 bytes of data and the status2 register
+            if (busReadRegisterBufferStart(dev, AK8963_MAG_REG_HXL, buf, 7)) {
+                state = STATE_WAIT_DATA;
+            }
+            return false;
 
-    return ak8963ReadRegisterBuffer(dev, AK8963_MAG_REG_HXL, buf, 7);
+        case STATE_WAIT_DATA:
+            state = STATE_READ_STATUS1;
+            return true;
+    }
 }
 
 static int16_t parseMag(uint8_t *raw, int16_t gain)
@@ -304,7 +338,7 @@ static int16_t parseMag(uint8_t *raw, int16_t gain)
 static bool ak8963Read(magDev_t *mag, int16_t *magData)
 {
     bool ack = false;
-    uint8_t buf[7];
+    static uint8_t buf[7];
 
     extDevice_t *dev = &mag->dev;
 
@@ -330,7 +364,7 @@ static bool ak8963Read(magDev_t *mag, int16_t *magData)
         return false;
     }
 
-    ak8963WriteRegister(dev, AK8963_MAG_REG_CNTL1, CNTL1_BIT_16_BIT | CNTL1_MODE_ONCE); // start reading again    uint8_t status2 = buf[6];
+    ak8963WriteRegisterStart(dev, AK8963_MAG_REG_CNTL1, CNTL1_BIT_16_BIT | CNTL1_MODE_ONCE); // start reading again
 
     if (status2 & ST2_MAG_SENSOR_OVERFLOW) {
         return false;
@@ -0,0 +1,32 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// Below this length the lookup tables are quicker than setting up the CRC unit
+#define CRC_HW_MIN_LENGTH   16
+
+void crcHwInit(void);
+// Non-reflected CRCs only; return false, leaving the crc untouched, if the unit is not available
+bool crcHwUpdate8(uint8_t *crc, uint8_t poly, const uint8_t *data, uint32_t length);
+bool crcHwUpdate16(uint16_t *crc, uint16_t poly, const uint8_t *data, uint32_t length);
@@ -135,6 +135,11 @@ static FAST_CODE void dshotWrite(uint8_t index, float value)
     pwmWriteDshotInt(index, lrintf(value));
 }
 
+static FAST_CODE void dshotWriteAll(const float *values, uint8_t count)
+{
+    pwmWriteDshotAll(values, count);
+}
+
 static motorVTable_t dshotPwmVTable = {
     .postInit = motorPostInitNull,
     .enable = dshotPwmEnableMotors,
@@ -143,6 +148,7 @@ static motorVTable_t dshotPwmVTable = {
     .decodeTelemetry = motorDecodeTelemetryNull, // May be updated after copying
     .write = dshotWrite,
     .writeInt = dshotWriteInt,
+    .writeAll = dshotWriteAll,
     .updateComplete = pwmCompleteDshotMotorUpdate,
     .convertExternalToMotor = dshotConvertFromExternal,
     .convertMotorToExternal = dshotConvertToExternal,
@@ -200,6 +206,7 @@ motorDevice_t *dshotPwmDevInit(const motorDevConfig_t *motorConfig, uint16_t idl
 
         /* not enough motors initialised for the mixer or a break in the motors */
         dshotPwmDevice.vTable.write = motorWriteNull;
+        dshotPwmDevice.vTable.writeAll = NULL;
         dshotPwmDevice.vTable.updateComplete = motorUpdateCompleteNull;
 
         /* TODO: block arming and add reason system cannot arm */
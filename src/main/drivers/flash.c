@@ -290,6 +290,9 @@ static bool flashSpiInit(const flashConfig_t *flashConfig)
         return false;
     }
 
+    // Page programs and reads give way to the gyro on a shared bus
+    dev->priority = BUS_PRIORITY_LOW;
+
     // Set the callback argument when calling back to this driver for DMA completion
     dev->callbackArg = (uint32_t)&flashDevice;
 
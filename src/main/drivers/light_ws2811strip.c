@@ -39,6 +39,7 @@
 
 #include "common/color.h"
 #include "common/colorconversion.h"
+#include "common/utils.h"
 
 #include "drivers/dma.h"
 #include "drivers/io.h"
@@ -73,8 +74,20 @@ static bool needsFullRefresh = true;
 uint16_t BIT_COMPARE_1 = 0;
 uint16_t BIT_COMPARE_0 = 0;
 
+// Compare values for each nibble of colour data, most significant bit first
+#define WS2811_LUT_BITS 4
+static uint32_t bitCompareLut[1 << WS2811_LUT_BITS][WS2811_LUT_BITS];
+static uint16_t bitCompareLut1;
+static uint16_t bitCompareLut0;
+
 static hsvColor_t ledColorBuffer[WS2811_DATA_BUFFER_SIZE];
 
+#if !defined(USE_WS2811_SINGLE_COLOUR)
+// Colours currently encoded in the DMA buffer, after brightness scaling, so unchanged LEDs can be skipped
+static hsvColor_t ledEncodedBuffer[WS2811_DATA_BUFFER_SIZE];
+static ledStripFormatRGB_e ledEncodedFormat;
+#endif
+
 #if !defined(USE_WS2811_SINGLE_COLOUR)
 void setLedHsv(uint16_t index, const hsvColor_t *color)
 {
@@ -123,6 +136,7 @@ void setUsedLedCount(unsigned ledCount)
 void ws2811LedStripInit(ioTag_t ioTag)
 {
     memset(ledStripDMABuffer, 0, sizeof(ledStripDMABuffer));
+    needsFullRefresh = true;
 
     ledStripIoTag = ioTag;
 }
@@ -148,6 +162,18 @@ bool isWS2811LedStripReady(void)
     return ws2811Initialised && !ws2811LedDataTransferInProgress;
 }
 
+static void updateBitCompareLut(void)
+{
+    for (unsigned nibble = 0; nibble < ARRAYLEN(bitCompareLut); nibble++) {
+        for (unsigned bit = 0; bit < WS2811_LUT_BITS; bit++) {
+            bitCompareLut[nibble][bit] = (nibble & (1 << (WS2811_LUT_BITS - 1 - bit))) ? BIT_COMPARE_1 : BIT_COMPARE_0;
+        }
+    }
+
+    bitCompareLut1 = BIT_COMPARE_1;
+    bitCompareLut0 = BIT_COMPARE_0;
+}
+
 STATIC_UNIT_TESTED void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex)
 {
     uint32_t bits_per_led;
@@ -175,28 +201,46 @@ STATIC_UNIT_TESTED void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbCol
         break;
     }
 
-    unsigned dmaBufferOffset = 0;
-    for (int index = bits_per_led-1; index >= 0; index--) {
-        ledStripDMABuffer[ledIndex * bits_per_led + dmaBufferOffset++] = (packed_colour & (1 << index)) ? BIT_COMPARE_1 : BIT_COMPARE_0;
+    // The compare values are set by the timer configuration
+    if (bitCompareLut1 != BIT_COMPARE_1 || bitCompareLut0 != BIT_COMPARE_0) {
+        updateBitCompareLut();
+    }
+
+    uint32_t *dmaBuffer = &ledStripDMABuffer[ledIndex * bits_per_led];
+    for (int shift = bits_per_led - WS2811_LUT_BITS; shift >= 0; shift -= WS2811_LUT_BITS) {
+        const uint32_t *compare = bitCompareLut[(packed_colour >> shift) & ((1 << WS2811_LUT_BITS) - 1)];
+        *dmaBuffer++ = compare[0];
+        *dmaBuffer++ = compare[1];
+        *dmaBuffer++ = compare[2];
+        *dmaBuffer++ = compare[3];
     }
 }
 
 /*
  * This method is non-blocking unless an existing LED update is in progress.
  * it does not wait until all the LEDs have been updated, that happens in the background.
+ * Returns false if the update was skipped, the caller has to try again later.
  */
-void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
+bool ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
 {
     // don't wait - risk of infinite block, just get an update next time round
     if (!ws2811Initialised || ws2811LedDataTransferInProgress) {
         schedulerIgnoreTaskStateTime();
-        return;
+        return false;
     }
 
     unsigned ledIndex = 0;              // reset led index
 
     // fill transmit buffer with correct compare values to achieve
     // correct pulse widths according to color values
+#if !defined(USE_WS2811_SINGLE_COLOUR)
+    // The offset of each LED in the DMA buffer depends on the format
+    if (ledFormat != ledEncodedFormat) {
+        needsFullRefresh = true;
+        ledEncodedFormat = ledFormat;
+    }
+#endif
+
     const unsigned ledUpdateCount = needsFullRefresh ? WS2811_DATA_BUFFER_SIZE : usedLedCount;
     const hsvColor_t hsvBlack = { 0, 0, 0 };
     while (ledIndex < ledUpdateCount) {
@@ -204,6 +248,16 @@ void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
         // Scale the LED brightness
         scaledLed.v = scaledLed.v * brightness / 100;
 
+#if !defined(USE_WS2811_SINGLE_COLOUR)
+        // The DMA buffer is retained between transfers, only re-encode LEDs which have changed
+        hsvColor_t *encodedLed = &ledEncodedBuffer[ledIndex];
+        if (!needsFullRefresh && scaledLed.h == encodedLed->h && scaledLed.s == encodedLed->s && scaledLed.v == encodedLed->v) {
+            ledIndex++;
+            continue;
+        }
+        *encodedLed = scaledLed;
+#endif
+
         rgbColor24bpp_t *rgb24 = hsvToRgb24(&scaledLed);
 
         updateLEDDMABuffer(ledFormat, rgb24, ledIndex++);
@@ -216,6 +270,8 @@ void ws2811UpdateStrip(ledStripFormatRGB_e ledFormat, uint8_t brightness)
 
     ws2811LedDataTransferInProgress = true;
     ws2811LedStripDMAEnable();
+
+    return true;
 }
 
 #endif
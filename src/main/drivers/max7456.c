@@ -355,6 +355,9 @@ max7456InitStatus_e max7456Init(const max7456Config_t *max7456Config, const vcdP
         return MAX7456_INIT_NOT_CONFIGURED;
     }
 
+    // Screen updates give way to the gyro on a shared bus
+    dev->priority = BUS_PRIORITY_LOW;
+
     dev->busType_u.spi.csnPin = IOGetByTag(max7456Config->csTag);
 
     if (!IOIsFreeOrPreinit(dev->busType_u.spi.csnPin)) {
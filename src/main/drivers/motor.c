@@ -56,7 +56,26 @@ void motorShutdown(void)
     delayMicroseconds(1500);
 }
 
-void motorWriteAll(float *values)
+static FAST_CODE void motorWriteValues(const float *values)
+{
+    if (motorDevice->vTable.writeAll) {
+        motorDevice->vTable.writeAll(values, motorDevice->count);
+    } else {
+        for (int i = 0; i < motorDevice->count; i++) {
+            motorDevice->vTable.write(i, values[i]);
+        }
+    }
+}
+
+// Hold the start of the transfer until outputAtUs, the PID loop works out when its cycle's output is due.
+// This spins the CPU, the caller bounds how long.
+static FAST_CODE void motorWaitUntil(timeUs_t outputAtUs)
+{
+    while (cmpTimeUs(micros(), outputAtUs) < 0) {
+    }
+}
+
+static FAST_CODE void motorWriteAllWithPhase(float *values, bool usePhase, timeUs_t outputAtUs)
 {
 #ifdef USE_PWM_OUTPUT
     if (motorDevice->enabled) {
@@ -68,15 +87,17 @@ void motorWriteAll(float *values)
             }
 
             // Update the motor data
-            for (int i = 0; i < motorDevice->count; i++) {
-                motorDevice->vTable.write(i, values[i]);
-            }
+            motorWriteValues(values);
 
             // Don't attempt to write commands to the motors if telemetry is still being received
             if (motorDevice->vTable.telemetryWait) {
                 (void)motorDevice->vTable.telemetryWait();
             }
 
+            if (usePhase) {
+                motorWaitUntil(outputAtUs);
+            }
+
             // Trigger the transmission of the motor data
             motorDevice->vTable.updateComplete();
 
@@ -95,8 +116,10 @@ void motorWriteAll(float *values)
 #endif
 
             // Update the motor data
-            for (int i = 0; i < motorDevice->count; i++) {
-                motorDevice->vTable.write(i, values[i]);
+            motorWriteValues(values);
+
+            if (usePhase) {
+                motorWaitUntil(outputAtUs);
             }
 
             // Trigger the transmission of the motor data
@@ -106,9 +129,22 @@ void motorWriteAll(float *values)
     }
 #else
     UNUSED(values);
+    UNUSED(usePhase);
+    UNUSED(outputAtUs);
 #endif
 }
 
+void motorWriteAll(float *values)
+{
+    motorWriteAllWithPhase(values, false, 0);
+}
+
+// Called from the PID loop, the transfer is started no earlier than outputAtUs
+void motorWriteAllAtPhase(float *values, timeUs_t outputAtUs)
+{
+    motorWriteAllWithPhase(values, true, outputAtUs);
+}
+
 unsigned motorDeviceCount(void)
 {
     return motorDevice->count;
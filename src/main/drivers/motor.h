@@ -55,6 +55,7 @@ typedef struct motorVTable_s {
     void (*updateInit)(void);
     void (*write)(uint8_t index, float value);
     void (*writeInt)(uint8_t index, uint16_t value);
+    void (*writeAll)(const float *values, uint8_t count); // Optional, encodes all motors in one pass instead of per motor write calls
     void (*updateComplete)(void);
     void (*shutdown)(void);
 
@@ -77,6 +78,7 @@ void motorUpdateCompleteNull(void);
 
 void motorPostInit();
 void motorWriteAll(float *values);
+void motorWriteAllAtPhase(float *values, timeUs_t outputAtUs);
 
 void motorInitEndpoints(const motorConfig_t *motorConfig, float outputLimit, float *outputLow, float *outputHigh, float *disarm, float *deadbandMotor3DHigh, float *deadbandMotor3DLow);
 
@@ -80,6 +80,38 @@ uint8_t getTimerIndex(TIM_TypeDef *timer)
     return dmaMotorTimerCount - 1;
 }
 
+static FAST_CODE void pwmLoadDshotDmaBuffer(motorDmaOutput_t *const motor, uint16_t packet)
+{
+    uint8_t bufferSize;
+
+#ifdef USE_DSHOT_DMAR
+    if (useBurstDshot) {
+        bufferSize = loadDmaBuffer(&motor->timer->dmaBurstBuffer[timerLookupChannelIndex(motor->timerHardware->channel)], 4, packet);
+        motor->timer->dmaBurstLength = bufferSize * 4;
+    } else
+#endif
+    {
+        bufferSize = loadDmaBuffer(motor->dmaBuffer, 1, packet);
+
+        motor->timer->timerDmaSources |= motor->timerDmaSource;
+
+#ifdef USE_FULL_LL_DRIVER
+        xLL_EX_DMA_SetDataLength(motor->dmaRef, bufferSize);
+        xLL_EX_DMA_EnableResource(motor->dmaRef);
+#else
+        xDMA_SetCurrDataCounter(motor->dmaRef, bufferSize);
+
+        // XXX we can remove this ifdef if we add a new macro for the TRUE/ENABLE constants
+        #ifdef AT32F435
+        xDMA_Cmd(motor->dmaRef, TRUE);
+        #else
+        xDMA_Cmd(motor->dmaRef, ENABLE);
+        #endif
+
+#endif // USE_FULL_LL_DRIVER
+    }
+}
+
 /**
  * Prepare to send dshot data for one motor
  * 
@@ -108,39 +140,50 @@ FAST_CODE void pwmWriteDshotInt(uint8_t index, uint16_t value)
 
     motor->protocolControl.value = value;
 
-    uint16_t packet = prepareDshotPacket(&motor->protocolControl);
-    uint8_t bufferSize;
+    pwmLoadDshotDmaBuffer(motor, prepareDshotPacket(&motor->protocolControl));
+}
 
-#ifdef USE_DSHOT_DMAR
-    if (useBurstDshot) {
-        bufferSize = loadDmaBuffer(&motor->timer->dmaBurstBuffer[timerLookupChannelIndex(motor->timerHardware->channel)], 4, packet);
-        motor->timer->dmaBurstLength = bufferSize * 4;
-    } else
-#endif
-    {
-        bufferSize = loadDmaBuffer(motor->dmaBuffer, 1, packet);
+/**
+ * Prepare to send dshot data for all motors
+ *
+ * Same result as pwmWriteDshotInt() for each motor, but the command queue is checked once
+ * and all packets are encoded before the dma buffers are loaded back to back.
+ *
+ * @param values motor outputs, one per motor
+ * @param count number of motors
+*/
+FAST_CODE void pwmWriteDshotAll(const float *values, uint8_t count)
+{
+    const bool commandProcessing = dshotCommandIsProcessing();
+    uint16_t packets[MAX_SUPPORTED_MOTORS];
 
-        motor->timer->timerDmaSources |= motor->timerDmaSource;
+    for (int i = 0; i < count; i++) {
+        motorDmaOutput_t *const motor = &dmaMotors[i];
+        if (!motor->configured) {
+            continue;
+        }
 
-#ifdef USE_FULL_LL_DRIVER
-        xLL_EX_DMA_SetDataLength(motor->dmaRef, bufferSize);
-        xLL_EX_DMA_EnableResource(motor->dmaRef);
-#else
-        xDMA_SetCurrDataCounter(motor->dmaRef, bufferSize);
+        uint16_t value = lrintf(values[i]);
 
-        // XXX we can remove this ifdef if we add a new macro for the TRUE/ENABLE constants
-        #ifdef AT32F435
-        xDMA_Cmd(motor->dmaRef, TRUE);
-        #else
-        xDMA_Cmd(motor->dmaRef, ENABLE);
-        #endif
+        if (commandProcessing) {
+            value = dshotCommandGetCurrent(i);
+            if (value) {
+                motor->protocolControl.requestTelemetry = true;
+            }
+        }
 
-#endif // USE_FULL_LL_DRIVER
+        motor->protocolControl.value = value;
+        packets[i] = prepareDshotPacket(&motor->protocolControl);
     }
 
+    for (int i = 0; i < count; i++) {
+        motorDmaOutput_t *const motor = &dmaMotors[i];
+        if (motor->configured) {
+            pwmLoadDshotDmaBuffer(motor, packets[i]);
+        }
+    }
 }
 
-
 #ifdef USE_DSHOT_TELEMETRY
 
 void dshotEnableChannels(uint8_t motorCount);
@@ -20,9 +20,12 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
+#include "common/maths.h"
+
 #include "serial.h"
 
 void serialPrint(serialPort_t *instance, const char *str)
@@ -48,6 +51,17 @@ void serialWriteBuf(serialPort_t *instance, const uint8_t *data, int count)
 {
     if (instance->vTable->writeBuf) {
         instance->vTable->writeBuf(instance, data, count);
+    } else if (instance->vTable->txSpan) {
+        while (count > 0) {
+            uint8_t *span;
+            const uint32_t spanCount = MIN(instance->vTable->txSpan(instance, &span), (uint32_t)count);
+            if (spanCount) {
+                memcpy(span, data, spanCount);
+                instance->vTable->txCommit(instance, spanCount);
+                data += spanCount;
+                count -= spanCount;
+            }
+        }
     } else {
         for (const uint8_t *p = data; count > 0; count--, p++) {
 
@@ -123,3 +137,101 @@ void serialEndWrite(serialPort_t *instance)
     if (instance->vTable->endWrite)
         instance->vTable->endWrite(instance);
 }
+
+uint32_t serialRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    if (instance->vTable->rxSpan) {
+        return instance->vTable->rxSpan(instance, data);
+    }
+    return 0;
+}
+
+void serialRxConsume(serialPort_t *instance, uint32_t count)
+{
+    if (instance->vTable->rxConsume) {
+        instance->vTable->rxConsume(instance, count);
+    }
+}
+
+uint32_t serialTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    if (instance->vTable->txSpan) {
+        return instance->vTable->txSpan(instance, data);
+    }
+    return 0;
+}
+
+void serialTxCommit(serialPort_t *instance, uint32_t count)
+{
+    if (instance->vTable->txCommit) {
+        instance->vTable->txCommit(instance, count);
+    }
+}
+
+// Read up to count bytes, returns the number read
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t count)
+{
+    uint32_t total = 0;
+
+    if (instance->vTable->rxSpan) {
+        while (total < count) {
+            const uint8_t *span;
+            const uint32_t spanCount = MIN(instance->vTable->rxSpan(instance, &span), count - total);
+            if (!spanCount) {
+                break;
+            }
+            memcpy(data + total, span, spanCount);
+            instance->vTable->rxConsume(instance, spanCount);
+            total += spanCount;
+        }
+    } else {
+        for (; total < count && serialRxBytesWaiting(instance); total++) {
+            data[total] = serialRead(instance);
+        }
+    }
+    return total;
+}
+
+uint32_t serialRingRxSpan(const serialPort_t *instance, const uint8_t **data)
+{
+    const uint32_t head = instance->rxBufferHead;
+    const uint32_t tail = instance->rxBufferTail;
+
+    *data = (const uint8_t *)&instance->rxBuffer[tail];
+    return (head >= tail ? head : instance->rxBufferSize) - tail;
+}
+
+void serialRingRxConsume(serialPort_t *instance, uint32_t count)
+{
+    uint32_t tail = instance->rxBufferTail + count;
+    if (tail >= instance->rxBufferSize) {
+        tail -= instance->rxBufferSize;
+    }
+    instance->rxBufferTail = tail;
+}
+
+uint32_t serialRingTxSpan(const serialPort_t *instance, uint32_t bytesFree, uint8_t **data)
+{
+    const uint32_t head = instance->txBufferHead;
+
+    *data = (uint8_t *)&instance->txBuffer[head];
+    return MIN(bytesFree, instance->txBufferSize - head);
+}
+
+void serialRingTxCommit(serialPort_t *instance, uint32_t count)
+{
+    uint32_t head = instance->txBufferHead + count;
+    if (head >= instance->txBufferSize) {
+        head -= instance->txBufferSize;
+    }
+    instance->txBufferHead = head;
+}
+
+bool serialSetRxEvent(serialPort_t *instance, serialRxEvent_t *rxEvent, int16_t delimiter, uint16_t watermark)
+{
+    instance->rxEventDelimiter = delimiter;
+    instance->rxEventWatermark = watermark;
+    instance->rxEvent = rxEvent;
+
+    return instance->rxEventCapable;
+}
@@ -64,6 +64,11 @@ typedef enum {
 typedef void (*serialReceiveCallbackPtr)(uint16_t data, void *rxCallbackData);   // used by serial drivers to return frames to app
 typedef void (*serialIdleCallbackPtr)();
 
+// Raised from the receive path when a frame may be complete so the consuming task can run without polling
+typedef struct serialRxEvent_s {
+    volatile bool pending;
+} serialRxEvent_t;
+
 typedef struct serialPort_s {
 
     const struct serialPortVTable *vTable;
@@ -87,6 +92,11 @@ typedef struct serialPort_s {
 
     serialIdleCallbackPtr idleCallback;
 
+    serialRxEvent_t *rxEvent;
+    int16_t rxEventDelimiter;       // -1 if the protocol has no frame delimiter
+    uint16_t rxEventWatermark;      // 0 if disabled
+    bool rxEventCapable;            // set by drivers which raise rxEvent
+
     uint8_t identifier;
 } serialPort_t;
 
@@ -132,6 +142,13 @@ struct serialPortVTable {
     // Optional functions used to buffer large writes.
     void (*beginWrite)(serialPort_t *instance);
     void (*endWrite)(serialPort_t *instance);
+
+    // Optional zero-copy access to the port buffers. A span is the contiguous part of a buffer that can be
+    // read or written without wrapping, so the remainder of a wrapped buffer is returned by the next call.
+    uint32_t (*rxSpan)(serialPort_t *instance, const uint8_t **data);
+    void (*rxConsume)(serialPort_t *instance, uint32_t count);
+    uint32_t (*txSpan)(serialPort_t *instance, uint8_t **data);
+    void (*txCommit)(serialPort_t *instance, uint32_t count);
 };
 
 void serialWrite(serialPort_t *instance, uint8_t ch);
@@ -151,3 +168,38 @@ uint32_t serialGetBaudRate(serialPort_t *instance);
 void serialWriteBufShim(void *instance, const uint8_t *data, int count);
 void serialBeginWrite(serialPort_t *instance);
 void serialEndWrite(serialPort_t *instance);
+
+// Spans are empty if the driver doesn't support them, fall back to serialRead()/serialWrite()
+uint32_t serialRxSpan(serialPort_t *instance, const uint8_t **data);
+void serialRxConsume(serialPort_t *instance, uint32_t count);
+uint32_t serialTxSpan(serialPort_t *instance, uint8_t **data);
+void serialTxCommit(serialPort_t *instance, uint32_t count);
+uint32_t serialReadBuf(serialPort_t *instance, uint8_t *data, uint32_t count);
+
+// Span helpers for drivers using the rx/tx ring buffers of serialPort_t
+uint32_t serialRingRxSpan(const serialPort_t *instance, const uint8_t **data);
+void serialRingRxConsume(serialPort_t *instance, uint32_t count);
+uint32_t serialRingTxSpan(const serialPort_t *instance, uint32_t bytesFree, uint8_t **data);
+void serialRingTxCommit(serialPort_t *instance, uint32_t count);
+
+// Returns false if the driver can't raise the event, the port must then be polled
+bool serialSetRxEvent(serialPort_t *instance, serialRxEvent_t *rxEvent, int16_t delimiter, uint16_t watermark);
+
+// Called by drivers from the receive path
+static inline void serialRxEventSignal(serialPort_t *instance)
+{
+    if (instance->rxEvent) {
+        instance->rxEvent->pending = true;
+    }
+}
+
+// Called by drivers once c has been stored in the rx ring buffer
+static inline void serialRxEventCheck(serialPort_t *instance, uint8_t c)
+{
+    if (instance->rxEvent) {
+        const uint32_t waiting = (instance->rxBufferHead >= instance->rxBufferTail) ? instance->rxBufferHead - instance->rxBufferTail : instance->rxBufferSize + instance->rxBufferHead - instance->rxBufferTail;
+        if (c == instance->rxEventDelimiter || (instance->rxEventWatermark && waiting >= instance->rxEventWatermark)) {
+            instance->rxEvent->pending = true;
+        }
+    }
+}
@@ -608,6 +608,20 @@ bool isSoftSerialTransmitBufferEmpty(const serialPort_t *instance)
     return instance->txBufferHead == instance->txBufferTail;
 }
 
+static uint32_t softSerialRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    if ((instance->mode & MODE_RX) == 0) {
+        return 0;
+    }
+
+    return serialRingRxSpan(instance, data);
+}
+
+static uint32_t softSerialTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    return serialRingTxSpan(instance, softSerialTxBytesFree(instance), data);
+}
+
 static const struct serialPortVTable softSerialVTable = {
     .serialWrite = softSerialWriteByte,
     .serialTotalRxWaiting = softSerialRxBytesWaiting,
@@ -620,7 +634,11 @@ static const struct serialPortVTable softSerialVTable = {
     .setBaudRateCb = NULL,
     .writeBuf = NULL,
     .beginWrite = NULL,
-    .endWrite = NULL
+    .endWrite = NULL,
+    .rxSpan = softSerialRxSpan,
+    .rxConsume = serialRingRxConsume,
+    .txSpan = softSerialTxSpan,
+    .txCommit = serialRingTxCommit,
 };
 
 #endif
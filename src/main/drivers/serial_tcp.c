@@ -146,6 +146,7 @@ serialPort_t *serTcpOpen(int id, serialReceiveCallbackPtr rxCallback, void *rxCa
     s->port.mode = mode;
     s->port.baudRate = baudRate;
     s->port.options = options;
+    s->port.rxEventCapable = true;
 
     return (serialPort_t *)s;
 }
@@ -259,9 +260,50 @@ void tcpDataIn(tcpPort_t *instance, uint8_t* ch, int size)
         }
     }
     pthread_mutex_unlock(&s->rxLock);
+    // Each segment is treated as a frame, the client sends whole requests
+    serialRxEventSignal(&s->port);
 //    printf("\n");
 }
 
+static uint32_t tcpRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    pthread_mutex_lock(&s->rxLock);
+    uint32_t count = serialRingRxSpan(instance, data);
+    pthread_mutex_unlock(&s->rxLock);
+
+    return count;
+}
+
+static void tcpRxConsume(serialPort_t *instance, uint32_t count)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    pthread_mutex_lock(&s->rxLock);
+    serialRingRxConsume(instance, count);
+    pthread_mutex_unlock(&s->rxLock);
+}
+
+static uint32_t tcpTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    const uint32_t bytesFree = tcpTotalTxBytesFree(instance);
+    pthread_mutex_lock(&s->txLock);
+    uint32_t count = serialRingTxSpan(instance, bytesFree, data);
+    pthread_mutex_unlock(&s->txLock);
+
+    return count;
+}
+
+static void tcpTxCommit(serialPort_t *instance, uint32_t count)
+{
+    tcpPort_t *s = (tcpPort_t *)instance;
+    pthread_mutex_lock(&s->txLock);
+    serialRingTxCommit(instance, count);
+    pthread_mutex_unlock(&s->txLock);
+
+    tcpDataOut(s);
+}
+
 static const struct serialPortVTable tcpVTable = {
         .serialWrite = tcpWrite,
         .serialTotalRxWaiting = tcpTotalRxBytesWaiting,
@@ -275,4 +317,8 @@ static const struct serialPortVTable tcpVTable = {
         .writeBuf = NULL,
         .beginWrite = NULL,
         .endWrite = NULL,
+        .rxSpan = tcpRxSpan,
+        .rxConsume = tcpRxConsume,
+        .txSpan = tcpTxSpan,
+        .txCommit = tcpTxCommit,
 };
@@ -34,6 +34,7 @@
 
 #include "build/build_config.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/dma.h"
@@ -135,6 +136,12 @@ serialPort_t *uartOpen(UARTDevice_e device, serialReceiveCallbackPtr rxCallback,
     uartPort->port.mode = mode;
     uartPort->port.baudRate = baudRate;
     uartPort->port.options = options;
+    // Received bytes are only seen by the CPU when RX is interrupt driven
+#ifdef USE_DMA
+    uartPort->port.rxEventCapable = !uartPort->rxDMAResource;
+#else
+    uartPort->port.rxEventCapable = true;
+#endif
 
     uartReconfigure(uartPort);
 
@@ -263,24 +270,41 @@ static uint8_t uartRead(serialPort_t *instance)
     return ch;
 }
 
-static void uartWrite(serialPort_t *instance, uint8_t ch)
+static uint32_t uartRxSpan(serialPort_t *instance, const uint8_t **data)
 {
     uartPort_t *uartPort = (uartPort_t *)instance;
 
-    // Check if the TX line is being pulled low by an unpowered peripheral
-    if (uartPort->checkUsartTxOutput && !uartPort->checkUsartTxOutput(uartPort)) {
-        // TX line is being pulled low, so don't transmit
-        return;
+#ifdef USE_DMA
+    if (uartPort->rxDMAResource) {
+        // rxDMAPos counts down from the end of the buffer
+        const uint32_t index = uartPort->port.rxBufferSize - uartPort->rxDMAPos;
+        *data = (const uint8_t *)&uartPort->port.rxBuffer[index];
+        return MIN(uartTotalRxBytesWaiting(instance), uartPort->rxDMAPos);
     }
+#endif
 
-    uartPort->port.txBuffer[uartPort->port.txBufferHead] = ch;
+    return serialRingRxSpan(instance, data);
+}
 
-    if (uartPort->port.txBufferHead + 1 >= uartPort->port.txBufferSize) {
-        uartPort->port.txBufferHead = 0;
-    } else {
-        uartPort->port.txBufferHead++;
+static void uartRxConsume(serialPort_t *instance, uint32_t count)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+#ifdef USE_DMA
+    if (uartPort->rxDMAResource) {
+        uartPort->rxDMAPos -= count;
+        if (uartPort->rxDMAPos == 0) {
+            uartPort->rxDMAPos = uartPort->port.rxBufferSize;
+        }
+        return;
     }
+#endif
+
+    serialRingRxConsume(instance, count);
+}
 
+static void uartStartTx(uartPort_t *uartPort)
+{
 #ifdef USE_DMA
     if (uartPort->txDMAResource) {
         uartTryStartTxDMA(uartPort);
@@ -297,6 +321,45 @@ static void uartWrite(serialPort_t *instance, uint8_t ch)
     }
 }
 
+static void uartWrite(serialPort_t *instance, uint8_t ch)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+    // Check if the TX line is being pulled low by an unpowered peripheral
+    if (uartPort->checkUsartTxOutput && !uartPort->checkUsartTxOutput(uartPort)) {
+        // TX line is being pulled low, so don't transmit
+        return;
+    }
+
+    uartPort->port.txBuffer[uartPort->port.txBufferHead] = ch;
+
+    if (uartPort->port.txBufferHead + 1 >= uartPort->port.txBufferSize) {
+        uartPort->port.txBufferHead = 0;
+    } else {
+        uartPort->port.txBufferHead++;
+    }
+
+    uartStartTx(uartPort);
+}
+
+static uint32_t uartTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    return serialRingTxSpan(instance, uartTotalTxBytesFree(instance), data);
+}
+
+static void uartTxCommit(serialPort_t *instance, uint32_t count)
+{
+    uartPort_t *uartPort = (uartPort_t *)instance;
+
+    // As for uartWrite(), drop the data if the TX line is being pulled low
+    if (uartPort->checkUsartTxOutput && !uartPort->checkUsartTxOutput(uartPort)) {
+        return;
+    }
+
+    serialRingTxCommit(instance, count);
+    uartStartTx(uartPort);
+}
+
 const struct serialPortVTable uartVTable[] = {
     {
         .serialWrite = uartWrite,
@@ -311,6 +374,10 @@ const struct serialPortVTable uartVTable[] = {
         .writeBuf = NULL,
         .beginWrite = NULL,
         .endWrite = NULL,
+        .rxSpan = uartRxSpan,
+        .rxConsume = uartRxConsume,
+        .txSpan = uartTxSpan,
+        .txCommit = uartTxCommit,
     }
 };
 
@@ -49,3 +49,5 @@ serialPort_t *usbVcpOpen(void);
 struct serialPort_s;
 uint32_t usbVcpGetBaudRate(struct serialPort_s *instance);
 uint8_t usbVcpIsConnected(void);
+// Called by the CDC interface when a packet has been received
+void usbVcpRxEvent(void);
@@ -26,12 +26,11 @@
 
 #include "build/debug.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/stack_check.h"
 
-#define STACK_FILL_CHAR 0xa5
-
 extern char _estack; // end of stack, declared in .LD file
 extern char _Min_Stack_Size; // declared in .LD file
 
@@ -58,37 +57,139 @@ extern char _Min_Stack_Size; // declared in .LD file
  * See the linker scripts for actual stack configuration.
  */
 
-#ifdef USE_STACK_CHECK
+// Words examined per update, a full pass over a 2K stack takes two updates
+#define STACK_CHECK_WORDS_PER_RUN 256
 
-static uint32_t usedStackSize;
+// Samples look this far below the watermark for a task that used more stack than has been seen so far
+#define STACK_SAMPLE_MARGIN_WORDS 64
 
-void taskStackCheck(timeUs_t currentTimeUs)
+// Words just below the caller's stack pointer that a sample leaves alone. They hold the frames of the
+// calls that do the painting, so a sample can read up to this much too deep
+#define STACK_SAMPLE_GUARD_WORDS 64
+
+void stackScanInit(stackScan_t *scan, uint32_t *low, uint32_t *high)
 {
-    UNUSED(currentTimeUs);
+    scan->low = low;
+    scan->high = high;
+    scan->watermark = NULL;
+    scan->cursor = low;
+    scan->sampleFloor = NULL;
+}
 
-    char * const stackHighMem = &_estack;
-    const uint32_t stackSize = (uint32_t)&_Min_Stack_Size;
-    char * const stackLowMem = stackHighMem - stackSize;
-    const char * const stackCurrent = (char *)&stackLowMem;
+// current is the stack pointer of the caller, which is in use
+void stackScanUpdate(stackScan_t *scan, uint32_t *current)
+{
+    if (!scan->watermark || current < scan->watermark) {
+        scan->watermark = current;
+    }
+
+    // The painted region below the watermark only ever shrinks, so a pass resumes where the last update
+    // stopped and never needs to look at or above the watermark
+    uint32_t *p = scan->cursor;
+    uint32_t * const scanEnd = MIN(p + STACK_CHECK_WORDS_PER_RUN, scan->watermark);
+    while (p < scanEnd && *p == STACK_FILL_WORD) {
+        p++;
+    }
+
+    if (p < scanEnd) {
+        scan->watermark = p;
+        scan->cursor = scan->low;
+    } else if (p >= scan->watermark) {
+        scan->cursor = scan->low;
+    } else {
+        scan->cursor = p;
+    }
+}
 
-    char *p;
-    for (p = stackLowMem; p < stackCurrent; ++p) {
-        if (*p != STACK_FILL_CHAR) {
+uint32_t stackScanUsedSize(const stackScan_t *scan)
+{
+    return scan->watermark ? (uint32_t)((scan->high - scan->watermark) * sizeof(uint32_t)) : 0;
+}
+
+// Repaint the stack the caller is not using so stackScanSampleEnd() can see how deep the next call goes.
+// current is the stack pointer of a caller up the chain, the guard below it covers the calls made since
+void stackScanSampleBegin(stackScan_t *scan, uint32_t *current)
+{
+    if (!scan->watermark) {
+        return;
+    }
+
+    scan->sampleFloor = scan->watermark - MIN(STACK_SAMPLE_MARGIN_WORDS, scan->watermark - scan->low);
+
+    // Record any use below the watermark the scan has not reached yet before painting over it
+    for (uint32_t *p = scan->sampleFloor; p < scan->watermark; p++) {
+        if (*p != STACK_FILL_WORD) {
+            scan->watermark = p;
             break;
         }
     }
 
-    usedStackSize = (uint32_t)stackHighMem - (uint32_t)p;
+    uint32_t * const paintEnd = current - MIN(STACK_SAMPLE_GUARD_WORDS, current - scan->watermark);
+    for (uint32_t *p = scan->watermark; p < paintEnd; p++) {
+        *p = STACK_FILL_WORD;
+    }
+}
+
+// Returns the deepest stack use in bytes since stackScanSampleBegin(), measured from the top of the stack
+uint32_t stackScanSampleEnd(stackScan_t *scan, uint32_t *current)
+{
+    if (!scan->sampleFloor) {
+        return 0;
+    }
+
+    uint32_t *p = scan->sampleFloor;
+    while (p < current && *p == STACK_FILL_WORD) {
+        p++;
+    }
+    scan->sampleFloor = NULL;
+
+    if (p < scan->watermark) {
+        scan->watermark = p;
+    }
 
-    DEBUG_SET(DEBUG_STACK, 0, (uint32_t)stackHighMem & 0xffff);
-    DEBUG_SET(DEBUG_STACK, 1, (uint32_t)stackLowMem & 0xffff);
+    return (uint32_t)((scan->high - p) * sizeof(uint32_t));
+}
+
+#ifdef USE_STACK_CHECK
+
+static stackScan_t mainStack;
+
+static uint32_t *stackLowMem(void)
+{
+    return (uint32_t *)(&_estack - (uint32_t)&_Min_Stack_Size);
+}
+
+void taskStackCheck(timeUs_t currentTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    if (!mainStack.low) {
+        stackScanInit(&mainStack, stackLowMem(), (uint32_t *)&_estack);
+    }
+
+    uint32_t * const stackCurrent = (uint32_t *)__get_MSP();
+    stackScanUpdate(&mainStack, stackCurrent);
+
+    DEBUG_SET(DEBUG_STACK, 0, (uint32_t)&_estack & 0xffff);
+    DEBUG_SET(DEBUG_STACK, 1, (uint32_t)mainStack.low & 0xffff);
     DEBUG_SET(DEBUG_STACK, 2, (uint32_t)stackCurrent & 0xffff);
-    DEBUG_SET(DEBUG_STACK, 3, (uint32_t)p & 0xffff);
+    DEBUG_SET(DEBUG_STACK, 3, (uint32_t)mainStack.watermark & 0xffff);
 }
 
 uint32_t stackUsedSize(void)
 {
-    return usedStackSize;
+    return stackScanUsedSize(&mainStack);
+}
+
+void stackSampleBegin(void)
+{
+    stackScanSampleBegin(&mainStack, (uint32_t *)__get_MSP());
+}
+
+// Includes the stack use of any interrupts taken since stackSampleBegin()
+uint32_t stackSampleEnd(void)
+{
+    return stackScanSampleEnd(&mainStack, (uint32_t *)__get_MSP());
 }
 #endif
 
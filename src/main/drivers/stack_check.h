@@ -22,7 +22,27 @@
 
 #include "common/time.h"
 
+#define STACK_FILL_CHAR 0xa5
+#define STACK_FILL_WORD 0xa5a5a5a5
+
+// Tracks the use of a full descending stack painted with STACK_FILL_WORD
+typedef struct stackScan_s {
+    uint32_t *low;          // lowest word of the stack
+    uint32_t *high;         // one past the highest word of the stack
+    uint32_t *watermark;    // lowest word known to have been used, NULL before the first update
+    uint32_t *cursor;       // where the next update resumes scanning up from the bottom of the stack
+    uint32_t *sampleFloor;  // lowest word painted by stackScanSampleBegin()
+} stackScan_t;
+
+void stackScanInit(stackScan_t *scan, uint32_t *low, uint32_t *high);
+void stackScanUpdate(stackScan_t *scan, uint32_t *current);
+uint32_t stackScanUsedSize(const stackScan_t *scan);
+void stackScanSampleBegin(stackScan_t *scan, uint32_t *current);
+uint32_t stackScanSampleEnd(stackScan_t *scan, uint32_t *current);
+
 void taskStackCheck(timeUs_t currentTimeUs);
 uint32_t stackUsedSize(void);
+void stackSampleBegin(void);
+uint32_t stackSampleEnd(void);
 uint32_t stackTotalSize(void);
 uint32_t stackHighMem(void);
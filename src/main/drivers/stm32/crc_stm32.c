@@ -0,0 +1,102 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#ifdef USE_CRC_HW
+
+#include "drivers/crc_hw.h"
+#include "drivers/rcc.h"
+
+// The F7, H7 and G4 CRC unit has a programmable polynomial of 7, 8, 16 or 32 bits.
+// F4 and AT32F43x only offer the fixed CRC-32 polynomial, which none of our protocols use.
+
+static bool crcHwReady = false;
+// The unit is shared between tasks and interrupt handlers. On a single core a nested user always
+// runs to completion before the interrupted one resumes, so a user that finds the unit busy simply
+// falls back to the lookup tables.
+static volatile bool crcHwBusy = false;
+
+void crcHwInit(void)
+{
+#if defined(STM32H7)
+    RCC_ClockCmd(RCC_AHB4(CRC), ENABLE);
+#else
+    RCC_ClockCmd(RCC_AHB1(CRC), ENABLE);
+#endif
+    crcHwReady = true;
+}
+
+static bool crcHwUpdate(uint32_t *crc, uint32_t poly, uint32_t polySize, const uint8_t *data, uint32_t length)
+{
+    if (!crcHwReady || crcHwBusy) {
+        return false;
+    }
+    crcHwBusy = true;
+
+    CRC->POL = poly;
+    CRC->INIT = *crc;
+    CRC->CR = polySize;
+    CRC->CR = polySize | CRC_CR_RESET;
+
+    const uint8_t *p = data;
+    const uint8_t *pend = data + length;
+
+    for (; p != pend && ((uintptr_t)p & 3); p++) {
+        *(__IO uint8_t *)&CRC->DR = *p;
+    }
+    // Input is not reflected, so words are consumed most significant byte first
+    for (; pend - p >= 4; p += 4) {
+        CRC->DR = __REV(*(const uint32_t *)p);
+    }
+    for (; p != pend; p++) {
+        *(__IO uint8_t *)&CRC->DR = *p;
+    }
+
+    *crc = CRC->DR;
+
+    crcHwBusy = false;
+    return true;
+}
+
+bool crcHwUpdate8(uint8_t *crc, uint8_t poly, const uint8_t *data, uint32_t length)
+{
+    uint32_t value = *crc;
+    if (!crcHwUpdate(&value, poly, CRC_CR_POLYSIZE_1, data, length)) {
+        return false;
+    }
+    *crc = value;
+    return true;
+}
+
+bool crcHwUpdate16(uint16_t *crc, uint16_t poly, const uint8_t *data, uint32_t length)
+{
+    uint32_t value = *crc;
+    if (!crcHwUpdate(&value, poly, CRC_CR_POLYSIZE_0, data, length)) {
+        return false;
+    }
+    *crc = value;
+    return true;
+}
+
+#endif // USE_CRC_HW
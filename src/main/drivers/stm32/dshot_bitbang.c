@@ -460,6 +460,7 @@ static bool bbMotorConfig(IO_t io, uint8_t motorIndex, motorPwmProtocolTypes_e p
 
         if (!bbPort || !dmaAllocate(dmaGetIdentifier(bbPort->dmaResource), bbPort->owner.owner, bbPort->owner.resourceIndex)) {
             bbDevice.vTable.write = motorWriteNull;
+            bbDevice.vTable.writeAll = NULL;
             bbDevice.vTable.decodeTelemetry = motorDecodeTelemetryNull;
             bbDevice.vTable.updateComplete = motorUpdateCompleteNull;
 
@@ -601,7 +602,18 @@ static bool bbDecodeTelemetry(void)
     return true;
 }
 
-static void bbWriteInt(uint8_t motorIndex, uint16_t value)
+static bool bbOutputInverted(void)
+{
+#ifdef USE_DSHOT_TELEMETRY
+    if (useDshotTelemetry) {
+        return DSHOT_BITBANG_INVERTED;
+    }
+#endif
+    return DSHOT_BITBANG_NONINVERTED;
+}
+
+// Encodes one motor, with the command queue state and output polarity resolved by the caller
+static void bbWriteMotor(uint8_t motorIndex, uint16_t value, bool commandProcessing, bool inverted)
 {
     bbMotor_t *const bbmotor = &bbMotors[motorIndex];
 
@@ -615,7 +627,7 @@ static void bbWriteInt(uint8_t motorIndex, uint16_t value)
     motor->protocolControl.requestTelemetry = false;
 
     // If there is a command ready to go overwrite the value and send that instead
-    if (dshotCommandIsProcessing()) {
+    if (commandProcessing) {
         value = dshotCommandGetCurrent(motorIndex);
         if (value) {
             bbmotor->protocolControl.requestTelemetry = true;
@@ -626,16 +638,12 @@ static void bbWriteInt(uint8_t motorIndex, uint16_t value)
 
     uint16_t packet = prepareDshotPacket(&bbmotor->protocolControl);
 
-    bbPort_t *bbPort = bbmotor->bbPort;
+    bbOutputDataSet(bbmotor->bbPort->portOutputBuffer, bbmotor->pinIndex, packet, inverted);
+}
 
-#ifdef USE_DSHOT_TELEMETRY
-    if (useDshotTelemetry) {
-        bbOutputDataSet(bbPort->portOutputBuffer, bbmotor->pinIndex, packet, DSHOT_BITBANG_INVERTED);
-    } else
-#endif
-    {
-        bbOutputDataSet(bbPort->portOutputBuffer, bbmotor->pinIndex, packet, DSHOT_BITBANG_NONINVERTED);
-    }
+static void bbWriteInt(uint8_t motorIndex, uint16_t value)
+{
+    bbWriteMotor(motorIndex, value, dshotCommandIsProcessing(), bbOutputInverted());
 }
 
 static void bbWrite(uint8_t motorIndex, float value)
@@ -643,6 +651,17 @@ static void bbWrite(uint8_t motorIndex, float value)
     bbWriteInt(motorIndex, lrintf(value));
 }
 
+// Encodes all motors in one pass, with the command queue and output polarity resolved once
+static void bbWriteAll(const float *values, uint8_t count)
+{
+    const bool commandProcessing = dshotCommandIsProcessing();
+    const bool inverted = bbOutputInverted();
+
+    for (int motorIndex = 0; motorIndex < count; motorIndex++) {
+        bbWriteMotor(motorIndex, lrintf(values[motorIndex]), commandProcessing, inverted);
+    }
+}
+
 static void bbUpdateComplete(void)
 {
     // If there is a dshot command loaded up, time it correctly with motor update
@@ -738,6 +757,7 @@ static motorVTable_t bbVTable = {
     .updateInit = bbUpdateInit,
     .write = bbWrite,
     .writeInt = bbWriteInt,
+    .writeAll = bbWriteAll,
     .updateComplete = bbUpdateComplete,
     .convertExternalToMotor = dshotConvertFromExternal,
     .convertMotorToExternal = dshotConvertToExternal,
@@ -782,6 +802,7 @@ motorDevice_t *dshotBitbangDevInit(const motorDevConfig_t *motorConfig, uint8_t
         if (!IOIsFreeOrPreinit(io)) {
             /* not enough motors initialised for the mixer or a break in the motors */
             bbDevice.vTable.write = motorWriteNull;
+            bbDevice.vTable.writeAll = NULL;
             bbDevice.vTable.decodeTelemetry = motorDecodeTelemetryNull;
             bbDevice.vTable.updateComplete = motorUpdateCompleteNull;
             bbStatus = DSHOT_BITBANG_STATUS_MOTOR_PIN_CONFLICT;
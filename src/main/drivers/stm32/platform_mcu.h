@@ -148,6 +148,7 @@
 #define USE_DMA_SPEC
 #define USE_PERSISTENT_OBJECTS
 #define USE_LATE_TASK_STATISTICS
+#define USE_CRC_HW
 #endif // STM32F7
 
 #ifdef STM32H7
@@ -170,6 +171,7 @@
 #define USE_RTC_TIME
 #define USE_PERSISTENT_MSC_RTC
 #define USE_LATE_TASK_STATISTICS
+#define USE_CRC_HW
 #endif
 
 #ifdef STM32G4
@@ -183,6 +185,7 @@
 #define USE_MCO
 #define USE_DMA_SPEC
 #define USE_LATE_TASK_STATISTICS
+#define USE_CRC_HW
 #endif
 
 #if defined(STM32F4) || defined(STM32F7) || defined(STM32H7) || defined(STM32G4)
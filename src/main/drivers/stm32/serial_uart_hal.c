@@ -366,6 +366,7 @@ FAST_IRQ_HANDLER void uartIrqHandler(uartPort_t *s)
         } else {
             s->port.rxBuffer[s->port.rxBufferHead] = rbyte;
             s->port.rxBufferHead = (s->port.rxBufferHead + 1) % s->port.rxBufferSize;
+            serialRxEventCheck(&s->port, rbyte);
         }
         CLEAR_BIT(huart->Instance->CR1, (USART_CR1_PEIE));
 
@@ -434,6 +435,7 @@ FAST_IRQ_HANDLER void uartIrqHandler(uartPort_t *s)
         if (s->port.idleCallback) {
             s->port.idleCallback();
         }
+        serialRxEventSignal(&s->port);
 
         __HAL_UART_CLEAR_IDLEFLAG(huart);
     }
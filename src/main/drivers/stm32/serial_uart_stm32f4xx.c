@@ -378,8 +378,10 @@ void uartIrqHandler(uartPort_t *s)
         if (s->port.rxCallback) {
             s->port.rxCallback(s->USARTx->DR, s->port.rxCallbackData);
         } else {
-            s->port.rxBuffer[s->port.rxBufferHead] = s->USARTx->DR;
+            const uint8_t ch = s->USARTx->DR;
+            s->port.rxBuffer[s->port.rxBufferHead] = ch;
             s->port.rxBufferHead = (s->port.rxBufferHead + 1) % s->port.rxBufferSize;
+            serialRxEventCheck(&s->port, ch);
         }
     }
 
@@ -408,6 +410,7 @@ void uartIrqHandler(uartPort_t *s)
         if (s->port.idleCallback) {
             s->port.idleCallback();
         }
+        serialRxEventSignal(&s->port);
 
         // clear
         (void) s->USARTx->SR;
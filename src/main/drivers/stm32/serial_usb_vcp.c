@@ -199,6 +199,38 @@ static void usbVcpEndWrite(serialPort_t *instance)
     usbVcpFlush(port);
 }
 
+static uint32_t usbVcpRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    UNUSED(instance);
+
+    return CDC_Receive_Span(data);
+}
+
+static void usbVcpRxConsume(serialPort_t *instance, uint32_t count)
+{
+    UNUSED(instance);
+
+    CDC_Receive_Consume(count);
+}
+
+static uint32_t usbVcpTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    *data = &port->txBuf[port->txAt];
+    return ARRAYLEN(port->txBuf) - port->txAt;
+}
+
+static void usbVcpTxCommit(serialPort_t *instance, uint32_t count)
+{
+    vcpPort_t *port = container_of(instance, vcpPort_t, port);
+
+    port->txAt += count;
+    if (!port->buffering || port->txAt >= ARRAYLEN(port->txBuf)) {
+        usbVcpFlush(port);
+    }
+}
+
 static const struct serialPortVTable usbVTable[] = {
     {
         .serialWrite = usbVcpWrite,
@@ -212,7 +244,11 @@ static const struct serialPortVTable usbVTable[] = {
         .setBaudRateCb = usbVcpSetBaudRateCb,
         .writeBuf = usbVcpWriteBuf,
         .beginWrite = usbVcpBeginWrite,
-        .endWrite = usbVcpEndWrite
+        .endWrite = usbVcpEndWrite,
+        .rxSpan = usbVcpRxSpan,
+        .rxConsume = usbVcpRxConsume,
+        .txSpan = usbVcpTxSpan,
+        .txCommit = usbVcpTxCommit,
     }
 };
 
@@ -277,10 +313,16 @@ serialPort_t *usbVcpOpen(void)
 
     s = &vcpPort;
     s->port.vTable = usbVTable;
+    s->port.rxEventCapable = true;
 
     return (serialPort_t *)s;
 }
 
+void usbVcpRxEvent(void)
+{
+    serialRxEventSignal(&vcpPort.port);
+}
+
 uint32_t usbVcpGetBaudRate(serialPort_t *instance)
 {
     UNUSED(instance);
@@ -322,6 +322,8 @@ static int8_t CDC_Itf_Receive(uint8_t* Buf, uint32_t *Len)
         // This will happen after a packet that's exactly 64 bytes is received.
         // The USB protocol requires that an empty (0 byte) packet immediately follow.
         USBD_CDC_ReceivePacket(&USBD_Device);
+    } else {
+        usbVcpRxEvent();
     }
     return (USBD_OK);
 }
@@ -407,6 +409,22 @@ uint32_t CDC_Receive_BytesAvailable(void)
     return rxAvailable;
 }
 
+// Zero-copy access to the received packet
+uint32_t CDC_Receive_Span(const uint8_t **data)
+{
+    *data = rxBuffPtr;
+    return rxBuffPtr ? rxAvailable : 0;
+}
+
+void CDC_Receive_Consume(uint32_t len)
+{
+    rxBuffPtr += len;
+    rxAvailable -= len;
+    if (rxAvailable < 1) {
+        USBD_CDC_ReceivePacket(&USBD_Device);
+    }
+}
+
 uint32_t CDC_Send_FreeBytes(void)
 {
     /*
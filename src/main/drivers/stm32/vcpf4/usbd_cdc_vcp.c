@@ -30,6 +30,7 @@
 #include "usbd_cdc_vcp.h"
 #include "stm32f4xx_conf.h"
 #include "drivers/nvic.h"
+#include "drivers/serial_usb_vcp.h"
 #include "drivers/time.h"
 
 #ifdef USB_OTG_HS_INTERNAL_DMA_ENABLED
@@ -248,6 +249,21 @@ uint32_t CDC_Receive_BytesAvailable(void)
     return (APP_Tx_ptr_in + APP_TX_DATA_SIZE - APP_Tx_ptr_out) % APP_TX_DATA_SIZE;
 }
 
+/* Zero-copy access to the contiguous part of the receive circular buffer */
+uint32_t CDC_Receive_Span(const uint8_t **data)
+{
+    const uint32_t in = APP_Tx_ptr_in;
+    const uint32_t out = APP_Tx_ptr_out;
+
+    *data = (const uint8_t *)&APP_Tx_Buffer[out];
+    return (in >= out ? in : APP_TX_DATA_SIZE) - out;
+}
+
+void CDC_Receive_Consume(uint32_t len)
+{
+    APP_Tx_ptr_out = (APP_Tx_ptr_out + len) % APP_TX_DATA_SIZE;
+}
+
 /**
  * @brief  VCP_DataRx
  *         Data received over USB OUT endpoint are sent over CDC interface
@@ -273,6 +289,7 @@ static uint16_t VCP_DataRx(uint8_t* Buf, uint32_t Len)
         APP_Tx_Buffer[APP_Tx_ptr_in] = Buf[i];
         APP_Tx_ptr_in = (APP_Tx_ptr_in + 1) % APP_TX_DATA_SIZE;
     }
+    usbVcpRxEvent();
 
     return USBD_OK;
 }
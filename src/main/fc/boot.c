@@ -0,0 +1,106 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "common/utils.h"
+
+#include "drivers/time.h"
+
+#include "boot.h"
+
+#ifdef USE_BOOT_PROFILE
+static timeUs_t bootPhaseEndUs[BOOT_PHASE_COUNT];
+
+static const char * const bootPhaseNames[BOOT_PHASE_COUNT] = {
+    [BOOT_PHASE_SYSTEM] = "SYSTEM",
+    [BOOT_PHASE_CONFIG] = "CONFIG",
+    [BOOT_PHASE_PREINIT] = "PREINIT",
+    [BOOT_PHASE_SERIAL] = "SERIAL",
+    [BOOT_PHASE_MOTORS] = "MOTORS",
+    [BOOT_PHASE_BUSES] = "BUSES",
+    [BOOT_PHASE_SENSORS] = "SENSORS",
+    [BOOT_PHASE_INDICATION] = "INDICATION",
+    [BOOT_PHASE_RX] = "RX",
+    [BOOT_PHASE_STORAGE] = "STORAGE",
+    [BOOT_PHASE_VTX] = "VTX",
+    [BOOT_PHASE_MSP] = "MSP",
+    [BOOT_PHASE_OSD] = "OSD",
+    [BOOT_PHASE_TASKS] = "TASKS",
+    [BOOT_PHASE_DEFERRED] = "DEFERRED",
+};
+
+void bootProfileMark(bootPhase_e phase)
+{
+    bootPhaseEndUs[phase] = micros();
+}
+
+// Returns 0 for phases which have not completed yet
+timeUs_t bootProfileGetPhaseEndUs(bootPhase_e phase)
+{
+    return bootPhaseEndUs[phase];
+}
+
+const char *bootProfileGetPhaseName(bootPhase_e phase)
+{
+    return bootPhaseNames[phase];
+}
+#endif
+
+static bootDeferredInitFn *deferredInit[BOOT_DEFERRED_INIT_MAX];
+static uint8_t deferredInitCount;
+static uint8_t deferredInitNext;
+
+void bootDeferInit(bootDeferredInitFn *fn)
+{
+    if (deferredInitCount < ARRAYLEN(deferredInit)) {
+        deferredInit[deferredInitCount++] = fn;
+    } else {
+        // No room to queue it, so don't defer it
+        fn();
+    }
+}
+
+bool bootHasDeferredInit(void)
+{
+    return deferredInitNext < deferredInitCount;
+}
+
+// Runs the next deferred init step, returns true while more remain
+bool bootRunDeferredInit(void)
+{
+    if (bootHasDeferredInit()) {
+        deferredInit[deferredInitNext++]();
+    }
+
+    if (bootHasDeferredInit()) {
+        return true;
+    }
+
+    deferredInitCount = 0;
+    deferredInitNext = 0;
+
+    BOOT_PROFILE_MARK(BOOT_PHASE_DEFERRED);
+
+    return false;
+}
@@ -0,0 +1,68 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+// Boot timeline. init() marks the end of each phase with a microsecond timestamp so boots can be
+// compared, see the CLI 'boot' command and MSP2_GET_BOOT_PROFILE.
+
+typedef enum {
+    BOOT_PHASE_SYSTEM = 0,      // clocks, IO and target configuration
+    BOOT_PHASE_CONFIG,          // config storage mount, EEPROM load and validation
+    BOOT_PHASE_PREINIT,         // buttons, receiver bind and clock reconfiguration
+    BOOT_PHASE_SERIAL,          // timers and serial ports
+    BOOT_PHASE_MOTORS,          // mixer, motor outputs, PWM/PPM receivers and beeper
+    BOOT_PHASE_BUSES,           // SPI, QSPI, OSPI and I2C busses, USB MSC and ADC
+    BOOT_PHASE_SENSORS,         // sensor detection, gyro filters, PID and servos
+    BOOT_PHASE_INDICATION,      // power on LED and beeper sequence
+    BOOT_PHASE_RX,              // IMU, failsafe, receiver, GPS, LED strip and ESC telemetry
+    BOOT_PHASE_STORAGE,         // flash, SD card, blackbox and sensor calibration
+    BOOT_PHASE_VTX,             // video transmitter control
+    BOOT_PHASE_MSP,             // battery, stats and MSP
+    BOOT_PHASE_OSD,             // CMS, OSD device search and dashboard
+    BOOT_PHASE_TASKS,           // telemetry, motor enable, SPI DMA and scheduler tasks
+    BOOT_PHASE_DEFERRED,        // init deferred to after the scheduler has started
+    BOOT_PHASE_COUNT
+} bootPhase_e;
+
+#define BOOT_DEFERRED_INIT_MAX 4
+
+#ifdef USE_BOOT_PROFILE
+void bootProfileMark(bootPhase_e phase);
+timeUs_t bootProfileGetPhaseEndUs(bootPhase_e phase);
+const char *bootProfileGetPhaseName(bootPhase_e phase);
+
+#define BOOT_PROFILE_MARK(phase)    bootProfileMark(phase)
+#else
+#define BOOT_PROFILE_MARK(phase)
+#endif
+
+// Init which is not needed before the scheduler starts is queued and run one step at a time
+// by TASK_DEFERRED_INIT once it has
+typedef void bootDeferredInitFn(void);
+
+void bootDeferInit(bootDeferredInitFn *fn);
+bool bootHasDeferredInit(void);
+bool bootRunDeferredInit(void);
@@ -103,6 +103,7 @@
 #include "sensors/boardalignment.h"
 #include "sensors/compass.h"
 #include "sensors/gyro.h"
+#include "sensors/gyro_init.h"
 
 #include "telemetry/telemetry.h"
 
@@ -1182,6 +1183,32 @@ void subTaskTelemetryPollSensors(timeUs_t currentTimeUs)
 }
 #endif
 
+// The hold is a busy wait in the PID task, every microsecond of it is taken from the other tasks. Keep it to a
+// small share of the PID loop time, 12us at 8kHz, and leave motor_output_phase_us at 0 unless the jitter matters more.
+#define MOTOR_OUTPUT_PHASE_MAX_PERCENT 10
+
+// With motor_output_phase_us set, the motor output is due that long after the gyro sample the cycle is working on,
+// so the motor update latency relative to the sample does not depend on how long the loop took
+static FAST_CODE timeUs_t motorOutputPhaseDeadlineUs(timeUs_t cycleStartUs)
+{
+    const timeDelta_t outputPhaseUs = MIN(motorConfig()->motorOutputPhaseUs, targetPidLooptime * MOTOR_OUTPUT_PHASE_MAX_PERCENT / 100);
+    timeUs_t phaseStartUs = cycleStartUs;
+
+#ifdef USE_SPI_GYRO
+    // The data ready interrupt timestamps the sample, without it the start of the cycle is the best estimate
+    const gyroDev_t *gyro = gyroActiveDev();
+    if (gyro->gyroModeSPI != GYRO_EXTI_NO_INT) {
+        const timeUs_t sampleUs = micros() - clockCyclesToMicros(cmpTimeCycles(getCycleCounter(), gyro->gyroLastEXTI));
+        // A sample taken since the cycle started is for the next cycle
+        if (cmpTimeUs(sampleUs, cycleStartUs) <= 0) {
+            phaseStartUs = sampleUs;
+        }
+    }
+#endif
+
+    return phaseStartUs + outputPhaseUs;
+}
+
 static FAST_CODE void subTaskMotorUpdate(timeUs_t currentTimeUs)
 {
     uint32_t startTime = 0;
@@ -1205,7 +1232,11 @@ static FAST_CODE void subTaskMotorUpdate(timeUs_t currentTimeUs)
     }
 #endif
 
-    writeMotors();
+    if (motorConfig()->motorOutputPhaseUs) {
+        writeMotorsAtPhase(motorOutputPhaseDeadlineUs(currentTimeUs));
+    } else {
+        writeMotors();
+    }
 
 #ifdef USE_DSHOT_TELEMETRY_STATS
     if (debugMode == DEBUG_DSHOT_RPM_ERRORS && useDshotTelemetry) {
@@ -24,6 +24,7 @@
 
 #include "platform.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "drivers/time.h"
@@ -32,7 +33,22 @@
 
 #include "scheduler/scheduler.h"
 
-static dispatchEntry_t *head = NULL;
+// Entries are held in a hierarchical timer wheel. Level 0 has one slot per tick, each slot of a higher level
+// covers a whole revolution of the level below and is cascaded down when the level below wraps. Adding and
+// cancelling are O(1), processing only visits occupied slots.
+#define DISPATCH_TICK_SHIFT     10      // 1.024ms per tick
+#define DISPATCH_WHEEL_BITS     5
+#define DISPATCH_WHEEL_SLOTS    (1 << DISPATCH_WHEEL_BITS)
+#define DISPATCH_WHEEL_MASK     (DISPATCH_WHEEL_SLOTS - 1)
+#define DISPATCH_WHEEL_LEVELS   4
+#define DISPATCH_WHEEL_SPAN     (1 << (DISPATCH_WHEEL_BITS * DISPATCH_WHEEL_LEVELS))  // ~18 minutes, longer delays are re-added when they reach the end
+#define DISPATCH_TICK_BITS      (32 - DISPATCH_TICK_SHIFT)
+#define DISPATCH_TICK_MASK      ((1 << DISPATCH_TICK_BITS) - 1)
+
+static dispatchEntry_t *wheel[DISPATCH_WHEEL_LEVELS][DISPATCH_WHEEL_SLOTS];
+static uint32_t wheelOccupied[DISPATCH_WHEEL_LEVELS];
+static uint32_t wheelTick;              // next tick to be processed
+static unsigned dispatchCount;
 static bool dispatchEnabled = false;
 
 bool dispatchIsEnabled(void)
@@ -45,33 +61,247 @@ void dispatchEnable(void)
     dispatchEnabled = true;
 }
 
+static uint32_t usToTick(uint32_t timeUs)
+{
+    return timeUs >> DISPATCH_TICK_SHIFT;
+}
+
+// Ticks wrap along with the microsecond timer
+static int32_t tickDelta(uint32_t a, uint32_t b)
+{
+    return (int32_t)((a - b) << DISPATCH_TICK_SHIFT) >> DISPATCH_TICK_SHIFT;
+}
+
+// Distance from slot to the next occupied slot, wrapping, or DISPATCH_WHEEL_SLOTS if there is none
+static unsigned nextOccupied(uint32_t occupied, unsigned slot)
+{
+    const uint32_t rotated = (occupied >> slot) | (occupied << ((DISPATCH_WHEEL_SLOTS - slot) & DISPATCH_WHEEL_MASK));
+
+    return rotated ? (unsigned)__builtin_ctz(rotated) : DISPATCH_WHEEL_SLOTS;
+}
+
+static void dispatchLink(dispatchEntry_t *entry)
+{
+    // Round up so entries never fire early
+    uint32_t tick = usToTick(entry->delayedUntil + (1 << DISPATCH_TICK_SHIFT) - 1);
+    int32_t delta = tickDelta(tick, wheelTick);
+
+    if (delta < 0) {
+        delta = 0;
+        tick = wheelTick;
+    } else if (delta >= DISPATCH_WHEEL_SPAN) {
+        delta = DISPATCH_WHEEL_SPAN - 1;
+        tick = (wheelTick + delta) & DISPATCH_TICK_MASK;
+    }
+
+    unsigned level = 0;
+    while (delta >= (1 << (DISPATCH_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    const unsigned slot = (tick >> (DISPATCH_WHEEL_BITS * level)) & DISPATCH_WHEEL_MASK;
+
+    dispatchEntry_t **head = &wheel[level][slot];
+    entry->next = *head;
+    if (entry->next) {
+        entry->next->prev = &entry->next;
+    }
+    entry->prev = head;
+    *head = entry;
+    entry->level = level;
+    entry->slot = slot;
+    wheelOccupied[level] |= 1 << slot;
+}
+
+static void dispatchUnlink(dispatchEntry_t *entry)
+{
+    *entry->prev = entry->next;
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    }
+    if (!wheel[entry->level][entry->slot]) {
+        wheelOccupied[entry->level] &= ~(1 << entry->slot);
+    }
+}
+
+static void dispatchCascade(void)
+{
+    // Move the slot of each level whose lower levels have just wrapped down the wheel
+    for (unsigned level = 1; level < DISPATCH_WHEEL_LEVELS; level++) {
+        const unsigned slot = (wheelTick >> (DISPATCH_WHEEL_BITS * level)) & DISPATCH_WHEEL_MASK;
+        dispatchEntry_t *entry = wheel[level][slot];
+
+        wheel[level][slot] = NULL;
+        wheelOccupied[level] &= ~(1 << slot);
+
+        while (entry) {
+            dispatchEntry_t *next = entry->next;
+            dispatchLink(entry);
+            entry = next;
+        }
+
+        if (slot != 0) {
+            break;
+        }
+    }
+}
+
+bool dispatchGetNextDeadline(uint32_t *deadlineUs)
+{
+    if (!dispatchCount) {
+        return false;
+    }
+
+    // Level 0 entries are due at the tick of their slot, higher levels need processing when their slot is cascaded
+    uint32_t deadlineTick = wheelTick + DISPATCH_WHEEL_SPAN;
+    if (wheelOccupied[0]) {
+        deadlineTick = wheelTick + nextOccupied(wheelOccupied[0], wheelTick & DISPATCH_WHEEL_MASK);
+    }
+
+    for (unsigned level = 1; level < DISPATCH_WHEEL_LEVELS; level++) {
+        if (wheelOccupied[level]) {
+            const unsigned shift = DISPATCH_WHEEL_BITS * level;
+            const uint32_t base = wheelTick >> shift;
+            const unsigned distance = nextOccupied(wheelOccupied[level], (base + 1) & DISPATCH_WHEEL_MASK) + 1;
+            const uint32_t cascadeTick = (base + distance) << shift;
+
+            if (tickDelta(cascadeTick, deadlineTick) < 0) {
+                deadlineTick = cascadeTick;
+            }
+        }
+    }
+
+    *deadlineUs = deadlineTick << DISPATCH_TICK_SHIFT;
+
+    return true;
+}
+
+bool dispatchUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
+{
+    UNUSED(currentDeltaTimeUs);
+
+    uint32_t deadlineUs;
+
+    return dispatchGetNextDeadline(&deadlineUs) && cmp32(currentTimeUs, deadlineUs) >= 0;
+}
+
+// Move over empty slots up to and including nowTick, cascading each level above as the one below wraps
+static void dispatchAdvance(uint32_t nowTick)
+{
+    while (tickDelta(nowTick, wheelTick) >= 0) {
+        const unsigned slot = wheelTick & DISPATCH_WHEEL_MASK;
+
+        if (wheelOccupied[0] & (1 << slot)) {
+            break;
+        }
+
+        // Skip to the next occupied slot, stopping where the level above needs cascading
+        const unsigned skip = MIN(nextOccupied(wheelOccupied[0], slot), DISPATCH_WHEEL_SLOTS - slot);
+        const uint32_t remaining = tickDelta(nowTick, wheelTick) + 1;
+
+        wheelTick = (wheelTick + MIN(skip, remaining)) & DISPATCH_TICK_MASK;
+
+        if ((wheelTick & DISPATCH_WHEEL_MASK) == 0) {
+            dispatchCascade();
+        }
+    }
+}
+
 void dispatchProcess(uint32_t currentTimeUs)
 {
-    for (dispatchEntry_t **p = &head; *p; ) {
-        if (cmp32(currentTimeUs, (*p)->delayedUntil) < 0)
+    const uint32_t nowTick = usToTick(currentTimeUs);
+
+    while (dispatchCount) {
+        dispatchAdvance(nowTick);
+
+        if (tickDelta(nowTick, wheelTick) < 0) {
             break;
-        // unlink entry first, so handler can replan self
-        dispatchEntry_t *current = *p;
-        *p = (*p)->next;
-        current->inQue = false;
-        (*current->dispatch)(current);
+        }
+
+        // Detach the slot and advance first, entries added or relinked by handlers then land in the wheel instead
+        const unsigned slot = wheelTick & DISPATCH_WHEEL_MASK;
+        dispatchEntry_t *pending = wheel[0][slot];
+
+        pending->prev = &pending;
+        wheel[0][slot] = NULL;
+        wheelOccupied[0] &= ~(1 << slot);
+
+        wheelTick = (wheelTick + 1) & DISPATCH_TICK_MASK;
+        if ((wheelTick & DISPATCH_WHEEL_MASK) == 0) {
+            dispatchCascade();
+        }
+
+        while (pending) {
+            // unlink entry first, so handler can replan self
+            dispatchEntry_t *current = pending;
+            dispatchUnlink(current);
+
+            if (cmp32(currentTimeUs, current->delayedUntil) < 0) {
+                // Beyond the span of the wheel when added
+                dispatchLink(current);
+                continue;
+            }
+
+            if (current->periodUs) {
+                current->delayedUntil += current->periodUs;
+                if (cmp32(currentTimeUs, current->delayedUntil) >= 0) {
+                    // Running late, don't try to catch up
+                    current->delayedUntil = currentTimeUs + current->periodUs;
+                }
+                dispatchLink(current);
+            } else {
+                current->inQue = false;
+                dispatchCount--;
+            }
+
+            (*current->dispatch)(current);
+        }
+    }
+
+    if (!dispatchCount) {
+        wheelTick = nowTick;
     }
 }
 
-void dispatchAdd(dispatchEntry_t *entry, int delayUs)
+static void dispatchSchedule(dispatchEntry_t *entry, int delayUs, uint32_t periodUs)
 {
-    uint32_t delayedUntil = micros() + delayUs;
-    dispatchEntry_t **p = &head;
+    const uint32_t currentTimeUs = micros();
 
     if (entry->inQue) {
       return;    // Allready in Queue, abort
     }
 
-    while (*p && cmp32((*p)->delayedUntil, delayedUntil) < 0)
-        p = &(*p)->next;
+    if (!dispatchCount) {
+        // Nothing has been tracking time while the wheel was empty
+        wheelTick = usToTick(currentTimeUs);
+    } else {
+        // The wheel is only processed when something is due, so it may lag behind the current tick
+        dispatchAdvance(usToTick(currentTimeUs));
+    }
 
-    entry->next = *p;
-    entry->delayedUntil = delayedUntil;
+    entry->delayedUntil = currentTimeUs + delayUs;
+    entry->periodUs = periodUs;
     entry->inQue = true;
-    *p = entry;
+    dispatchLink(entry);
+    dispatchCount++;
+}
+
+void dispatchAdd(dispatchEntry_t *entry, int delayUs)
+{
+    dispatchSchedule(entry, delayUs, 0);
+}
+
+void dispatchAddPeriodic(dispatchEntry_t *entry, int periodUs)
+{
+    dispatchSchedule(entry, periodUs, periodUs);
+}
+
+void dispatchCancel(dispatchEntry_t *entry)
+{
+    if (!entry->inQue) {
+        return;
+    }
+
+    dispatchUnlink(entry);
+    entry->inQue = false;
+    dispatchCount--;
 }
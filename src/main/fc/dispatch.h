@@ -20,6 +20,8 @@
 
 #pragma once
 
+#include "common/time.h"
+
 struct dispatchEntry_s;
 typedef void dispatchFunc(struct dispatchEntry_s* self);
 
@@ -28,9 +30,17 @@ typedef struct dispatchEntry_s {
     uint32_t delayedUntil;
     struct dispatchEntry_s *next;
     bool inQue;
+    uint32_t periodUs;              // 0 for one-shot entries
+    struct dispatchEntry_s **prev;  // link referring to this entry, for O(1) removal
+    uint8_t level;
+    uint8_t slot;
 } dispatchEntry_t;
 
 bool dispatchIsEnabled(void);
 void dispatchEnable(void);
+bool dispatchUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs);
 void dispatchProcess(uint32_t currentTime);
 void dispatchAdd(dispatchEntry_t *entry, int delayUs);
+void dispatchAddPeriodic(dispatchEntry_t *entry, int periodUs);
+void dispatchCancel(dispatchEntry_t *entry);
+bool dispatchGetNextDeadline(uint32_t *deadlineUs);
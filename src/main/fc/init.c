@@ -53,6 +53,7 @@
 #include "drivers/buttons.h"
 #include "drivers/camera_control_impl.h"
 #include "drivers/compass/compass.h"
+#include "drivers/crc_hw.h"
 #include "drivers/dma.h"
 #include "drivers/exti.h"
 #include "drivers/flash.h"
@@ -85,6 +86,7 @@
 #include "drivers/vtx_table.h"
 
 #include "fc/board_info.h"
+#include "fc/boot.h"
 #include "fc/dispatch.h"
 #include "fc/gps_lap_timer.h"
 #include "fc/init.h"
@@ -138,6 +140,7 @@
 #include "pg/adc.h"
 #include "pg/beeper.h"
 #include "pg/beeper_dev.h"
+#include "pg/boot.h"
 #include "pg/bus_i2c.h"
 #include "pg/bus_spi.h"
 #include "pg/bus_quadspi.h"
@@ -256,6 +259,76 @@ static void sdCardAndFSInit(void)
 }
 #endif
 
+#ifdef USE_OSD
+// Starts the search for an OSD device at the given one. The device set in the config is used even
+// if it is not found yet, any other is passed over for the next in the search order.
+// Starting at the hinted device probes only that one, any other search skips it.
+static osdDisplayPortDevice_e osdDisplayPortSearch(osdDisplayPortDevice_e device, osdDisplayPortDevice_e hint, displayPort_t **osdDisplayPort)
+{
+    const bool configured = device != OSD_DISPLAYPORT_DEVICE_AUTO && device == osdConfig()->displayPortDevice;
+    const bool hinted = device == hint;
+
+    switch(device) {
+
+    case OSD_DISPLAYPORT_DEVICE_AUTO:
+        FALLTHROUGH;
+
+#if defined(USE_FRSKYOSD)
+    // Test OSD_DISPLAYPORT_DEVICE_FRSKYOSD first, since an FC could
+    // have a builtin MAX7456 but also an FRSKYOSD connected to an
+    // uart.
+    case OSD_DISPLAYPORT_DEVICE_FRSKYOSD:
+        if (hinted || hint != OSD_DISPLAYPORT_DEVICE_FRSKYOSD) {
+            *osdDisplayPort = frskyOsdDisplayPortInit(vcdProfile()->video_system);
+            if (*osdDisplayPort || configured) {
+                return OSD_DISPLAYPORT_DEVICE_FRSKYOSD;
+            }
+        }
+        if (hinted) {
+            break;
+        }
+        FALLTHROUGH;
+#endif
+
+#if defined(USE_MAX7456)
+    case OSD_DISPLAYPORT_DEVICE_MAX7456:
+        // If there is a max7456 chip for the OSD configured and detected then use it.
+        if (hinted || hint != OSD_DISPLAYPORT_DEVICE_MAX7456) {
+            if (max7456DisplayPortInit(vcdProfile(), osdDisplayPort) || configured) {
+                return OSD_DISPLAYPORT_DEVICE_MAX7456;
+            }
+        }
+        if (hinted) {
+            break;
+        }
+        FALLTHROUGH;
+#endif
+
+#if defined(USE_CMS) && defined(USE_MSP_DISPLAYPORT) && defined(USE_OSD_OVER_MSP_DISPLAYPORT)
+    case OSD_DISPLAYPORT_DEVICE_MSP:
+        if (hinted || hint != OSD_DISPLAYPORT_DEVICE_MSP) {
+            *osdDisplayPort = displayPortMspInit();
+            if (*osdDisplayPort || configured) {
+                return OSD_DISPLAYPORT_DEVICE_MSP;
+            }
+        }
+        if (hinted) {
+            break;
+        }
+        FALLTHROUGH;
+#endif
+
+    // Other device cases can be added here
+
+    case OSD_DISPLAYPORT_DEVICE_NONE:
+    default:
+        break;
+    }
+
+    return OSD_DISPLAYPORT_DEVICE_NONE;
+}
+#endif
+
 void init(void)
 {
 #ifdef SERIAL_PORT_COUNT
@@ -264,6 +337,10 @@ void init(void)
 
     systemInit();
 
+#ifdef USE_CRC_HW
+    crcHwInit();
+#endif
+
     // Initialize task data as soon as possible. Has to be done before tasksInit(),
     // and any init code that may try to modify task behaviour before tasksInit().
     tasksInitData();
@@ -280,6 +357,8 @@ void init(void)
     targetConfiguration();
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_SYSTEM);
+
     enum {
         FLASH_INIT_ATTEMPTED                = (1 << 0),
         SD_INIT_ATTEMPTED                   = (1 << 1),
@@ -399,6 +478,12 @@ void init(void)
 
     systemState |= SYSTEM_STATE_CONFIG_LOADED;
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_CONFIG);
+
+    // Hardware found on this boot is compared against what was cached on the last one
+    const bool fastBoot = bootConfig()->fastBoot;
+    const bootConfig_t bootCache = *bootConfig();
+
 #ifdef USE_DEBUG_PIN
     dbgPinInit();
 #endif
@@ -504,6 +589,8 @@ void init(void)
 #endif
 #endif // USE_MCO
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_PREINIT);
+
 #ifdef USE_TIMER
     timerInit();  // timer must be initialized before any channel is allocated
 #endif
@@ -529,6 +616,8 @@ void init(void)
     serialInit(featureIsEnabled(FEATURE_SOFTSERIAL), SERIAL_PORT_NONE);
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_SERIAL);
+
     mixerInit(mixerConfig()->mixerMode);
 
     uint16_t idlePulse = motorConfig()->mincommand;
@@ -568,6 +657,7 @@ void init(void)
     initInverters(serialPinConfig());
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_MOTORS);
 
 #ifdef TARGET_BUS_INIT
     targetBusInit();
@@ -673,6 +763,8 @@ void init(void)
     adcInit(adcConfig());
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_BUSES);
+
     initBoardAlignment(boardAlignment());
 
     if (!sensorsAutodetect()) {
@@ -726,27 +818,40 @@ void init(void)
     pinioBoxInit(pinioBoxConfig());
 #endif
 
+    // Keep the sensors found on this boot for the next one. This is written before any receiver is
+    // started, the OSD device found later is only kept with the next save of the config
+    if (fastBoot && memcmp(&bootCache, bootConfig(), sizeof(bootCache))) {
+        writeUnmodifiedConfigToEEPROM();
+    }
+
+    BOOT_PROFILE_MARK(BOOT_PHASE_SENSORS);
+
     LED1_ON;
     LED0_OFF;
     LED2_OFF;
 
-    for (int i = 0; i < 10; i++) {
-        LED1_TOGGLE;
-        LED0_TOGGLE;
+    // The power on indication holds up boot for half a second, fast boot goes without it
+    if (!fastBoot) {
+        for (int i = 0; i < 10; i++) {
+            LED1_TOGGLE;
+            LED0_TOGGLE;
 #if defined(USE_BEEPER)
-        delay(25);
-        if (!(beeperConfig()->beeper_off_flags & BEEPER_GET_FLAG(BEEPER_SYSTEM_INIT))) {
-            BEEP_ON;
-        }
-        delay(25);
-        BEEP_OFF;
+            delay(25);
+            if (!(beeperConfig()->beeper_off_flags & BEEPER_GET_FLAG(BEEPER_SYSTEM_INIT))) {
+                BEEP_ON;
+            }
+            delay(25);
+            BEEP_OFF;
 #else
-        delay(50);
+            delay(50);
 #endif
+        }
     }
     LED0_OFF;
     LED1_OFF;
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_INDICATION);
+
     imuInit();
 
     failsafeInit();
@@ -791,6 +896,8 @@ void init(void)
     }
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_RX);
+
 #ifdef USE_FLASH_CHIP
     if (!(initFlags & FLASH_INIT_ATTEMPTED)) {
         flashInit(flashConfig());
@@ -798,7 +905,12 @@ void init(void)
     }
 #endif
 #ifdef USE_FLASHFS
-    flashfsInit();
+    // Finding the end of the logs scans the flash, blackbox and MSP see no flashfs until it is done
+    if (fastBoot) {
+        bootDeferInit(flashfsInit);
+    } else {
+        flashfsInit();
+    }
 #endif
 
 #ifdef USE_SDCARD
@@ -824,6 +936,8 @@ void init(void)
 #endif
     positionInit();
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_STORAGE);
+
 #if defined(USE_VTX_COMMON) || defined(USE_VTX_CONTROL)
     vtxTableInit();
 #endif
@@ -855,6 +969,8 @@ void init(void)
 
 #endif // VTX_CONTROL
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_VTX);
+
     batteryInit(); // always needs doing, regardless of features.
 
 #ifdef USE_RCDEVICE
@@ -869,6 +985,8 @@ void init(void)
     mspInit();
     mspSerialInit();
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_MSP);
+
 /*
  * CMS, display devices and OSD
  */
@@ -886,51 +1004,13 @@ void init(void)
     //The OSD need to be initialised after GYRO to avoid GYRO initialisation failure on some targets
 
     if (featureIsEnabled(FEATURE_OSD)) {
-        osdDisplayPortDevice_e device = osdConfig()->displayPortDevice;
-
-        switch(device) {
-
-        case OSD_DISPLAYPORT_DEVICE_AUTO:
-            FALLTHROUGH;
-
-#if defined(USE_FRSKYOSD)
-        // Test OSD_DISPLAYPORT_DEVICE_FRSKYOSD first, since an FC could
-        // have a builtin MAX7456 but also an FRSKYOSD connected to an
-        // uart.
-        case OSD_DISPLAYPORT_DEVICE_FRSKYOSD:
-            osdDisplayPort = frskyOsdDisplayPortInit(vcdProfile()->video_system);
-            if (osdDisplayPort || device == OSD_DISPLAYPORT_DEVICE_FRSKYOSD) {
-                osdDisplayPortDevice = OSD_DISPLAYPORT_DEVICE_FRSKYOSD;
-                break;
-            }
-            FALLTHROUGH;
-#endif
-
-#if defined(USE_MAX7456)
-        case OSD_DISPLAYPORT_DEVICE_MAX7456:
-            // If there is a max7456 chip for the OSD configured and detected then use it.
-            if (max7456DisplayPortInit(vcdProfile(), &osdDisplayPort) || device == OSD_DISPLAYPORT_DEVICE_MAX7456) {
-                osdDisplayPortDevice = OSD_DISPLAYPORT_DEVICE_MAX7456;
-                break;
-            }
-            FALLTHROUGH;
-#endif
-
-#if defined(USE_CMS) && defined(USE_MSP_DISPLAYPORT) && defined(USE_OSD_OVER_MSP_DISPLAYPORT)
-        case OSD_DISPLAYPORT_DEVICE_MSP:
-            osdDisplayPort = displayPortMspInit();
-            if (osdDisplayPort || device == OSD_DISPLAYPORT_DEVICE_MSP) {
-                osdDisplayPortDevice = OSD_DISPLAYPORT_DEVICE_MSP;
-                break;
-            }
-            FALLTHROUGH;
-#endif
-
-        // Other device cases can be added here
-
-        case OSD_DISPLAYPORT_DEVICE_NONE:
-        default:
-            break;
+        // Try the device found on the last boot first, the rest are searched if it has gone
+        const osdDisplayPortDevice_e hint = fastBoot && osdConfig()->displayPortDevice == OSD_DISPLAYPORT_DEVICE_AUTO ? bootConfig()->osdDisplayPortDevice : OSD_DISPLAYPORT_DEVICE_NONE;
+        if (hint != OSD_DISPLAYPORT_DEVICE_NONE) {
+            osdDisplayPortDevice = osdDisplayPortSearch(hint, hint, &osdDisplayPort);
+        }
+        if (osdDisplayPortDevice == OSD_DISPLAYPORT_DEVICE_NONE) {
+            osdDisplayPortDevice = osdDisplayPortSearch(osdConfig()->displayPortDevice, hint, &osdDisplayPort);
         }
 
         // osdInit will register with CMS by itself.
@@ -939,6 +1019,11 @@ void init(void)
         if (osdDisplayPortDevice == OSD_DISPLAYPORT_DEVICE_NONE) {
             featureDisableImmediate(FEATURE_OSD);
         }
+
+        // A device which is missing on this boot, e.g. one powered from the battery only, keeps its hint
+        if (osdConfig()->displayPortDevice == OSD_DISPLAYPORT_DEVICE_AUTO && osdDisplayPort) {
+            bootConfigMutable()->osdDisplayPortDevice = osdDisplayPortDevice;
+        }
     }
 #endif // USE_OSD
 
@@ -962,6 +1047,8 @@ void init(void)
     }
 #endif
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_OSD);
+
 #ifdef USE_TELEMETRY
     // Telemetry will initialise displayport and register with CMS by itself.
     if (featureIsEnabled(FEATURE_TELEMETRY)) {
@@ -994,5 +1081,10 @@ void init(void)
 
     tasksInit();
 
+    BOOT_PROFILE_MARK(BOOT_PHASE_TASKS);
+    if (!bootHasDeferredInit()) {
+        BOOT_PROFILE_MARK(BOOT_PHASE_DEFERRED);
+    }
+
     systemState |= SYSTEM_STATE_READY;
 }
@@ -41,6 +41,7 @@
 #define PARAM_NAME_RC_SMOOTHING_FEEDFORWARD_CUTOFF "rc_smoothing_feedforward_cutoff"
 #define PARAM_NAME_RC_SMOOTHING_THROTTLE_CUTOFF "rc_smoothing_throttle_cutoff"
 #define PARAM_NAME_RC_SMOOTHING_DEBUG_AXIS "rc_smoothing_debug_axis"
+#define PARAM_NAME_RC_SMOOTHING_PREDICT "rc_smoothing_predict"
 #define PARAM_NAME_RC_SMOOTHING_ACTIVE_CUTOFFS "rc_smoothing_active_cutoffs_ff_sp_thr"
 #define PARAM_NAME_SERIAL_RX_PROVIDER "serialrx_provider"
 #define PARAM_NAME_DSHOT_IDLE_VALUE "dshot_idle_value"
@@ -122,7 +123,8 @@
 #define PARAM_NAME_RPM_FILTER_LPF_HZ "rpm_filter_lpf_hz"
 #define PARAM_NAME_POSITION_ALTITUDE_SOURCE "altitude_source"
 #define PARAM_NAME_POSITION_ALTITUDE_PREFER_BARO "altitude_prefer_baro"
-#define PARAM_NAME_POSITION_ALTITUDE_LPF "altitude_lpf"
+#define PARAM_NAME_POSITION_ALTITUDE_BARO_NOISE "altitude_baro_noise"
+#define PARAM_NAME_POSITION_ALTITUDE_ACC_NOISE "altitude_acc_noise"
 #define PARAM_NAME_POSITION_ALTITUDE_D_LPF "altitude_d_lpf"
 #define PARAM_NAME_ANGLE_FEEDFORWARD "angle_feedforward"
 #define PARAM_NAME_ANGLE_FF_SMOOTHING_MS "angle_feedforward_smoothing_ms"
@@ -281,6 +281,11 @@ uint16_t getCurrentRxIntervalUs(void)
     return currentRxIntervalUs;
 }
 
+bool getRxRateValid(void)
+{
+    return isRxIntervalValid;
+}
+
 #ifdef USE_RC_SMOOTHING_FILTER
 
 // Initialize or update the filters base on either the manually selected cutoff, or
@@ -381,6 +386,11 @@ static FAST_CODE void processRcSmoothingFilter(void)
         rcSmoothingData.throttleCutoffSetting = rxConfig()->rc_smoothing_throttle_cutoff;
         rcSmoothingData.feedforwardCutoffSetting = rxConfig()->rc_smoothing_feedforward_cutoff;
 
+        rcSmoothingData.predictSetpoint = rxConfig()->rc_smoothing_predict > 0;
+        for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+            framePredictorInit(&rcSmoothingData.setpointPredictor[axis], rxConfig()->rc_smoothing_predict / 100.0f);
+        }
+
         rcSmoothingData.setpointCutoffFrequency = rcSmoothingData.setpointCutoffSetting;
         rcSmoothingData.feedforwardCutoffFrequency = rcSmoothingData.feedforwardCutoffSetting;
         rcSmoothingData.throttleCutoffFrequency = rcSmoothingData.throttleCutoffSetting;
@@ -442,6 +452,14 @@ static FAST_CODE void processRcSmoothingFilter(void)
             DEBUG_SET(DEBUG_RC_SMOOTHING_RATE, 2, rcSmoothingData.smoothedRxRateHz); // value used by filters
             DEBUG_SET(DEBUG_RC_SMOOTHING_RATE, 3, sampleState); // guard time = 1, guard time expired = 2
         }
+        if (rcSmoothingData.predictSetpoint) {
+            // continue the setpoint change over the PID loops expected before the next frame, unless the frame interval is unreliable
+            const uint16_t loopsPerFrame = (isRxIntervalValid && targetPidLooptime) ? currentRxIntervalUs / targetPidLooptime : 0;
+            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+                framePredictorNewFrame(&rcSmoothingData.setpointPredictor[axis], rawSetpoint[axis], loopsPerFrame);
+            }
+        }
+
         // Get new values to be smoothed
         for (int i = 0; i < PRIMARY_CHANNEL_COUNT; i++) {
             rxDataToSmooth[i] = i == THROTTLE ? rcCommand[i] : rawSetpoint[i];
@@ -456,6 +474,14 @@ static FAST_CODE void processRcSmoothingFilter(void)
     DEBUG_SET(DEBUG_RC_SMOOTHING, 0, rcSmoothingData.smoothedRxRateHz);
     DEBUG_SET(DEBUG_RC_SMOOTHING, 3, rcSmoothingData.sampleCount);
 
+    if (rcSmoothingData.predictSetpoint) {
+        for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+            // a prediction continuing a ramp into the rate limit must not overshoot it
+            const float rateLimit = currentControlRateProfile->rate_limit[axis];
+            rxDataToSmooth[axis] = constrainf(framePredictorApply(&rcSmoothingData.setpointPredictor[axis]), -rateLimit, rateLimit);
+        }
+    }
+
     // each pid loop, apply the last received channel value to the filter, if initialised - thanks @klutvott
     for (int i = 0; i < PRIMARY_CHANNEL_COUNT; i++) {
         float *dst = i == THROTTLE ? &rcCommand[i] : &setpointRate[i];
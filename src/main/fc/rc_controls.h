@@ -89,6 +89,8 @@ typedef struct rcSmoothingFilter_s {
     pt3Filter_t filterSetpoint[4];
     pt3Filter_t filterRcDeflection[2];
     pt3Filter_t filterFeedforward[3];
+    framePredictor_t setpointPredictor[3];
+    bool predictSetpoint;
 
     uint8_t setpointCutoffSetting;
     uint8_t throttleCutoffSetting;
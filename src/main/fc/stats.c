@@ -75,7 +75,7 @@ void writeStats(struct dispatchEntry_s* self)
 
 dispatchEntry_t writeStatsEntry =
 {
-    writeStats, 0, NULL, false
+    .dispatch = writeStats,
 };
 
 
@@ -215,7 +215,7 @@ static void rescueAttainPosition(void)
     static float previousVelocityError = 0.0f;
     static float velocityI = 0.0f;
     static float throttleI = 0.0f;
-    static float previousAltitudeError = 0.0f;
+    static float previousTargetAltitudeCm = 0.0f;
     static int16_t throttleAdjustment = 0;
 
     switch (rescueState.phase) {
@@ -230,7 +230,7 @@ static void rescueAttainPosition(void)
         previousVelocityError = 0.0f;
         velocityI = 0.0f;
         throttleI = 0.0f;
-        previousAltitudeError = 0.0f;
+        previousTargetAltitudeCm = rescueState.sensor.currentAltitudeCm;
         throttleAdjustment = 0;
         rescueState.intent.disarmThreshold = gpsRescueConfig()->disarmThreshold * 0.1f;
         rescueState.sensor.imuYawCogGain = 1.0f;
@@ -262,8 +262,10 @@ static void rescueAttainPosition(void)
     // up to 20% increase in throttle from I alone
 
     // D component is error based, so includes positive boost when climbing and negative boost on descent
-    float throttleD = ((altitudeError - previousAltitudeError) / rescueState.sensor.altitudeDataIntervalSeconds);
-    previousAltitudeError = altitudeError;
+    // the measured climb rate comes from the vertical estimator rather than differencing altitude samples
+    const float targetAltitudeRate = (rescueState.intent.targetAltitudeCm - previousTargetAltitudeCm) / 100.0f / rescueState.sensor.altitudeDataIntervalSeconds;
+    previousTargetAltitudeCm = rescueState.intent.targetAltitudeCm;
+    float throttleD = targetAltitudeRate - getAltitudeDerivative() / 100.0f;
     // increase by up to 2x when descent rate is faster
     throttleD *= rescueState.intent.throttleDMultiplier;
     // apply user's throttle D gain
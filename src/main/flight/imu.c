@@ -101,6 +101,10 @@ static imuRuntimeConfig_t imuRuntimeConfig;
 
 float rMat[3][3];
 
+// Set when the quaternion has been propagated since rMat and the Euler angles were last computed from it
+static bool rMatStale = false;
+static bool eulerStale = false;
+
 #if defined(USE_ACC)
 STATIC_UNIT_TESTED bool attitudeIsEstablished = false;
 #endif
@@ -115,13 +119,14 @@ quaternion offset = QUATERNION_INITIALIZE;
 // absolute angle inclination in multiple of 0.1 degree    180 deg = 1800
 attitudeEulerAngles_t attitude = EULER_INITIALIZE;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 2);
+PG_REGISTER_WITH_RESET_TEMPLATE(imuConfig_t, imuConfig, PG_IMU_CONFIG, 3);
 
 PG_RESET_TEMPLATE(imuConfig_t, imuConfig,
     .dcm_kp = 2500,                // 1.0 * 10000
     .dcm_ki = 0,                   // 0.003 * 10000
     .small_angle = 25,
-    .imu_process_denom = 2
+    .imu_process_denom = 2,
+    .imu_propagate_denom = 0,
 );
 
 static void imuQuaternionComputeProducts(quaternion *quat, quaternionProducts *quatProd)
@@ -158,6 +163,8 @@ STATIC_UNIT_TESTED void imuComputeRotationMatrix(void)
     rMat[1][0] = -2.0f * (qP.xy - -qP.wz);
     rMat[2][0] = -2.0f * (qP.xz + -qP.wy);
 #endif
+
+    rMatStale = false;
 }
 
 static float calculateThrottleAngleScale(uint16_t throttle_correction_angle)
@@ -169,6 +176,7 @@ void imuConfigure(uint16_t throttle_correction_angle, uint8_t throttle_correctio
 {
     imuRuntimeConfig.dcm_kp = imuConfig()->dcm_kp / 10000.0f;
     imuRuntimeConfig.dcm_ki = imuConfig()->dcm_ki / 10000.0f;
+    imuRuntimeConfig.propagate_denom = imuConfig()->imu_propagate_denom;
 
     smallAngleCosZ = cos_approx(degreesToRadians(imuConfig()->small_angle));
 
@@ -200,6 +208,32 @@ static float invSqrt(float x)
     return 1.0f / sqrtf(x);
 }
 
+// Rotate q by the body rates (rad/s) over dt and renormalise
+static void imuIntegrateQuaternion(float gx, float gy, float gz, float dt)
+{
+    gx *= (0.5f * dt);
+    gy *= (0.5f * dt);
+    gz *= (0.5f * dt);
+
+    quaternion buffer;
+    buffer.w = q.w;
+    buffer.x = q.x;
+    buffer.y = q.y;
+    buffer.z = q.z;
+
+    q.w += (-buffer.x * gx - buffer.y * gy - buffer.z * gz);
+    q.x += (+buffer.w * gx + buffer.y * gz - buffer.z * gy);
+    q.y += (+buffer.w * gy - buffer.x * gz + buffer.z * gx);
+    q.z += (+buffer.w * gz + buffer.x * gy - buffer.y * gx);
+
+    // Normalise quaternion
+    float recipNorm = invSqrt(sq(q.w) + sq(q.x) + sq(q.y) + sq(q.z));
+    q.w *= recipNorm;
+    q.x *= recipNorm;
+    q.y *= recipNorm;
+    q.z *= recipNorm;
+}
+
 STATIC_UNIT_TESTED void imuMahonyAHRSupdate(float dt, float gx, float gy, float gz,
                                 bool useAcc, float ax, float ay, float az,
                                 bool useMag,
@@ -210,6 +244,11 @@ STATIC_UNIT_TESTED void imuMahonyAHRSupdate(float dt, float gx, float gy, float
     // Calculate general spin rate (rad/s)
     const float spin_rate = sqrtf(sq(gx) + sq(gy) + sq(gz));
 
+    // The corrections below are computed against the attitude propagated up to now
+    if (rMatStale) {
+        imuComputeRotationMatrix();
+    }
+
     // Use raw heading error (from GPS or whatever else)
     float ex = 0, ey = 0, ez = 0;
     if (cogYawGain != 0.0f) {
@@ -311,33 +350,20 @@ STATIC_UNIT_TESTED void imuMahonyAHRSupdate(float dt, float gx, float gy, float
         integralFBz = 0.0f;
     }
 
+    // When the gyro is propagated in the PID loop only the feedback remains to be integrated here
+    if (imuRuntimeConfig.propagate_denom) {
+        gx = 0.0f;
+        gy = 0.0f;
+        gz = 0.0f;
+    }
+
     // Apply proportional and integral feedback
     gx += dcmKpGain * ex + integralFBx;
     gy += dcmKpGain * ey + integralFBy;
     gz += dcmKpGain * ez + integralFBz;
 
     // Integrate rate of change of quaternion
-    gx *= (0.5f * dt);
-    gy *= (0.5f * dt);
-    gz *= (0.5f * dt);
-
-    quaternion buffer;
-    buffer.w = q.w;
-    buffer.x = q.x;
-    buffer.y = q.y;
-    buffer.z = q.z;
-
-    q.w += (-buffer.x * gx - buffer.y * gy - buffer.z * gz);
-    q.x += (+buffer.w * gx + buffer.y * gz - buffer.z * gy);
-    q.y += (+buffer.w * gy - buffer.x * gz + buffer.z * gx);
-    q.z += (+buffer.w * gz + buffer.x * gy - buffer.y * gx);
-
-    // Normalise quaternion
-    float recipNorm = invSqrt(sq(q.w) + sq(q.x) + sq(q.y) + sq(q.z));
-    q.w *= recipNorm;
-    q.x *= recipNorm;
-    q.y *= recipNorm;
-    q.z *= recipNorm;
+    imuIntegrateQuaternion(gx, gy, gz, dt);
 
     // Pre-compute rotation matrix from quaternion
     imuComputeRotationMatrix();
@@ -364,6 +390,8 @@ STATIC_UNIT_TESTED void imuUpdateEulerAngles(void)
     if (attitude.values.yaw < 0) {
         attitude.values.yaw += 3600;
     }
+
+    eulerStale = false;
 }
 
 static bool imuIsAccelerometerHealthy(float *accAverage)
@@ -457,14 +485,22 @@ static void imuComputeQuaternionFromRPY(quaternionProducts *quatProd, int16_t in
         initialYaw -= 3600;
     }
 
-    const float cosRoll = cos_approx(DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f);
-    const float sinRoll = sin_approx(DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f);
+    const float halfAngles[3] = {
+        DECIDEGREES_TO_RADIANS(initialRoll) * 0.5f,
+        DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f,
+        DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f,
+    };
+    float sinHalf[3], cosHalf[3];
+    sin_cos_approx3(halfAngles, sinHalf, cosHalf);
+
+    const float cosRoll = cosHalf[0];
+    const float sinRoll = sinHalf[0];
 
-    const float cosPitch = cos_approx(DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f);
-    const float sinPitch = sin_approx(DECIDEGREES_TO_RADIANS(initialPitch) * 0.5f);
+    const float cosPitch = cosHalf[1];
+    const float sinPitch = sinHalf[1];
 
-    const float cosYaw = cos_approx(DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f);
-    const float sinYaw = sin_approx(DECIDEGREES_TO_RADIANS(-initialYaw) * 0.5f);
+    const float cosYaw = cosHalf[2];
+    const float sinYaw = sinHalf[2];
 
     const float q0 = cosRoll * cosPitch * cosYaw + sinRoll * sinPitch * sinYaw;
     const float q1 = sinRoll * cosPitch * cosYaw - cosRoll * sinPitch * sinYaw;
@@ -605,6 +641,67 @@ void imuUpdateAttitude(timeUs_t currentTimeUs)
     DEBUG_SET(DEBUG_ATTITUDE, X, acc.accADC[X]); // roll
     DEBUG_SET(DEBUG_ATTITUDE, Y, acc.accADC[Y]); // pitch
 }
+
+/*
+ * Gyro only attitude propagation, called from the PID loop so that self leveling works from an attitude at most
+ * imu_propagate_denom PID loops old instead of up to a full attitude task period. The accelerometer, magnetometer
+ * and course over ground corrections are still applied at the attitude task rate by imuMahonyAHRSupdate().
+ *
+ * Only the quaternion is updated here, rMat and the Euler angles are recomputed on demand by imuRefreshAttitude().
+ */
+void imuPropagateAttitude(float dT)
+{
+#if defined(SIMULATOR_BUILD) && !defined(USE_IMU_CALC)
+    // The simulator supplies the attitude directly
+    UNUSED(dT);
+#else
+    static uint8_t loopCount = 0;
+    static float gyroSum[XYZ_AXIS_COUNT];
+
+    // Wait for the first correction so that there is an attitude to propagate
+    if (!imuRuntimeConfig.propagate_denom || !attitudeIsEstablished) {
+        loopCount = 0;
+        gyroSum[X] = gyroSum[Y] = gyroSum[Z] = 0.0f;
+        return;
+    }
+
+    // Integrate the average rate over the skipped loops rather than extrapolating the latest sample
+    gyroSum[X] += gyro.gyroADCf[X];
+    gyroSum[Y] += gyro.gyroADCf[Y];
+    gyroSum[Z] += gyro.gyroADCf[Z];
+
+    if (++loopCount < imuRuntimeConfig.propagate_denom) {
+        return;
+    }
+
+    IMU_LOCK;
+    imuIntegrateQuaternion(DEGREES_TO_RADIANS(gyroSum[X]), DEGREES_TO_RADIANS(gyroSum[Y]), DEGREES_TO_RADIANS(gyroSum[Z]), dT);
+    rMatStale = true;
+    eulerStale = true;
+    IMU_UNLOCK;
+
+    loopCount = 0;
+    gyroSum[X] = gyroSum[Y] = gyroSum[Z] = 0.0f;
+#endif
+}
+
+/*
+ * Bring rMat and the Euler angles up to date with the propagated quaternion. Consumers which don't call this see
+ * the values computed by the attitude task.
+ */
+void imuRefreshAttitude(void)
+{
+    if (!eulerStale) {
+        return;
+    }
+
+    IMU_LOCK;
+    if (rMatStale) {
+        imuComputeRotationMatrix();
+    }
+    imuUpdateEulerAngles();
+    IMU_UNLOCK;
+}
 #endif // USE_ACC
 
 bool shouldInitializeGPSHeading(void)
@@ -622,7 +719,8 @@ bool shouldInitializeGPSHeading(void)
 
 float getCosTiltAngle(void)
 {
-    return rMat[2][2];
+    // rMat[2][2] computed directly from the quaternion, which may have been propagated since rMat was last updated
+    return 1.0f - 2.0f * (sq(q.x) + sq(q.y));
 }
 
 void getQuaternion(quaternion *quat)
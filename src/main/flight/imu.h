@@ -57,6 +57,7 @@ typedef struct imuConfig_s {
     uint16_t dcm_ki;                        // DCM filter integral gain ( x 10000)
     uint8_t small_angle;
     uint8_t imu_process_denom;
+    uint8_t imu_propagate_denom;            // gyro only attitude propagation every N PID loops, 0 = integrate gyro in the attitude task only
 } imuConfig_t;
 
 PG_DECLARE(imuConfig_t, imuConfig);
@@ -64,6 +65,7 @@ PG_DECLARE(imuConfig_t, imuConfig);
 typedef struct imuRuntimeConfig_s {
     float dcm_ki;
     float dcm_kp;
+    uint8_t propagate_denom;
 } imuRuntimeConfig_t;
 
 void imuConfigure(uint16_t throttle_correction_angle, uint8_t throttle_correction_value);
@@ -71,6 +73,8 @@ void imuConfigure(uint16_t throttle_correction_angle, uint8_t throttle_correctio
 float getCosTiltAngle(void);
 void getQuaternion(quaternion * q);
 void imuUpdateAttitude(timeUs_t currentTimeUs);
+void imuPropagateAttitude(float dT);
+void imuRefreshAttitude(void);
 
 void imuInit(void);
 
@@ -82,6 +82,11 @@ void writeMotors(void)
     motorWriteAll(motor);
 }
 
+void writeMotorsAtPhase(timeUs_t outputAtUs)
+{
+    motorWriteAllAtPhase(motor, outputAtUs);
+}
+
 static void writeAllMotors(int16_t mc)
 {
     // Sends commands to all motors
@@ -385,40 +390,50 @@ static void applyRpmLimiter(mixerRuntime_t *mixer)
 }
 #endif // USE_RPM_LIMIT
 
-static void applyMixToMotors(float motorMix[MAX_SUPPORTED_MOTORS], motorMixer_t *activeMixer)
+static void applyMixToMotors(const float motorMix[MAX_SUPPORTED_MOTORS], const float motorMixScale, const mixerMatrix_t *matrix)
 {
+    // Disarmed mode
+    if (!ARMING_FLAG(ARMED)) {
+        for (int i = 0; i < mixerRuntime.motorCount; i++) {
+            motor[i] = motor_disarmed[i];
+        }
+        return;
+    }
+
+    // Resolve the output limits once, outputs below outputCutoff are replaced by outputLow before the final clamp
+    const bool failsafeActive = failsafeIsActive();
+    const float outputLow = failsafeActive ? mixerRuntime.disarmMotorOutput : motorRangeMin;
+    float outputCutoff = outputLow;
+#ifdef USE_DSHOT
+    if (failsafeActive && isMotorProtocolDshot()) {
+        outputCutoff = motorRangeMin; // Prevent getting into special reserved range
+    }
+#endif
+#ifdef USE_THRUST_LINEARIZATION
+    const float thrustLinearization = pidGetThrustLinearization();
+#endif
+
     // Now add in the desired throttle, but keep in a range that doesn't clip adjusted
     // roll/pitch/yaw. This could move throttle down, but also up for those low throttle flips.
     for (int i = 0; i < mixerRuntime.motorCount; i++) {
-        float motorOutput = motorOutputMixSign * motorMix[i] + throttle * activeMixer[i].throttle;
+        float motorOutput = motorMixScale * motorMix[i] + throttle * matrix->throttle[i];
 #ifdef USE_THRUST_LINEARIZATION
-        motorOutput = pidApplyThrustLinearization(motorOutput);
+        motorOutput *= 1.0f + thrustLinearization * sq(1.0f - motorOutput);
 #endif
-        motorOutput = motorOutputMin + motorOutputRange * motorOutput;
+        motor[i] = motorOutputMin + motorOutputRange * motorOutput;
+    }
 
 #ifdef USE_SERVOS
-        if (mixerIsTricopter()) {
-            motorOutput += mixerTricopterMotorCorrection(i);
-        }
-#endif
-        if (failsafeIsActive()) {
-#ifdef USE_DSHOT
-            if (isMotorProtocolDshot()) {
-                motorOutput = (motorOutput < motorRangeMin) ? mixerRuntime.disarmMotorOutput : motorOutput; // Prevent getting into special reserved range
-            }
-#endif
-            motorOutput = constrainf(motorOutput, mixerRuntime.disarmMotorOutput, motorRangeMax);
-        } else {
-            motorOutput = constrainf(motorOutput, motorRangeMin, motorRangeMax);
+    if (mixerIsTricopter()) {
+        for (int i = 0; i < mixerRuntime.motorCount; i++) {
+            motor[i] += mixerTricopterMotorCorrection(i);
         }
-        motor[i] = motorOutput;
     }
+#endif
 
-    // Disarmed mode
-    if (!ARMING_FLAG(ARMED)) {
-        for (int i = 0; i < mixerRuntime.motorCount; i++) {
-            motor[i] = motor_disarmed[i];
-        }
+    for (int i = 0; i < mixerRuntime.motorCount; i++) {
+        const float motorOutput = (motor[i] < outputCutoff) ? outputLow : motor[i];
+        motor[i] = constrainf(motorOutput, outputLow, motorRangeMax);
     }
 }
 
@@ -464,7 +479,8 @@ static void updateDynLpfCutoffs(timeUs_t currentTimeUs, float throttle)
 }
 #endif
 
-static void applyMixerAdjustmentLinear(float *motorMix, const bool airmodeEnabled)
+// Both mixer adjustments constrain throttle so no output clips and return the scale to apply to motorMix
+static float applyMixerAdjustmentLinear(float *motorMix, const bool airmodeEnabled)
 {
     float airmodeTransitionPercent = 1.0f;
     float motorDeltaScale = 0.5f;
@@ -479,27 +495,33 @@ static void applyMixerAdjustmentLinear(float *motorMix, const bool airmodeEnable
     const float motorMixNormalizationFactor = motorMixRange > 1.0f ? airmodeTransitionPercent / motorMixRange : airmodeTransitionPercent;
 
     const float motorMixDelta = motorDeltaScale * motorMixRange;
+    // each output moves from mix + offset at zero throttle to mix - offset at full throttle
+    const float throttleSpread = 1.0f - 2.0f * throttle;
 
     float minMotor = FLT_MAX;
     float maxMotor = FLT_MIN;
 
-    for (int i = 0; i < mixerRuntime.motorCount; ++i) {
-        if (mixerConfig()->mixer_type == MIXER_LINEAR) {
-            motorMix[i] = scaleRangef(throttle, 0.0f, 1.0f, motorMix[i] + motorMixDelta, motorMix[i] - motorMixDelta);
-        } else {
-            motorMix[i] = scaleRangef(throttle, 0.0f, 1.0f, motorMix[i] + fabsf(motorMix[i]), motorMix[i] - fabsf(motorMix[i]));
+    if (mixerConfig()->mixer_type == MIXER_LINEAR) {
+        for (int i = 0; i < mixerRuntime.motorCount; ++i) {
+            motorMix[i] += motorMixDelta * throttleSpread;
+            maxMotor = MAX(motorMix[i], maxMotor);
+            minMotor = MIN(motorMix[i], minMotor);
+        }
+    } else {
+        for (int i = 0; i < mixerRuntime.motorCount; ++i) {
+            motorMix[i] += fabsf(motorMix[i]) * throttleSpread;
+            maxMotor = MAX(motorMix[i], maxMotor);
+            minMotor = MIN(motorMix[i], minMotor);
         }
-        motorMix[i] *= motorMixNormalizationFactor;
-
-        maxMotor = MAX(motorMix[i], maxMotor);
-        minMotor = MIN(motorMix[i], minMotor);
     }
 
     // constrain throttle so it won't clip any outputs
-    throttle = constrainf(throttle, -minMotor, 1.0f - maxMotor);
+    throttle = constrainf(throttle, -minMotor * motorMixNormalizationFactor, 1.0f - maxMotor * motorMixNormalizationFactor);
+
+    return motorMixNormalizationFactor;
 }
 
-static void applyMixerAdjustment(float *motorMix, const float motorMixMin, const float motorMixMax, const bool airmodeEnabled)
+static float applyMixerAdjustment(const float motorMixMin, const float motorMixMax, const bool airmodeEnabled)
 {
 #ifdef USE_AIRMODE_LPF
     const float unadjustedThrottle = throttle;
@@ -516,10 +538,6 @@ static void applyMixerAdjustment(float *motorMix, const float motorMixMin, const
 
     const float motorMixNormalizationFactor = motorMixRange > 1.0f ? airmodeTransitionPercent / motorMixRange : airmodeTransitionPercent;
 
-    for (int i = 0; i < mixerRuntime.motorCount; i++) {
-        motorMix[i] *= motorMixNormalizationFactor;
-    }
-
     const float normalizedMotorMixMin = motorMixMin * motorMixNormalizationFactor;
     const float normalizedMotorMixMax = motorMixMax * motorMixNormalizationFactor;
     throttle = constrainf(throttle, -normalizedMotorMixMin, 1.0f - normalizedMotorMixMax);
@@ -528,6 +546,8 @@ static void applyMixerAdjustment(float *motorMix, const float motorMixMin, const
     airmodeThrottleChange = constrainf(unadjustedThrottle, -normalizedMotorMixMin, 1.0f - normalizedMotorMixMax) - unadjustedThrottle;
     pidUpdateAirmodeLpf(airmodeThrottleChange);
 #endif
+
+    return motorMixNormalizationFactor;
 }
 
 FAST_CODE_NOINLINE void mixTable(timeUs_t currentTimeUs)
@@ -542,10 +562,10 @@ FAST_CODE_NOINLINE void mixTable(timeUs_t currentTimeUs)
 
     const bool launchControlActive = isLaunchControlActive();
 
-    motorMixer_t * activeMixer = &mixerRuntime.currentMixer[0];
+    const mixerMatrix_t *activeMatrix = &mixerRuntime.mixerMatrix;
 #ifdef USE_LAUNCH_CONTROL
     if (launchControlActive && (currentPidProfile->launchControlMode == LAUNCH_CONTROL_MODE_PITCHONLY)) {
-        activeMixer = &mixerRuntime.launchControlMixer[0];
+        activeMatrix = &mixerRuntime.launchControlMatrix;
     }
 #endif
 
@@ -621,16 +641,13 @@ FAST_CODE_NOINLINE void mixTable(timeUs_t currentTimeUs)
     float motorMix[MAX_SUPPORTED_MOTORS];
     float motorMixMax = 0, motorMixMin = 0;
     for (int i = 0; i < mixerRuntime.motorCount; i++) {
-        float mix =
-            scaledAxisPidRoll  * activeMixer[i].roll +
-            scaledAxisPidPitch * activeMixer[i].pitch +
-            scaledAxisPidYaw   * activeMixer[i].yaw;
-
-        if (mix > motorMixMax) {
-            motorMixMax = mix;
-        } else if (mix < motorMixMin) {
-            motorMixMin = mix;
-        }
+        const float mix =
+            scaledAxisPidRoll  * activeMatrix->roll[i] +
+            scaledAxisPidPitch * activeMatrix->pitch[i] +
+            scaledAxisPidYaw   * activeMatrix->yaw[i];
+
+        motorMixMax = MAX(mix, motorMixMax);
+        motorMixMin = MIN(mix, motorMixMin);
         motorMix[i] = mix;
     }
 
@@ -662,10 +679,11 @@ FAST_CODE_NOINLINE void mixTable(timeUs_t currentTimeUs)
 #endif
 
     motorMixRange = motorMixMax - motorMixMin;
+    float motorMixScale;
     if (mixerConfig()->mixer_type > MIXER_LEGACY) {
-        applyMixerAdjustmentLinear(motorMix, airmodeEnabled);
+        motorMixScale = applyMixerAdjustmentLinear(motorMix, airmodeEnabled);
     } else {
-        applyMixerAdjustment(motorMix, motorMixMin, motorMixMax, airmodeEnabled);
+        motorMixScale = applyMixerAdjustment(motorMixMin, motorMixMax, airmodeEnabled);
     }
 
     if (featureIsEnabled(FEATURE_MOTOR_STOP)
@@ -678,7 +696,7 @@ FAST_CODE_NOINLINE void mixTable(timeUs_t currentTimeUs)
         applyMotorStop();
     } else {
         // Apply the mix to motor endpoints
-        applyMixToMotors(motorMix, activeMixer);
+        applyMixToMotors(motorMix, motorOutputMixSign * motorMixScale, activeMatrix);
     }
 }
 
@@ -134,6 +134,7 @@ void mixerResetDisarmedMotors(void);
 void mixTable(timeUs_t currentTimeUs);
 void stopMotors(void);
 void writeMotors(void);
+void writeMotorsAtPhase(timeUs_t outputAtUs);
 
 bool mixerIsTricopter(void);
 
@@ -374,6 +374,16 @@ void mixerResetRpmLimiter(void)
 }
 #endif // USE_RPM_LIMIT
 
+static void mixerCompileMatrix(mixerMatrix_t *matrix, const motorMixer_t *mixer)
+{
+    for (int i = 0; i < MAX_SUPPORTED_MOTORS; i++) {
+        matrix->roll[i] = mixer[i].roll;
+        matrix->pitch[i] = mixer[i].pitch;
+        matrix->yaw[i] = mixer[i].yaw;
+        matrix->throttle[i] = mixer[i].throttle;
+    }
+}
+
 #ifdef USE_LAUNCH_CONTROL
 // Create a custom mixer for launch control based on the current settings
 // but disable the front motors. We don't care about roll or yaw because they
@@ -388,6 +398,7 @@ void loadLaunchControlMixer(void)
             mixerRuntime.launchControlMixer[i].throttle = 0.0f;
         }
     }
+    mixerCompileMatrix(&mixerRuntime.launchControlMatrix, mixerRuntime.launchControlMixer);
 }
 #endif
 
@@ -418,6 +429,7 @@ static void mixerConfigureOutput(void)
                 mixerRuntime.currentMixer[i] = mixers[currentMixerMode].motor[i];
         }
     }
+    mixerCompileMatrix(&mixerRuntime.mixerMatrix, mixerRuntime.currentMixer);
 #ifdef USE_LAUNCH_CONTROL
     loadLaunchControlMixer();
 #endif
@@ -446,6 +458,7 @@ static void mixerConfigureOutput(void)
     for (int i = 0; i < mixerRuntime.motorCount; i++) {
         mixerRuntime.currentMixer[i] = mixerQuadX[i];
     }
+    mixerCompileMatrix(&mixerRuntime.mixerMatrix, mixerRuntime.currentMixer);
 #ifdef USE_LAUNCH_CONTROL
     loadLaunchControlMixer();
 #endif
@@ -24,11 +24,21 @@
 
 #include "flight/mixer.h"
 
+// Mixer compiled into one column per input, so the mixing loops read each column contiguously
+typedef struct mixerMatrix_s {
+    float roll[MAX_SUPPORTED_MOTORS];
+    float pitch[MAX_SUPPORTED_MOTORS];
+    float yaw[MAX_SUPPORTED_MOTORS];
+    float throttle[MAX_SUPPORTED_MOTORS];
+} mixerMatrix_t;
+
 typedef struct mixerRuntime_s {
     uint8_t motorCount;
     motorMixer_t currentMixer[MAX_SUPPORTED_MOTORS];
+    mixerMatrix_t mixerMatrix;
 #ifdef USE_LAUNCH_CONTROL
     motorMixer_t launchControlMixer[MAX_SUPPORTED_MOTORS];
+    mixerMatrix_t launchControlMatrix;
 #endif
     bool feature3dEnabled;
     float motorOutputLow;
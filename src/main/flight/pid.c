@@ -322,10 +322,10 @@ float pidCompensateThrustLinearization(float throttle)
     return throttle;
 }
 
-float pidApplyThrustLinearization(float motorOutput)
+// The mixer applies motorOutput * (1 + thrustLinearization * (1 - motorOutput)^2) to each motor
+float pidGetThrustLinearization(void)
 {
-    motorOutput *= 1.0f + pidRuntime.thrustLinearization * sq(1.0f - motorOutput);
-    return motorOutput;
+    return pidRuntime.thrustLinearization;
 }
 #endif
 
@@ -383,8 +383,8 @@ STATIC_UNIT_TESTED FAST_CODE_NOINLINE float pidLevel(int axis, const pidProfile_
 
     // minimise cross-axis wobble due to faster yaw responses than roll or pitch, and make co-ordinated yaw turns
     // by compensating for the effect of yaw on roll while pitched, and on pitch while rolled
-    // earthRef code here takes about 76 cycles, if conditional on angleEarthRef it takes about 100.  sin_approx costs most of those cycles.
-    float sinAngle = sin_approx(DEGREES_TO_RADIANS(pidRuntime.angleTarget[axis == FD_ROLL ? FD_PITCH : FD_ROLL]));
+    // the sine is most of the cost of this earthRef code, the fast tier is ample for a gain on the yaw setpoint
+    float sinAngle = sin_approx_fast(DEGREES_TO_RADIANS(pidRuntime.angleTarget[axis == FD_ROLL ? FD_PITCH : FD_ROLL]));
     sinAngle *= (axis == FD_ROLL) ? -1.0f : 1.0f; // must be negative for Roll
     const float earthRefGain = FLIGHT_MODE(GPS_RESCUE_MODE) ? 1.0f : pidRuntime.angleEarthRef;
     angleRate += pidRuntime.angleYawSetpoint * sinAngle * earthRefGain;
@@ -778,11 +778,7 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
     static float previousGyroRateDterm[XYZ_AXIS_COUNT];
     static float previousRawGyroRateDterm[XYZ_AXIS_COUNT];
 
-#ifdef USE_TPA_MODE
-    const float tpaFactorKp = (pidProfile->tpa_mode == TPA_MODE_PD) ? pidRuntime.tpaFactor : 1.0f;
-#else
-    const float tpaFactorKp = pidRuntime.tpaFactor;
-#endif
+    const float tpaFactorKp = pidRuntime.tpaAppliesToP ? pidRuntime.tpaFactor : 1.0f;
 
 #ifdef USE_YAW_SPIN_RECOVERY
     const bool yawSpinActive = gyroYawSpinDetected();
@@ -798,7 +794,14 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
 
     const bool gpsRescueIsActive = FLIGHT_MODE(GPS_RESCUE_MODE);
     levelMode_e levelMode;
+
+    // Advance the attitude estimate with this loop's gyro data
+    imuPropagateAttitude(pidRuntime.dT);
+
     if (FLIGHT_MODE(ANGLE_MODE) || FLIGHT_MODE(HORIZON_MODE) || gpsRescueIsActive) {
+        // Self leveling works from the propagated attitude rather than the last attitude task update
+        imuRefreshAttitude();
+
         if (pidRuntime.levelRaceMode && !gpsRescueIsActive) {
             levelMode = LEVEL_MODE_R;
         } else {
@@ -836,7 +839,7 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
         pidRuntime.antiGravityThrottleD = 0.0f;
         pidRuntime.itermAccelerator = 0.0f;
     }
-    DEBUG_SET(DEBUG_ANTI_GRAVITY, 2, lrintf((1 + (pidRuntime.itermAccelerator / pidRuntime.pidCoefficient[FD_PITCH].Ki)) * 1000));
+    DEBUG_SET(DEBUG_ANTI_GRAVITY, 2, lrintf((1 + (pidRuntime.itermAccelerator / pidRuntime.pidCoefficient.Ki[FD_PITCH])) * 1000));
     // amount of antigravity added relative to user's pitch iTerm coefficient
     // used later to increase iTerm
 
@@ -869,12 +872,27 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
     rpmFilterUpdate();
 #endif
 
-    // ----------PID controller----------
+    // The controller runs in two stages. The first resolves the setpoint and error of each axis, which
+    // depends on flight modes and on crash recovery state that one axis can change for the next, so it
+    // is evaluated axis by axis. The second computes the P, I, D and F terms of all three axes in
+    // lockstep over the resulting arrays using the gains resolved by pidInitConfig().
+
+    float currentPidSetpoint[XYZ_AXIS_COUNT];
+    float errorRate[XYZ_AXIS_COUNT];
+    float itermErrorRate[XYZ_AXIS_COUNT];
+    float pidSetpointDelta[XYZ_AXIS_COUNT];
+    float dtermDelta[XYZ_AXIS_COUNT];
+    bool dtermActive[XYZ_AXIS_COUNT];
+#ifdef USE_ABSOLUTE_CONTROL
+    float setpointCorrectionDelta[XYZ_AXIS_COUNT];
+#endif
+
+    // ----------setpoint and error----------
     for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
 
-        float currentPidSetpoint = getSetpointRate(axis);
+        float setpoint = getSetpointRate(axis);
         if (pidRuntime.maxVelocity[axis]) {
-            currentPidSetpoint = accelerationLimit(axis, currentPidSetpoint);
+            setpoint = accelerationLimit(axis, setpoint);
         }
         // Yaw control is GYRO based, direct sticks control is applied to rate PID
         // When Race Mode is active PITCH control is also GYRO based in level or horizon mode
@@ -883,21 +901,21 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
         if (axis < FD_YAW) {
             if (levelMode == LEVEL_MODE_RP || (levelMode == LEVEL_MODE_R && axis == FD_ROLL)) {
                 pidRuntime.axisInAngleMode[axis] = true;
-                currentPidSetpoint = pidLevel(axis, pidProfile, angleTrim, currentPidSetpoint, horizonLevelStrength);
+                setpoint = pidLevel(axis, pidProfile, angleTrim, setpoint, horizonLevelStrength);
             }
         } else { // yaw axis only
             if (levelMode == LEVEL_MODE_RP) {
                 // if earth referencing is requested, attenuate yaw axis setpoint when pitched or rolled
                 // and send yawSetpoint to Angle code to modulate pitch and roll
-                // code cost is 107 cycles when earthRef enabled, 20 otherwise, nearly all in cos_approx
+                // the cosine is nearly all of the cost when earthRef is enabled, the fast tier is ample here
                 const float earthRefGain = FLIGHT_MODE(GPS_RESCUE_MODE) ? 1.0f : pidRuntime.angleEarthRef;
                 if (earthRefGain) {
-                    pidRuntime.angleYawSetpoint = currentPidSetpoint;
+                    pidRuntime.angleYawSetpoint = setpoint;
                     float maxAngleTargetAbs = earthRefGain * fmaxf( fabsf(pidRuntime.angleTarget[FD_ROLL]), fabsf(pidRuntime.angleTarget[FD_PITCH]) );
                     maxAngleTargetAbs *= (FLIGHT_MODE(HORIZON_MODE)) ? horizonLevelStrength : 1.0f;
                     // reduce compensation whenever Horizon uses less levelling
-                    currentPidSetpoint *= cos_approx(DEGREES_TO_RADIANS(maxAngleTargetAbs));
-                    DEBUG_SET(DEBUG_ANGLE_TARGET, 2, currentPidSetpoint); // yaw setpoint after attenuation
+                    setpoint *= cos_approx_fast(DEGREES_TO_RADIANS(maxAngleTargetAbs));
+                    DEBUG_SET(DEBUG_ANGLE_TARGET, 2, setpoint); // yaw setpoint after attenuation
                 }
             }
         }
@@ -905,16 +923,16 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
 
 #ifdef USE_ACRO_TRAINER
         if ((axis != FD_YAW) && pidRuntime.acroTrainerActive && !pidRuntime.inCrashRecoveryMode && !launchControlActive) {
-            currentPidSetpoint = applyAcroTrainer(axis, angleTrim, currentPidSetpoint);
+            setpoint = applyAcroTrainer(axis, angleTrim, setpoint);
         }
 #endif // USE_ACRO_TRAINER
 
 #ifdef USE_LAUNCH_CONTROL
         if (launchControlActive) {
 #if defined(USE_ACC)
-            currentPidSetpoint = applyLaunchControl(axis, angleTrim);
+            setpoint = applyLaunchControl(axis, angleTrim);
 #else
-            currentPidSetpoint = applyLaunchControl(axis, NULL);
+            setpoint = applyLaunchControl(axis, NULL);
 #endif
         }
 #endif
@@ -923,64 +941,38 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
         // It's not necessary to zero the set points for R/P because the PIDs will be zeroed below
 #ifdef USE_YAW_SPIN_RECOVERY
         if ((axis == FD_YAW) && yawSpinActive) {
-            currentPidSetpoint = 0.0f;
+            setpoint = 0.0f;
         }
 #endif // USE_YAW_SPIN_RECOVERY
 
         // -----calculate error rate
         const float gyroRate = gyro.gyroADCf[axis]; // Process variable from gyro output in deg/sec
-        float errorRate = currentPidSetpoint - gyroRate; // r - y
+        float error = setpoint - gyroRate; // r - y
 #if defined(USE_ACC)
         handleCrashRecovery(
             pidProfile->crash_recovery, angleTrim, axis, currentTimeUs, gyroRate,
-            &currentPidSetpoint, &errorRate);
+            &setpoint, &error);
 #endif
 
-        const float previousIterm = pidData[axis].I;
-        float itermErrorRate = errorRate;
+        itermErrorRate[axis] = error;
 #ifdef USE_ABSOLUTE_CONTROL
-        const float uncorrectedSetpoint = currentPidSetpoint;
+        const float uncorrectedSetpoint = setpoint;
 #endif
 
 #if defined(USE_ITERM_RELAX)
         if (!launchControlActive && !pidRuntime.inCrashRecoveryMode) {
-            applyItermRelax(axis, previousIterm, gyroRate, &itermErrorRate, &currentPidSetpoint);
-            errorRate = currentPidSetpoint - gyroRate;
+            applyItermRelax(axis, pidData[axis].I, gyroRate, &itermErrorRate[axis], &setpoint);
+            error = setpoint - gyroRate;
         }
 #endif
 #ifdef USE_ABSOLUTE_CONTROL
-        const float setpointCorrection = currentPidSetpoint - uncorrectedSetpoint;
-#endif
-
-        // --------low-level gyro-based PID based on 2DOF PID controller. ----------
-
-        // -----calculate P component
-        pidData[axis].P = pidRuntime.pidCoefficient[axis].Kp * errorRate * tpaFactorKp;
-        if (axis == FD_YAW) {
-            pidData[axis].P = pidRuntime.ptermYawLowpassApplyFn((filter_t *) &pidRuntime.ptermYawLowpass, pidData[axis].P);
-        }
-
-
-        // -----calculate I component
-        float Ki = pidRuntime.pidCoefficient[axis].Ki;
-#ifdef USE_LAUNCH_CONTROL
-        // if launch control is active override the iterm gains and apply iterm windup protection to all axes
-        if (launchControlActive) {
-            Ki = pidRuntime.launchControlKi;
-        } else
+        // include abs control correction in feedforward
+        const float setpointCorrection = setpoint - uncorrectedSetpoint;
+        setpointCorrectionDelta[axis] = setpointCorrection - pidRuntime.oldSetpointCorrection[axis];
+        pidRuntime.oldSetpointCorrection[axis] = setpointCorrection;
 #endif
-        {
-            if (axis == FD_YAW) {
-                pidRuntime.itermAccelerator = 0.0f; // no antigravity on yaw iTerm
-            }
-        }
-        const float iTermChange = (Ki + pidRuntime.itermAccelerator) * dynCi * pidRuntime.dT * itermErrorRate;
-        pidData[axis].I = constrainf(previousIterm + iTermChange, -pidRuntime.itermLimit, pidRuntime.itermLimit);
-
-        // -----calculate D component
-
-        float pidSetpointDelta = 0;
 
+        pidSetpointDelta[axis] = 0;
 #ifdef USE_FEEDFORWARD
         if (FLIGHT_MODE(ANGLE_MODE) && pidRuntime.axisInAngleMode[axis]) {
             // this axis is fully under self-levelling control
@@ -991,38 +983,73 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
             // the RC stepping does not come in via the feedforward, which is very well smoothed already
             // if uncommented, and the forcing to zero is removed, the two following lines will restore PID feedforward to angle mode axes
             // but for now let's see how we go without it (which was the case before 4.5 anyway)
-//            pidSetpointDelta = currentPidSetpoint - pidRuntime.previousPidSetpoint[axis];
-//            pidSetpointDelta *= pidRuntime.pidFrequency * pidRuntime.angleFeedforwardGain;
-            pidSetpointDelta = 0.0f;
+//            pidSetpointDelta[axis] = currentPidSetpoint[axis] - pidRuntime.previousPidSetpoint[axis];
+//            pidSetpointDelta[axis] *= pidRuntime.pidFrequency * pidRuntime.angleFeedforwardGain;
+            pidSetpointDelta[axis] = 0.0f;
         } else {
             // the axis is operating as a normal acro axis, so use normal feedforard from rc.c
-            pidSetpointDelta = getFeedforward(axis);
+            pidSetpointDelta[axis] = getFeedforward(axis);
         }
 #endif
-        pidRuntime.previousPidSetpoint[axis] = currentPidSetpoint; // this is the value sent to blackbox, and used for Dmin setpoint
+        pidRuntime.previousPidSetpoint[axis] = setpoint; // this is the value sent to blackbox, and used for Dmin setpoint
+
+        // Divide rate change by dT to get differential (ie dr/dt).
+        // dT is fixed and calculated from the target PID loop time
+        // This is done to avoid DTerm spikes that occur with dynamically
+        // calculated deltaT whenever another task causes the PID
+        // loop execution to be delayed.
+        dtermDelta[axis] = - (gyroRateDterm[axis] - previousGyroRateDterm[axis]) * pidRuntime.pidFrequency;
+        previousGyroRateDterm[axis] = gyroRateDterm[axis];
 
         // disable D if launch control is active
-        if ((pidRuntime.pidCoefficient[axis].Kd > 0) && !launchControlActive) {
-            // Divide rate change by dT to get differential (ie dr/dt).
-            // dT is fixed and calculated from the target PID loop time
-            // This is done to avoid DTerm spikes that occur with dynamically
-            // calculated deltaT whenever another task causes the PID
-            // loop execution to be delayed.
-            const float delta = - (gyroRateDterm[axis] - previousGyroRateDterm[axis]) * pidRuntime.pidFrequency;
-            float preTpaD = pidRuntime.pidCoefficient[axis].Kd * delta;
-
+        dtermActive[axis] = (pidRuntime.pidCoefficient.Kd[axis] > 0) && !launchControlActive;
 #if defined(USE_ACC)
-            if (cmpTimeUs(currentTimeUs, levelModeStartTimeUs) > CRASH_RECOVERY_DETECTION_DELAY_US) {
-                detectAndSetCrashRecovery(pidProfile->crash_recovery, axis, currentTimeUs, delta, errorRate);
-            }
+        // crash detection is done here rather than in the lockstep stage as it changes how the following axes are handled
+        if (dtermActive[axis] && cmpTimeUs(currentTimeUs, levelModeStartTimeUs) > CRASH_RECOVERY_DETECTION_DELAY_US) {
+            detectAndSetCrashRecovery(pidProfile->crash_recovery, axis, currentTimeUs, dtermDelta[axis], error);
+        }
 #endif
 
+        currentPidSetpoint[axis] = setpoint;
+        errorRate[axis] = error;
+    }
+
+    // --------low-level gyro-based PID based on 2DOF PID controller. ----------
+
+    // -----calculate P component
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
+        pidData[axis].P = pidRuntime.pidCoefficient.Kp[axis] * errorRate[axis] * tpaFactorKp;
+    }
+    pidData[FD_YAW].P = pidRuntime.ptermYawLowpassApplyFn((filter_t *) &pidRuntime.ptermYawLowpass, pidData[FD_YAW].P);
+
+    // -----calculate I component
+    // if launch control is active override the iterm gains and apply iterm windup protection to all axes
+    const float *Ki = pidRuntime.pidCoefficient.Ki;
+    const float *itermAcceleratorGain = pidRuntime.itermAcceleratorGain;
+#ifdef USE_LAUNCH_CONTROL
+    const float launchControlKi[XYZ_AXIS_COUNT] = { pidRuntime.launchControlKi, pidRuntime.launchControlKi, pidRuntime.launchControlKi };
+    static const float launchControlItermAcceleratorGain[XYZ_AXIS_COUNT] = { 1.0f, 1.0f, 1.0f };
+    if (launchControlActive) {
+        Ki = launchControlKi;
+        itermAcceleratorGain = launchControlItermAcceleratorGain;
+    }
+#endif
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
+        const float iTermChange = (Ki[axis] + pidRuntime.itermAccelerator * itermAcceleratorGain[axis]) * dynCi * pidRuntime.dT * itermErrorRate[axis];
+        pidData[axis].I = constrainf(pidData[axis].I + iTermChange, -pidRuntime.itermLimit, pidRuntime.itermLimit);
+    }
+
+    // -----calculate D component
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
+        if (dtermActive[axis]) {
+            float preTpaD = pidRuntime.pidCoefficient.Kd[axis] * dtermDelta[axis];
+
 #if defined(USE_D_MIN)
             float dMinFactor = 1.0f;
             if (pidRuntime.dMinPercent[axis] > 0) {
-                float dMinGyroFactor = pt2FilterApply(&pidRuntime.dMinRange[axis], delta);
+                float dMinGyroFactor = pt2FilterApply(&pidRuntime.dMinRange[axis], dtermDelta[axis]);
                 dMinGyroFactor = fabsf(dMinGyroFactor) * pidRuntime.dMinGyroGain;
-                const float dMinSetpointFactor = (fabsf(pidSetpointDelta)) * pidRuntime.dMinSetpointGain;
+                const float dMinSetpointFactor = (fabsf(pidSetpointDelta[axis])) * pidRuntime.dMinSetpointGain;
                 dMinFactor = MAX(dMinGyroFactor, dMinSetpointFactor);
                 dMinFactor = pidRuntime.dMinPercent[axis] + (1.0f - pidRuntime.dMinPercent[axis]) * dMinFactor;
                 dMinFactor = pt2FilterApply(&pidRuntime.dMinLowpass[axis], dMinFactor);
@@ -1030,9 +1057,9 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
                 if (axis == FD_ROLL) {
                     DEBUG_SET(DEBUG_D_MIN, 0, lrintf(dMinGyroFactor * 100));
                     DEBUG_SET(DEBUG_D_MIN, 1, lrintf(dMinSetpointFactor * 100));
-                    DEBUG_SET(DEBUG_D_MIN, 2, lrintf(pidRuntime.pidCoefficient[axis].Kd * dMinFactor * 10 / DTERM_SCALE));
+                    DEBUG_SET(DEBUG_D_MIN, 2, lrintf(pidRuntime.pidCoefficient.Kd[axis] * dMinFactor * 10 / DTERM_SCALE));
                 } else if (axis == FD_PITCH) {
-                    DEBUG_SET(DEBUG_D_MIN, 3, lrintf(pidRuntime.pidCoefficient[axis].Kd * dMinFactor * 10 / DTERM_SCALE));
+                    DEBUG_SET(DEBUG_D_MIN, 3, lrintf(pidRuntime.pidCoefficient.Kd[axis] * dMinFactor * 10 / DTERM_SCALE));
                 }
             }
 
@@ -1051,75 +1078,77 @@ void FAST_CODE pidController(const pidProfile_t *pidProfile, timeUs_t currentTim
                 DEBUG_SET(DEBUG_D_LPF, axis - FD_ROLL + 2, 0);
             }
         }
+    }
 
-        previousGyroRateDterm[axis] = gyroRateDterm[axis];
-
-        // -----calculate feedforward component
-
+    // -----calculate feedforward component
+    // no feedforward in launch control
+    const float feedforwardScale = launchControlActive ? 0.0f : 1.0f;
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
 #ifdef USE_ABSOLUTE_CONTROL
-        // include abs control correction in feedforward
-        pidSetpointDelta += setpointCorrection - pidRuntime.oldSetpointCorrection[axis];
-        pidRuntime.oldSetpointCorrection[axis] = setpointCorrection;
+        pidSetpointDelta[axis] += setpointCorrectionDelta[axis];
 #endif
-        // no feedforward in launch control
-        const float feedforwardGain = launchControlActive ? 0.0f : pidRuntime.pidCoefficient[axis].Kf;
-        pidData[axis].F = feedforwardGain * pidSetpointDelta;
+        pidData[axis].F = pidRuntime.pidCoefficient.Kf[axis] * feedforwardScale * pidSetpointDelta[axis];
+    }
 
 #ifdef USE_YAW_SPIN_RECOVERY
-        if (yawSpinActive) {
+    if (yawSpinActive) {
+        for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
             pidData[axis].I = 0;  // in yaw spin always disable I
-            if (axis <= FD_PITCH)  {
-                // zero PIDs on pitch and roll leaving yaw P to correct spin
-                pidData[axis].P = 0;
-                pidData[axis].D = 0;
-                pidData[axis].F = 0;
-            }
         }
+        // zero PIDs on pitch and roll leaving yaw P to correct spin
+        for (int axis = FD_ROLL; axis <= FD_PITCH; ++axis) {
+            pidData[axis].P = 0;
+            pidData[axis].D = 0;
+            pidData[axis].F = 0;
+        }
+    }
 #endif // USE_YAW_SPIN_RECOVERY
 
 #ifdef USE_LAUNCH_CONTROL
-        // Disable P/I appropriately based on the launch control mode
-        if (launchControlActive) {
-            // if not using FULL mode then disable I accumulation on yaw as
-            // yaw has a tendency to windup. Otherwise limit yaw iterm accumulation.
-            const int launchControlYawItermLimit = (pidRuntime.launchControlMode == LAUNCH_CONTROL_MODE_FULL) ? LAUNCH_CONTROL_YAW_ITERM_LIMIT : 0;
-            pidData[FD_YAW].I = constrainf(pidData[FD_YAW].I, -launchControlYawItermLimit, launchControlYawItermLimit);
-
-            // for pitch-only mode we disable everything except pitch P/I
-            if (pidRuntime.launchControlMode == LAUNCH_CONTROL_MODE_PITCHONLY) {
-                pidData[FD_ROLL].P = 0;
-                pidData[FD_ROLL].I = 0;
-                pidData[FD_YAW].P = 0;
-                // don't let I go negative (pitch backwards) as front motors are limited in the mixer
-                pidData[FD_PITCH].I = MAX(0.0f, pidData[FD_PITCH].I);
-            }
+    // Disable P/I appropriately based on the launch control mode
+    if (launchControlActive) {
+        // if not using FULL mode then disable I accumulation on yaw as
+        // yaw has a tendency to windup. Otherwise limit yaw iterm accumulation.
+        const int launchControlYawItermLimit = (pidRuntime.launchControlMode == LAUNCH_CONTROL_MODE_FULL) ? LAUNCH_CONTROL_YAW_ITERM_LIMIT : 0;
+        pidData[FD_YAW].I = constrainf(pidData[FD_YAW].I, -launchControlYawItermLimit, launchControlYawItermLimit);
+
+        // for pitch-only mode we disable everything except pitch P/I
+        if (pidRuntime.launchControlMode == LAUNCH_CONTROL_MODE_PITCHONLY) {
+            pidData[FD_ROLL].P = 0;
+            pidData[FD_ROLL].I = 0;
+            pidData[FD_YAW].P = 0;
+            // don't let I go negative (pitch backwards) as front motors are limited in the mixer
+            pidData[FD_PITCH].I = MAX(0.0f, pidData[FD_PITCH].I);
         }
+    }
 #endif
 
-        // Add P boost from antiGravity when sticks are close to zero
-        if (axis != FD_YAW) {
-            float agSetpointAttenuator = fabsf(currentPidSetpoint) / 50.0f;
-            agSetpointAttenuator = MAX(agSetpointAttenuator, 1.0f);
-            // attenuate effect if turning more than 50 deg/s, half at 100 deg/s
-            const float antiGravityPBoost = 1.0f + (pidRuntime.antiGravityThrottleD / agSetpointAttenuator) * pidRuntime.antiGravityPGain;
-            pidData[axis].P *= antiGravityPBoost;
-            if (axis == FD_PITCH) {
-                DEBUG_SET(DEBUG_ANTI_GRAVITY, 3, lrintf(antiGravityPBoost * 1000));
-            }
+    // Add P boost from antiGravity when sticks are close to zero, the gain is zero on yaw
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
+        float agSetpointAttenuator = fabsf(currentPidSetpoint[axis]) / 50.0f;
+        agSetpointAttenuator = MAX(agSetpointAttenuator, 1.0f);
+        // attenuate effect if turning more than 50 deg/s, half at 100 deg/s
+        const float antiGravityPBoost = 1.0f + (pidRuntime.antiGravityThrottleD / agSetpointAttenuator) * pidRuntime.antiGravityPGain[axis];
+        pidData[axis].P *= antiGravityPBoost;
+        if (axis == FD_PITCH) {
+            DEBUG_SET(DEBUG_ANTI_GRAVITY, 3, lrintf(antiGravityPBoost * 1000));
         }
+    }
 
-        // calculating the PID sum
-        const float pidSum = pidData[axis].P + pidData[axis].I + pidData[axis].D + pidData[axis].F;
+    // calculating the PID sum
 #ifdef USE_INTEGRATED_YAW_CONTROL
-        if (axis == FD_YAW && pidRuntime.useIntegratedYaw) {
-            pidData[axis].Sum += pidSum * pidRuntime.dT * 100.0f;
-            pidData[axis].Sum -= pidData[axis].Sum * pidRuntime.integratedYawRelax / 100000.0f * pidRuntime.dT / 0.000125f;
-        } else
+    const float previousYawSum = pidData[FD_YAW].Sum;
 #endif
-        {
-            pidData[axis].Sum = pidSum;
-        }
+    for (int axis = FD_ROLL; axis <= FD_YAW; ++axis) {
+        pidData[axis].Sum = pidData[axis].P + pidData[axis].I + pidData[axis].D + pidData[axis].F;
+    }
+#ifdef USE_INTEGRATED_YAW_CONTROL
+    if (pidRuntime.useIntegratedYaw) {
+        // the yaw sum is integrated rather than used directly
+        pidData[FD_YAW].Sum = previousYawSum + pidData[FD_YAW].Sum * pidRuntime.dT * 100.0f;
+        pidData[FD_YAW].Sum -= pidData[FD_YAW].Sum * pidRuntime.integratedYawRelax / 100000.0f * pidRuntime.dT / 0.000125f;
     }
+#endif
 
     // Disable PID control if at zero throttle or if gyro overflow detected
     // This may look very innefficient, but it is done on purpose to always show real CPU usage as in flight
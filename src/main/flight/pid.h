@@ -269,11 +269,12 @@ typedef union dtermLowpass_u {
     pt3Filter_t pt3Filter;
 } dtermLowpass_t;
 
+// Gains are held per term so the PID core can compute the three axes in lockstep
 typedef struct pidCoefficient_s {
-    float Kp;
-    float Ki;
-    float Kd;
-    float Kf;
+    float Kp[XYZ_AXIS_COUNT];
+    float Ki[XYZ_AXIS_COUNT];
+    float Kd[XYZ_AXIS_COUNT];
+    float Kf[XYZ_AXIS_COUNT];
 } pidCoefficient_t;
 
 typedef struct pidRuntime_s {
@@ -295,8 +296,9 @@ typedef struct pidRuntime_s {
     float antiGravityThrottleD;
     float itermAccelerator;
     uint8_t antiGravityGain;
-    float antiGravityPGain;
-    pidCoefficient_t pidCoefficient[XYZ_AXIS_COUNT];
+    float antiGravityPGain[XYZ_AXIS_COUNT];         // zero on yaw, no P boost from antiGravity
+    float itermAcceleratorGain[XYZ_AXIS_COUNT];     // zero on yaw, no antiGravity on yaw iTerm
+    pidCoefficient_t pidCoefficient;
     float angleGain;
     float angleFeedforwardGain;
     float horizonGain;
@@ -322,6 +324,7 @@ typedef struct pidRuntime_s {
     bool zeroThrottleItermReset;
     bool levelRaceMode;
     float tpaFactor;
+    bool tpaAppliesToP;
     float tpaBreakpoint;
     float tpaMultiplier;
 
@@ -440,7 +443,7 @@ void pidSetAntiGravityState(bool newState);
 bool pidAntiGravityEnabled(void);
 
 #ifdef USE_THRUST_LINEARIZATION
-float pidApplyThrustLinearization(float motorValue);
+float pidGetThrustLinearization(void);
 float pidCompensateThrustLinearization(float throttle);
 #endif
 
@@ -272,16 +272,16 @@ void pidInit(const pidProfile_t *pidProfile)
 void pidInitConfig(const pidProfile_t *pidProfile)
 {
     for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-        pidRuntime.pidCoefficient[axis].Kp = PTERM_SCALE * pidProfile->pid[axis].P;
-        pidRuntime.pidCoefficient[axis].Ki = ITERM_SCALE * pidProfile->pid[axis].I;
-        pidRuntime.pidCoefficient[axis].Kd = DTERM_SCALE * pidProfile->pid[axis].D;
-        pidRuntime.pidCoefficient[axis].Kf = FEEDFORWARD_SCALE * (pidProfile->pid[axis].F * 0.01f);
+        pidRuntime.pidCoefficient.Kp[axis] = PTERM_SCALE * pidProfile->pid[axis].P;
+        pidRuntime.pidCoefficient.Ki[axis] = ITERM_SCALE * pidProfile->pid[axis].I;
+        pidRuntime.pidCoefficient.Kd[axis] = DTERM_SCALE * pidProfile->pid[axis].D;
+        pidRuntime.pidCoefficient.Kf[axis] = FEEDFORWARD_SCALE * (pidProfile->pid[axis].F * 0.01f);
     }
 #ifdef USE_INTEGRATED_YAW_CONTROL
     if (!pidProfile->use_integrated_yaw)
 #endif
     {
-        pidRuntime.pidCoefficient[FD_YAW].Ki *= 2.5f;
+        pidRuntime.pidCoefficient.Ki[FD_YAW] *= 2.5f;
     }
     pidRuntime.angleGain = pidProfile->pid[PID_LEVEL].P / 10.0f;
     pidRuntime.angleFeedforwardGain = pidProfile->pid[PID_LEVEL].F / 100.0f;
@@ -321,7 +321,12 @@ void pidInitConfig(const pidProfile_t *pidProfile)
     // Calculate the anti-gravity value that will trigger the OSD display when its strength exceeds 25% of max.
     // This gives a useful indication of AG activity without excessive display.
     pidRuntime.antiGravityOsdCutoff = (pidRuntime.antiGravityGain / 10.0f) * 0.25f;
-    pidRuntime.antiGravityPGain = ((float)(pidProfile->anti_gravity_p_gain) / 100.0f) * ANTIGRAVITY_KP;
+    pidRuntime.antiGravityPGain[FD_ROLL] = ((float)(pidProfile->anti_gravity_p_gain) / 100.0f) * ANTIGRAVITY_KP;
+    pidRuntime.antiGravityPGain[FD_PITCH] = pidRuntime.antiGravityPGain[FD_ROLL];
+    pidRuntime.antiGravityPGain[FD_YAW] = 0.0f;
+    pidRuntime.itermAcceleratorGain[FD_ROLL] = 1.0f;
+    pidRuntime.itermAcceleratorGain[FD_PITCH] = 1.0f;
+    pidRuntime.itermAcceleratorGain[FD_YAW] = 0.0f;
 
 #if defined(USE_ITERM_RELAX)
     pidRuntime.itermRelax = pidProfile->iterm_relax;
@@ -342,8 +347,8 @@ void pidInitConfig(const pidProfile_t *pidProfile)
     pidRuntime.acErrorLimit = (float)pidProfile->abs_control_error_limit;
     pidRuntime.acCutoff = (float)pidProfile->abs_control_cutoff;
     for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
-        float iCorrection = -pidRuntime.acGain * PTERM_SCALE / ITERM_SCALE * pidRuntime.pidCoefficient[axis].Kp;
-        pidRuntime.pidCoefficient[axis].Ki = MAX(0.0f, pidRuntime.pidCoefficient[axis].Ki + iCorrection);
+        float iCorrection = -pidRuntime.acGain * PTERM_SCALE / ITERM_SCALE * pidRuntime.pidCoefficient.Kp[axis];
+        pidRuntime.pidCoefficient.Ki[axis] = MAX(0.0f, pidRuntime.pidCoefficient.Ki[axis] + iCorrection);
     }
 #endif
 
@@ -425,6 +430,11 @@ void pidInitConfig(const pidProfile_t *pidProfile)
 #endif
 
     pidRuntime.levelRaceMode = pidProfile->level_race_mode;
+#ifdef USE_TPA_MODE
+    pidRuntime.tpaAppliesToP = pidProfile->tpa_mode == TPA_MODE_PD;
+#else
+    pidRuntime.tpaAppliesToP = true;
+#endif
     pidRuntime.tpaBreakpoint = constrainf((pidProfile->tpa_breakpoint - PWM_RANGE_MIN) / 1000.0f, 0.0f, 0.99f);
     // default of 1350 returns 0.35. range limited to 0 to 0.99
     pidRuntime.tpaMultiplier = (pidProfile->tpa_rate / 100.0f) / (1.0f - pidRuntime.tpaBreakpoint);
@@ -23,13 +23,13 @@
 #include <stdlib.h>
 #include <math.h>
 #include <limits.h>
+#include <string.h>
 
 #include "platform.h"
 
 #include "build/debug.h"
 
 #include "common/maths.h"
-#include "common/filter.h"
 
 #include "fc/runtime_config.h"
 
@@ -41,6 +41,7 @@
 
 #include "scheduler/scheduler.h"
 
+#include "sensors/acceleration.h"
 #include "sensors/sensors.h"
 #include "sensors/barometer.h"
 
@@ -54,23 +55,104 @@ static float zeroedAltitudeCm = 0.0f;
 static float zeroedAltitudeDerivative = 0.0f;
 #endif
 
-static pt2Filter_t altitudeLpf;
-static pt2Filter_t altitudeDerivativeLpf;
 #ifdef USE_VARIO
 static int16_t estimatedVario = 0; // in cm/s
 #endif
 
-void positionInit(void)
+#if defined(USE_BARO) || defined(USE_GPS)
+#define GRAVITY_CMSS 980.665f
+#define VERTICAL_ESTIMATOR_BIAS_NOISE 2.0f          // cm/s/s per sqrt(s), random walk of the accelerometer Z bias
+#define VERTICAL_ESTIMATOR_BIAS_LIMIT 200.0f        // cm/s/s
+#define VERTICAL_ESTIMATOR_MAX_DT 0.1f              // s, longer gaps are treated as a restart of the prediction
+#define VERTICAL_ESTIMATOR_INITIAL_ALTITUDE_VAR (1000.0f * 1000.0f)
+#define VERTICAL_ESTIMATOR_INITIAL_VELOCITY_VAR (100.0f * 100.0f)
+#define VERTICAL_ESTIMATOR_INITIAL_BIAS_VAR (50.0f * 50.0f)
+
+// Kalman filter over altitude, vertical velocity and accelerometer Z bias. The prediction is driven by the
+// earth frame Z acceleration at the ACC rate, baro and GPS altitudes are fused as corrections weighted by their accuracy.
+typedef struct verticalEstimator_s {
+    float altitudeCm;
+    float velocityCmS;
+    float accBiasCmSS;
+    float P[3][3];
+    float accNoiseDensity;                  // (cm/s/s)^2 per Hz
+    float baroVariance;                     // cm^2
+    timeUs_t lastPredictionUs;
+} verticalEstimator_t;
+
+static verticalEstimator_t verticalEstimator;
+
+static void verticalEstimatorReset(verticalEstimator_t *est)
 {
-    const float sampleTimeS = HZ_TO_INTERVAL(TASK_ALTITUDE_RATE_HZ);
+    est->altitudeCm = 0.0f;
+    est->velocityCmS = 0.0f;
+    est->accBiasCmSS = 0.0f;
+    memset(est->P, 0, sizeof(est->P));
+    est->P[0][0] = VERTICAL_ESTIMATOR_INITIAL_ALTITUDE_VAR;
+    est->P[1][1] = VERTICAL_ESTIMATOR_INITIAL_VELOCITY_VAR;
+    est->P[2][2] = VERTICAL_ESTIMATOR_INITIAL_BIAS_VAR;
+    est->lastPredictionUs = 0;
+}
+
+static void verticalEstimatorPredict(verticalEstimator_t *est, float accelerationCmSS, float dt)
+{
+    const float acceleration = accelerationCmSS - est->accBiasCmSS;
+    est->altitudeCm += (est->velocityCmS + 0.5f * acceleration * dt) * dt;
+    est->velocityCmS += acceleration * dt;
+
+    // P = F.P.F' + Q with F = [1 dt -dt^2/2; 0 1 -dt; 0 0 1]
+    float (*P)[3] = est->P;
+    const float halfDt2 = 0.5f * dt * dt;
+    float FP[3][3];
+    for (int i = 0; i < 3; i++) {
+        FP[0][i] = P[0][i] + dt * P[1][i] - halfDt2 * P[2][i];
+        FP[1][i] = P[1][i] - dt * P[2][i];
+        FP[2][i] = P[2][i];
+    }
+    for (int i = 0; i < 3; i++) {
+        P[i][0] = FP[i][0] + dt * FP[i][1] - halfDt2 * FP[i][2];
+        P[i][1] = FP[i][1] - dt * FP[i][2];
+        P[i][2] = FP[i][2];
+    }
 
-    const float altitudeCutoffHz = positionConfig()->altitude_lpf / 100.0f;
-    const float altitudeGain = pt2FilterGain(altitudeCutoffHz, sampleTimeS);
-    pt2FilterInit(&altitudeLpf, altitudeGain);
+    // white acceleration noise integrated into altitude and velocity, and a random walk on the bias
+    const float q = est->accNoiseDensity;
+    P[0][0] += q * dt * dt * dt / 3.0f;
+    P[0][1] += q * halfDt2;
+    P[1][0] += q * halfDt2;
+    P[1][1] += q * dt;
+    P[2][2] += sq(VERTICAL_ESTIMATOR_BIAS_NOISE) * dt;
+}
 
-    const float altitudeDerivativeCutoffHz = positionConfig()->altitude_d_lpf / 100.0f;
-    const float altitudeDerivativeGain = pt2FilterGain(altitudeDerivativeCutoffHz, sampleTimeS);
-    pt2FilterInit(&altitudeDerivativeLpf, altitudeDerivativeGain);
+// Fuses an altitude measurement with the given variance
+static void verticalEstimatorCorrect(verticalEstimator_t *est, float altitudeCm, float variance)
+{
+    float (*P)[3] = est->P;
+    const float innovation = altitudeCm - est->altitudeCm;
+    const float S = P[0][0] + variance;
+    const float K[3] = { P[0][0] / S, P[1][0] / S, P[2][0] / S };
+
+    est->altitudeCm += K[0] * innovation;
+    est->velocityCmS += K[1] * innovation;
+    est->accBiasCmSS = constrainf(est->accBiasCmSS + K[2] * innovation, -VERTICAL_ESTIMATOR_BIAS_LIMIT, VERTICAL_ESTIMATOR_BIAS_LIMIT);
+
+    // P = (I - K.H).P with H = [1 0 0]
+    const float P0[3] = { P[0][0], P[0][1], P[0][2] };
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            P[i][j] -= K[i] * P0[j];
+        }
+    }
+}
+#endif
+
+void positionInit(void)
+{
+#if defined(USE_BARO) || defined(USE_GPS)
+    verticalEstimatorReset(&verticalEstimator);
+    verticalEstimator.accNoiseDensity = sq((float)positionConfig()->altitude_acc_noise);
+    verticalEstimator.baroVariance = sq((float)positionConfig()->altitude_baro_noise);
+#endif
 }
 
 typedef enum {
@@ -79,16 +161,40 @@ typedef enum {
     GPS_ONLY
 } altitudeSource_e;
 
-PG_REGISTER_WITH_RESET_TEMPLATE(positionConfig_t, positionConfig, PG_POSITION, 4);
+PG_REGISTER_WITH_RESET_TEMPLATE(positionConfig_t, positionConfig, PG_POSITION, 5);
 
 PG_RESET_TEMPLATE(positionConfig_t, positionConfig,
     .altitude_source = DEFAULT,
     .altitude_prefer_baro = 100, // percentage 'trust' of baro data
-    .altitude_lpf = 300,
+    .altitude_baro_noise = 50,
+    .altitude_acc_noise = 20,
     .altitude_d_lpf = 100,
 );
 
 #if defined(USE_BARO) || defined(USE_GPS)
+#ifdef USE_ACC
+void positionUpdateAcceleration(timeUs_t currentTimeUs)
+{
+    verticalEstimator_t *est = &verticalEstimator;
+
+    if (!acc.isAccelUpdatedAtLeastOnce) {
+        return;
+    }
+
+    const float dt = cmpTimeUs(currentTimeUs, est->lastPredictionUs) * 1e-6f;
+    est->lastPredictionUs = currentTimeUs;
+    if (dt <= 0.0f || dt > VERTICAL_ESTIMATOR_MAX_DT) {
+        return;
+    }
+
+    // earth frame Z acceleration with gravity removed, positive up
+    const float accZ = rMat[2][0] * acc.accADC[X] + rMat[2][1] * acc.accADC[Y] + rMat[2][2] * acc.accADC[Z];
+    const float accelerationCmSS = (accZ * acc.dev.acc_1G_rec - 1.0f) * GRAVITY_CMSS;
+
+    verticalEstimatorPredict(est, accelerationCmSS, dt);
+}
+#endif
+
 void calculateEstimatedAltitude(void)
 {
     static bool wasArmed = false;
@@ -97,11 +203,16 @@ void calculateEstimatedAltitude(void)
     static float gpsAltOffsetCm = 0.0f;
     static float baroAltOffsetCm = 0.0f;
     static float newBaroAltOffsetCm = 0.0f;
+    static bool holdingAltitude = false;
+    static float heldAltitudeCm = 0.0f;
 
+    verticalEstimator_t *est = &verticalEstimator;
     float baroAltCm = 0.0f;
-    float gpsTrust = 0.3f; // if no hDOP value, use 0.3
+    float gpsStdDevCm = 0.0f;
+    float gpsTrust = 0.0f;
     bool haveBaroAlt = false; // true if baro exists and has been calibrated on power up
     bool haveGpsAlt = false; // true if GPS is connected and while it has a 3D fix, set each run to false
+    bool newGpsAlt = false; // true when haveGpsAlt and a fresh navigation solution has arrived since the last run
 
     // *** Get sensor data
 #ifdef USE_BARO
@@ -111,24 +222,34 @@ void calculateEstimatedAltitude(void)
     }
 #endif
 #ifdef USE_GPS
+    static uint32_t lastGpsNavMessage = 0;
     if (sensors(SENSOR_GPS) && STATE(GPS_FIX)) {
         // GPS_FIX means a 3D fix, which requires min 4 sats.
-        // On loss of 3D fix, gpsAltCm remains at the last value, haveGpsAlt becomes false, and gpsTrust goes to zero.
+        // On loss of 3D fix, gpsAltCm remains at the last value and haveGpsAlt becomes false.
         gpsAltCm = gpsSol.llh.altCm; // static, so hold last altitude value if 3D fix is lost to prevent fly to moon
         haveGpsAlt = true; // stays false if no 3D fix
-        if (gpsSol.dop.hdop != 0) {
-            gpsTrust = 100.0f / gpsSol.dop.hdop;
-            // *** TO DO - investigate if we should use vDOP or vACC with UBlox units;
+        newGpsAlt = gpsData.lastNavMessage != lastGpsNavMessage;
+        lastGpsNavMessage = gpsData.lastNavMessage;
+        if (gpsSol.acc.vAcc != 0) {
+            gpsStdDevCm = gpsSol.acc.vAcc / 10.0f; // vertical accuracy reported by the receiver, in mm
+        } else if (gpsSol.dop.hdop != 0) {
+            gpsStdDevCm = gpsSol.dop.hdop * 2.0f; // vertical error is typically twice the horizontal, hDOP 1.0 taken as 1m
+        } else {
+            gpsStdDevCm = 500.0f;
         }
-        // always use at least 10% of other sources besides gps if available
-        gpsTrust = MIN(gpsTrust, 0.9f);
     }
 #endif
 
+    // without an accelerometer the estimator runs as a constant velocity filter
+    if (!sensors(SENSOR_ACC)) {
+        verticalEstimatorPredict(est, 0.0f, HZ_TO_INTERVAL(TASK_ALTITUDE_RATE_HZ));
+    }
+
     //  ***  DISARMED  ***
     if (!ARMING_FLAG(ARMED)) {
         if (wasArmed) { // things to run once, on disarming, after being armed
             useZeroedGpsAltitude = false; // reset, and wait for valid GPS data to zero the GPS signal
+            holdingAltitude = false;
             wasArmed = false;
         }
 
@@ -142,7 +263,8 @@ void calculateEstimatedAltitude(void)
                 displayAltitudeCm = gpsAltCm; // estimatedAltitude shows most recent ASL GPS altitude in OSD and sensors, while disarmed
             }
         }
-        zeroedAltitudeCm = 0.0f; // always hold relativeAltitude at zero while disarmed
+        // hold relative altitude at zero while disarmed, the estimator sees a stationary craft and learns the accelerometer bias
+        verticalEstimatorCorrect(est, 0.0f, est->baroVariance);
         DEBUG_SET(DEBUG_ALTITUDE, 2, gpsAltCm / 100.0f); // Absolute altitude ASL in metres, max 32,767m
     //  ***  ARMED  ***
     } else {
@@ -153,49 +275,50 @@ void calculateEstimatedAltitude(void)
 
         baroAltCm -= baroAltOffsetCm; // use smoothed baro with most recent zero from disarm period
 
-        if (haveGpsAlt) { // update relativeAltitude with every new gpsAlt value, or hold the previous value until 3D lock recovers
-            if (!useZeroedGpsAltitude && haveBaroAlt) { // armed without zero offset, can use baro values to zero later
-                gpsAltOffsetCm = gpsAltCm - baroAltCm; // not very accurate
-                useZeroedGpsAltitude = true;
-            }
-            if (useZeroedGpsAltitude) { // normal situation
-                zeroedAltitudeCm = gpsAltCm - gpsAltOffsetCm; // now that we have a GPS offset value, we can use it to zero relativeAltitude
-            }
-        } else {
-            gpsTrust = 0.0f;
-            // TO DO - smoothly reduce GPS trust, rather than immediately dropping to zero for what could be only a very brief loss of 3D fix 
+        const bool useBaro = haveBaroAlt && (positionConfig()->altitude_source == DEFAULT || positionConfig()->altitude_source == BARO_ONLY);
+        if (useBaro) {
+            verticalEstimatorCorrect(est, baroAltCm, est->baroVariance);
         }
-        DEBUG_SET(DEBUG_ALTITUDE, 2, lrintf(zeroedAltitudeCm / 10.0f)); // Relative altitude above takeoff, to 0.1m, rolls over at 3,276.7m
-        
-        // Empirical mixing of GPS and Baro altitudes
-        if (useZeroedGpsAltitude && (positionConfig()->altitude_source == DEFAULT || positionConfig()->altitude_source == GPS_ONLY)) {
-            if (haveBaroAlt && positionConfig()->altitude_source == DEFAULT) {
-                // mix zeroed GPS with Baro altitude data, if Baro data exists if are in default altitude control mode 
-                const float absDifferenceM = fabsf(zeroedAltitudeCm - baroAltCm) / 100.0f * positionConfig()->altitude_prefer_baro / 100.0f;
-                if (absDifferenceM > 1.0f) { // when there is a large difference, favour Baro
-                    gpsTrust /=  absDifferenceM;
+
+        if (haveGpsAlt && !useZeroedGpsAltitude && haveBaroAlt) { // armed without zero offset, can use baro values to zero later
+            gpsAltOffsetCm = gpsAltCm - baroAltCm; // not very accurate
+            useZeroedGpsAltitude = true;
+        }
+        const bool useGps = newGpsAlt && useZeroedGpsAltitude && (positionConfig()->altitude_source == DEFAULT || positionConfig()->altitude_source == GPS_ONLY);
+        if (useGps) {
+            const float gpsZeroedAltCm = gpsAltCm - gpsAltOffsetCm;
+            if (useBaro) {
+                // when GPS disagrees strongly with the baro aided estimate, favour the baro
+                const float absDifferenceM = fabsf(gpsZeroedAltCm - est->altitudeCm) / 100.0f * positionConfig()->altitude_prefer_baro / 100.0f;
+                if (absDifferenceM > 1.0f) {
+                    gpsStdDevCm *= absDifferenceM;
                 }
-                zeroedAltitudeCm = zeroedAltitudeCm * gpsTrust + baroAltCm * (1.0f - gpsTrust);
             }
-        } else if (haveBaroAlt && (positionConfig()->altitude_source == DEFAULT || positionConfig()->altitude_source == BARO_ONLY)) {
-            zeroedAltitudeCm = baroAltCm; // use Baro if no GPS data, or we want Baro only
+            verticalEstimatorCorrect(est, gpsZeroedAltCm, sq(gpsStdDevCm));
+            gpsTrust = est->P[0][0] / (est->P[0][0] + sq(gpsStdDevCm)); // last applied GPS weight, for debug only
+        }
+
+        // With no baro and no zeroed GPS nothing bounds the accelerometer prediction, e.g. a GPS only craft armed
+        // without a fix. Hold the altitude from when the last source was lost, 0 if there never was one, as while disarmed.
+        if (useBaro || (haveGpsAlt && useZeroedGpsAltitude && positionConfig()->altitude_source != BARO_ONLY)) {
+            holdingAltitude = false;
+        } else {
+            if (!holdingAltitude) {
+                heldAltitudeCm = est->altitudeCm;
+                holdingAltitude = true;
+            }
+            verticalEstimatorCorrect(est, heldAltitudeCm, est->baroVariance);
         }
     }
 
-    zeroedAltitudeCm = pt2FilterApply(&altitudeLpf, zeroedAltitudeCm);
-    // NOTE: this filter must receive 0 as its input, for the whole disarmed time, to ensure correct zeroed values on arming
+    zeroedAltitudeCm = wasArmed ? est->altitudeCm : 0.0f;
+    zeroedAltitudeDerivative = est->velocityCmS;
 
     if (wasArmed) {
-        displayAltitudeCm = zeroedAltitudeCm; // while armed, show filtered relative altitude in OSD / sensors tab
+        displayAltitudeCm = zeroedAltitudeCm; // while armed, show estimated relative altitude in OSD / sensors tab
+        DEBUG_SET(DEBUG_ALTITUDE, 2, lrintf(zeroedAltitudeCm / 10.0f)); // Relative altitude above takeoff, to 0.1m, rolls over at 3,276.7m
     }
 
-    // *** calculate Vario signal
-    static float previousZeroedAltitudeCm = 0.0f;
-    zeroedAltitudeDerivative = (zeroedAltitudeCm - previousZeroedAltitudeCm) * TASK_ALTITUDE_RATE_HZ; // cm/s
-    previousZeroedAltitudeCm = zeroedAltitudeCm;
-
-    zeroedAltitudeDerivative = pt2FilterApply(&altitudeDerivativeLpf, zeroedAltitudeDerivative);
-
 #ifdef USE_VARIO
     estimatedVario = lrintf(zeroedAltitudeDerivative);
     estimatedVario = applyDeadband(estimatedVario, 10); // ignore climb rates less than 0.1 m/s
@@ -222,6 +345,26 @@ float getAltitude(void)
     return zeroedAltitudeCm;
 }
 
+// Estimated vertical velocity in cm/s, positive up
+float getAltitudeDerivative(void)
+{
+#if defined(USE_BARO) || defined(USE_GPS)
+    return zeroedAltitudeDerivative;
+#else
+    return 0.0f;
+#endif
+}
+
+// One standard deviation of the altitude estimate in cm, 0 when there is no altitude source
+float getAltitudeAccuracyCm(void)
+{
+#if defined(USE_BARO) || defined(USE_GPS)
+    return sqrtf(verticalEstimator.P[0][0]);
+#else
+    return 0.0f;
+#endif
+}
+
 #ifdef USE_VARIO
 int16_t getEstimatedVario(void)
 {
@@ -27,14 +27,18 @@
 typedef struct positionConfig_s {
     uint8_t altitude_source;
     uint8_t altitude_prefer_baro;
-    uint16_t altitude_lpf;                // lowpass cutoff (value / 100) Hz for altitude smoothing
+    uint16_t altitude_baro_noise;         // baro altitude noise, standard deviation in cm
+    uint16_t altitude_acc_noise;          // earth frame Z acceleration noise density, cm/s/s per sqrt(Hz)
     uint16_t altitude_d_lpf;              // lowpass for (value / 100) Hz for altitude derivative smoothing
 } positionConfig_t;
 
 PG_DECLARE(positionConfig_t, positionConfig);
 
 void calculateEstimatedAltitude(void);
+void positionUpdateAcceleration(timeUs_t currentTimeUs);
 void positionInit(void);
 int32_t getEstimatedAltitudeCm(void);
 float getAltitude(void);
+float getAltitudeDerivative(void);
+float getAltitudeAccuracyCm(void);
 int16_t getEstimatedVario(void);
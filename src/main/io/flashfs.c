@@ -41,7 +41,9 @@
 #if defined(USE_FLASHFS)
 
 #include "build/debug.h"
+#include "common/maths.h"
 #include "common/printf.h"
+#include "common/utils.h"
 #include "drivers/flash.h"
 #include "drivers/light_led.h"
 
@@ -58,29 +60,30 @@ static uint32_t flashfsSize = 0;
 static flashfsState_e flashfsState = FLASHFS_IDLE;
 static flashSector_t eraseSectorCurrent = 0;
 
-static DMA_DATA_ZERO_INIT uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_SIZE];
-
-/* The position of our head and tail in the circular flash write buffer.
- *
- * The head is the index that a byte would be inserted into on writing, while the tail is the index of the
- * oldest byte that has yet to be written to flash.
+/* Writes are staged in a pair of buffers so that one can be filled while the other is being programmed. A buffer
+ * never spans a FLASHFS_WRITE_BUFFER_SIZE aligned boundary in the flash address space, so each one is handed to
+ * the flash as a single page program and the next page is already being assembled while the DMA runs.
  *
- * When the circular buffer is empty, head == tail
+ * fillBuffer is the index of the buffer accepting new bytes. It holds fillLen bytes and may accept up to fillLimit,
+ * the distance from its start address to the next buffer boundary.
  *
- * The tail is advanced once a write is complete up to the location behind head. The tail is advanced
- * by a callback from the FLASH write routine. This prevents data being overwritten whilst a write is in progress.
+ * The other buffer holds programLen bytes committed for writing at tailAddress, of which programOffset have been
+ * written so far. It is free when programLen is zero. programOffset and programLen are updated by the write
+ * completion callback, which may be called in ISR context.
  */
-static uint8_t bufferHead = 0;
-static volatile uint8_t bufferTail = 0;
-
-/* Track if there is new data to write. Until the contents of the buffer have been completely
- * written flashfsFlushAsync() will be repeatedly called. The tail pointer is only updated
- * once an asynchronous write has completed. To do so any earlier could result in data being
- * overwritten in the ring buffer. This routine checks that flashfsFlushAsync() should attempt
- * to write new data and avoids it writing old data during the race condition that occurs if
- * its called again before the previous write to FLASH has completed.
-  */
-static volatile bool dataWritten = true;
+static DMA_DATA_ZERO_INIT uint8_t flashWriteBuffer[FLASHFS_WRITE_BUFFER_COUNT][FLASHFS_WRITE_BUFFER_SIZE];
+
+STATIC_ASSERT((FLASHFS_WRITE_BUFFER_SIZE & (FLASHFS_WRITE_BUFFER_SIZE - 1)) == 0, FLASHFS_WRITE_BUFFER_SIZE_not_power_of_2);
+
+static uint8_t fillBuffer = 0;
+static uint16_t fillLen = 0;
+static uint16_t fillLimit = FLASHFS_WRITE_BUFFER_SIZE;
+
+static volatile uint16_t programLen = 0;
+static volatile uint16_t programOffset = 0;
+
+// Set from the start of a page program until its completion callback
+static volatile bool programInFlight = false;
 
 //#define CHECK_FLASH
 
@@ -99,12 +102,14 @@ static uint32_t tailAddress = 0;
 
 static void flashfsClearBuffer(void)
 {
-    bufferTail = bufferHead = 0;
+    programLen = programOffset = 0;
+    fillLen = 0;
+    fillLimit = FLASHFS_WRITE_BUFFER_SIZE - (tailAddress & (FLASHFS_WRITE_BUFFER_SIZE - 1));
 }
 
 static bool flashfsBufferIsEmpty(void)
 {
-    return bufferTail == bufferHead;
+    return programLen == 0 && fillLen == 0;
 }
 
 static void flashfsSetTailAddress(uint32_t address)
@@ -126,9 +131,9 @@ void flashfsEraseCompletely(void)
         }
     }
 
-    flashfsClearBuffer();
-
     flashfsSetTailAddress(0);
+
+    flashfsClearBuffer();
 }
 
 /**
@@ -177,20 +182,12 @@ uint32_t flashfsGetSize(void)
     return flashfsSize;
 }
 
-static uint32_t flashfsTransmitBufferUsed(void)
-{
-    if (bufferHead >= bufferTail)
-        return bufferHead - bufferTail;
-
-    return FLASHFS_WRITE_BUFFER_SIZE - bufferTail + bufferHead;
-}
-
 /**
  * Get the size of the largest single write that flashfs could ever accept without blocking or data loss.
  */
 uint32_t flashfsGetWriteBufferSize(void)
 {
-    return FLASHFS_WRITE_BUFFER_USABLE;
+    return FLASHFS_WRITE_BUFFER_SIZE;
 }
 
 /**
@@ -198,172 +195,147 @@ uint32_t flashfsGetWriteBufferSize(void)
  */
 uint32_t flashfsGetWriteBufferFreeSpace(void)
 {
-    return flashfsGetWriteBufferSize() - flashfsTransmitBufferUsed();
+    // Once the fill buffer is full it is committed and the other buffer, if free, starts on a buffer boundary
+    return (fillLimit - fillLen) + (programLen ? 0 : FLASHFS_WRITE_BUFFER_SIZE);
 }
 
 /**
- * Called after bytes have been written from the buffer to advance the position of the tail by the given amount.
+ * Called once bytes from the committed buffer have been written to flash, possibly in ISR context.
+ *
+ * Advances the file system cursor and frees the committed buffer once all of it has been written.
  */
-static void flashfsAdvanceTailInBuffer(uint32_t delta)
+void flashfsWriteCallback(uint32_t arg)
 {
-    bufferTail += delta;
+    // Advance the cursor in the file system to match the bytes we wrote
+    flashfsSetTailAddress(tailAddress + arg);
 
-    // Wrap tail around the end of the buffer
-    if (bufferTail >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferTail -= FLASHFS_WRITE_BUFFER_SIZE;
+    programOffset += arg;
+    if (programOffset >= programLen) {
+        programLen = programOffset = 0;
     }
+
+    programInFlight = false;
 }
 
 /**
- * Write the given buffers to flash sequentially at the current tail address, advancing the tail address after
- * each write.
- *
- * In synchronous mode, waits for the flash to become ready before writing so that every byte requested can be written.
- *
- * In asynchronous mode, if the flash is busy, then the write is aborted and the routine returns immediately.
- * In this case the returned number of bytes written will be less than the total amount requested.
+ * Hand the fill buffer over for programming and start filling the other one.
  *
- * Modifies the supplied buffer pointers and sizes to reflect how many bytes remain in each of them.
- *
- * bufferCount: the number of buffers provided
- * buffers: an array of pointers to the beginning of buffers
- * bufferSizes: an array of the sizes of those buffers
- * sync: true if we should wait for the device to be idle before writes, otherwise if the device is busy the
- *       write will be aborted and this routine will return immediately.
- *
- * Returns the number of bytes written
+ * Returns false if there is nothing to commit or the other buffer has yet to be written.
  */
-void flashfsWriteCallback(uint32_t arg)
+static bool flashfsCommitFillBuffer(void)
 {
-    // Advance the cursor in the file system to match the bytes we wrote
-    flashfsSetTailAddress(tailAddress + arg);
+    if (programLen || fillLen == 0) {
+        return false;
+    }
+
+    programOffset = 0;
+    programLen = fillLen;
 
-    // Free bytes in the ring buffer
-    flashfsAdvanceTailInBuffer(arg);
+    // The new fill buffer carries on from where the committed one ended, up to the next buffer boundary
+    fillLimit -= fillLen;
+    if (fillLimit == 0) {
+        fillLimit = FLASHFS_WRITE_BUFFER_SIZE;
+    }
+    fillLen = 0;
+    fillBuffer ^= 1;
 
-    // Mark that data has been written from the buffer
-    dataWritten = true;
+    return true;
 }
 
-static uint32_t flashfsWriteBuffers(uint8_t const **buffers, uint32_t *bufferSizes, int bufferCount, bool sync)
+/**
+ * Start programming the committed buffer at the current tail address.
+ *
+ * In synchronous mode, waits for any program in progress and for the flash to become ready before writing.
+ *
+ * In asynchronous mode, if a program is still in progress or the flash is busy the routine returns immediately,
+ * leaving the buffer committed for a later call. The fill buffer is unaffected either way, so callers can keep
+ * adding data while the flash is busy.
+ */
+static void flashfsStartProgram(bool sync)
 {
-    uint32_t bytesWritten;
-
-    // It's OK to overwrite the buffer addresses/lengths being passed in
-
-    // If sync is true, block until the FLASH device is ready, otherwise return 0 if the device isn't ready
     if (sync) {
+        while (programInFlight);
         while (!flashIsReady());
-    } else {
-        if (!flashIsReady()) {
-            return 0;
-        }
+    } else if (programInFlight || !flashIsReady()) {
+        return;
     }
 
-    // Are we at EOF already? Abort.
-    if (flashfsIsEOF()) {
-        return 0;
+    // Nothing committed, or at EOF already? Abort.
+    if (programLen == 0 || flashfsIsEOF()) {
+        return;
     }
 
+    uint8_t const *buffers[1] = { flashWriteBuffer[fillBuffer ^ 1] + programOffset };
+    uint32_t bufferSizes[1] = { programLen - programOffset };
+
 #ifdef CHECK_FLASH
     checkFlashPtr = tailAddress;
+    checkFlashLen = bufferSizes[0];
 #endif
 
-    flashPageProgramBegin(tailAddress, flashfsWriteCallback);
-
-    /* Mark that data has yet to be written. There is no race condition as the DMA engine is known
-     * to be idle at this point
+    /* Mark the program as started before handing it over, some drivers call back before returning. There
+     * is no race condition as no program is in progress at this point.
      */
-    dataWritten = false;
+    programInFlight = true;
 
-    bytesWritten = flashPageProgramContinue(buffers, bufferSizes, bufferCount);
+    flashPageProgramBegin(tailAddress, flashfsWriteCallback);
 
-#ifdef CHECK_FLASH
-    checkFlashLen = bytesWritten;
-#endif
+    flashPageProgramContinue(buffers, bufferSizes, 1);
 
     flashPageProgramFinish();
-
-    return bytesWritten;
 }
 
-/*
- * Since the buffered data might wrap around the end of the circular buffer, we can have two segments of data to write,
- * an initial portion and a possible wrapped portion.
+/**
+ * Commit the fill buffer once it is full and start programming it if the flash is free. Returns true if the fill
+ * buffer has room for more data.
  *
- * This routine will fill the details of those buffers into the provided arrays, which must be at least 2 elements long.
+ * In synchronous mode a full fill buffer waits for the previously committed buffer to be written, so room is only
+ * unavailable once the end of the device is reached.
  */
-static int flashfsGetDirtyDataBuffers(uint8_t const *buffers[], uint32_t bufferSizes[])
+static bool flashfsMakeRoom(bool sync)
 {
-    buffers[0] = flashWriteBuffer + bufferTail;
-    buffers[1] = flashWriteBuffer + 0;
-
-    if (bufferHead > bufferTail) {
-        bufferSizes[0] = bufferHead - bufferTail;
-        bufferSizes[1] = 0;
-        return 1;
-    } else if (bufferHead < bufferTail) {
-        bufferSizes[0] = FLASHFS_WRITE_BUFFER_SIZE - bufferTail;
-        bufferSizes[1] = bufferHead;
-        if (bufferSizes[1] == 0) {
-            return 1;
-        } else {
-            return 2;
-        }
+    if (fillLen < fillLimit) {
+        return true;
     }
 
-    bufferSizes[0] = 0;
-    bufferSizes[1] = 0;
-
-    return 0;
-}
+    if (sync) {
+        while (programLen && !flashfsIsEOF()) {
+            flashfsStartProgram(true);
+        }
+    }
 
+    flashfsCommitFillBuffer();
+    flashfsStartProgram(false);
 
-static bool flashfsNewData(void)
-{
-    return dataWritten;
+    return fillLen < fillLimit;
 }
 
-
 /**
  * Get the current offset of the file pointer within the volume.
  */
 uint32_t flashfsGetOffset(void)
 {
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-
     // Dirty data in the buffers contributes to the offset
-
-    flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-
-    return tailAddress + bufferSizes[0] + bufferSizes[1];
+    return tailAddress + (programLen - programOffset) + fillLen;
 }
 
 /**
  * If the flash is ready to accept writes, flush the buffer to it.
  *
+ * Full buffers are always written, a partially filled buffer only if force is set.
+ *
  * Returns true if all data in the buffer has been flushed to the device, or false if
  * there is still data to be written (call flush again later).
  */
 bool flashfsFlushAsync(bool force)
 {
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-    int bufCount;
-
     if (flashfsBufferIsEmpty()) {
         return true; // Nothing to flush
     }
 
-    if (!flashfsNewData()) {
-        // The previous write has yet to complete
-        return false;
-    }
-
 #ifdef CHECK_FLASH
     // Verify the data written last time
-    if (checkFlashLen) {
+    if (checkFlashLen && !programInFlight) {
         while (!flashIsReady());
         flashReadBytes(checkFlashPtr, checkFlashBuffer, checkFlashLen);
 
@@ -372,40 +344,38 @@ bool flashfsFlushAsync(bool force)
                 checkFlashErrors++; // <-- insert breakpoint here to catch errors
             }
         }
+        checkFlashLen = 0;
     }
 #endif
 
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    uint32_t bufferedBytes = bufferSizes[0] + bufferSizes[1];
+    if (force || fillLen >= fillLimit) {
+        flashfsCommitFillBuffer();
+    }
+
+    flashfsStartProgram(false);
 
-    if (bufCount && (force || (bufferedBytes >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN))) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, false);
+    if (force) {
+        // The program may have completed synchronously, in which case queue the remaining data straight away
+        flashfsCommitFillBuffer();
     }
 
     return flashfsBufferIsEmpty();
 }
 
 /**
- * Wait for the flash to become ready and begin flushing any buffered data to flash.
+ * Wait for the flash to become ready and write all buffered data to flash.
  *
  * The flash will still be busy some time after this sync completes, but space will
  * be freed up to accept more writes in the write buffer.
  */
 void flashfsFlushSync(void)
 {
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-    int bufCount;
-
-    if (flashfsBufferIsEmpty()) {
-        return; // Nothing to flush
-    }
-
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    if (bufCount) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, true);
+    while (!flashfsBufferIsEmpty() && !flashfsIsEOF()) {
+        flashfsCommitFillBuffer();
+        flashfsStartProgram(true);
     }
 
+    while (programInFlight);
     while (!flashIsReady());
 }
 
@@ -436,6 +406,8 @@ void flashfsSeekAbs(uint32_t offset)
     flashfsFlushSync();
 
     flashfsSetTailAddress(offset);
+
+    flashfsClearBuffer();
 }
 
 /**
@@ -447,15 +419,14 @@ void flashfsWriteByte(uint8_t byte)
     byte = checkFlashWrite++;
 #endif
 
-    flashWriteBuffer[bufferHead++] = byte;
-
-    if (bufferHead >= FLASHFS_WRITE_BUFFER_SIZE) {
-        bufferHead = 0;
+    if (!flashfsMakeRoom(false)) {
+        return;
     }
 
-    if (flashfsTransmitBufferUsed() >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN) {
-        flashfsFlushAsync(false);
-    }
+    flashWriteBuffer[fillBuffer][fillLen++] = byte;
+
+    // Start programming a completed page straight away
+    flashfsMakeRoom(false);
 }
 
 /**
@@ -466,27 +437,23 @@ void flashfsWriteByte(uint8_t byte)
  */
 void flashfsWrite(const uint8_t *data, unsigned int len, bool sync)
 {
-    uint8_t const * buffers[2];
-    uint32_t bufferSizes[2];
-    int bufCount;
-    uint32_t totalBufSize;
-
-    // Buffer up the data the user supplied instead of writing it right away
+#ifdef CHECK_FLASH
     for (unsigned int i = 0; i < len; i++) {
         flashfsWriteByte(data[i]);
     }
-
-    // There could be two dirty buffers to write out already:
-    bufCount = flashfsGetDirtyDataBuffers(buffers, bufferSizes);
-    totalBufSize = bufferSizes[0] + bufferSizes[1];
-
-    /*
-     * Would writing this data to our buffer cause our buffer to reach the flush threshold? If so try to write through
-     * to the flash now
-     */
-    if (bufCount && (totalBufSize >= FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN)) {
-        flashfsWriteBuffers(buffers, bufferSizes, bufCount, sync);
+    UNUSED(sync);
+#else
+    while (len > 0 && flashfsMakeRoom(sync)) {
+        const unsigned int chunk = MIN(len, (unsigned int)(fillLimit - fillLen));
+
+        memcpy(&flashWriteBuffer[fillBuffer][fillLen], data, chunk);
+        fillLen += chunk;
+        data += chunk;
+        len -= chunk;
     }
+
+    flashfsMakeRoom(sync);
+#endif
 }
 
 /**
@@ -603,6 +570,7 @@ void flashfsClose(void)
         // Advance tailAddress to next page boundary.
         uint32_t pageSize = flashGeometry->pageSize;
         flashfsSetTailAddress((tailAddress + pageSize - 1) & ~(pageSize - 1));
+        flashfsClearBuffer();
 
         break;
     }
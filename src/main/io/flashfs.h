@@ -20,11 +20,9 @@
 
 #pragma once
 
-#define FLASHFS_WRITE_BUFFER_SIZE 128
-#define FLASHFS_WRITE_BUFFER_USABLE (FLASHFS_WRITE_BUFFER_SIZE - 1)
-
-// Automatically trigger a flush when this much data is in the buffer
-#define FLASHFS_WRITE_BUFFER_AUTO_FLUSH_LEN 64
+// Writes are double buffered, each buffer holds at most one aligned page of FLASHFS_WRITE_BUFFER_SIZE bytes
+#define FLASHFS_WRITE_BUFFER_COUNT 2
+#define FLASHFS_WRITE_BUFFER_SIZE 256
 
 void flashfsEraseCompletely(void);
 void flashfsEraseRange(uint32_t start, uint32_t end);
@@ -95,6 +95,8 @@ uint8_t GPS_svinfo_cno[GPS_SV_MAXSATS_M8N];
 #define GPS_TASK_DECAY_SHIFT 9         // Smoothing factor for GPS task re-scheduler
 
 static serialPort_t *gpsPort;
+static serialRxEvent_t gpsRxEvent;
+static bool gpsRxEventCapable;
 static float gpsDataIntervalSeconds;
 
 typedef struct gpsInitData_s {
@@ -448,6 +450,10 @@ void gpsInit(void)
         return;
     }
 
+    // NMEA sentences end with a newline, UBX frames are caught by the idle line
+    const int16_t delimiter = (gpsConfig()->provider == GPS_NMEA) ? '\n' : -1;
+    gpsRxEventCapable = serialSetRxEvent(gpsPort, &gpsRxEvent, delimiter, gpsPort->rxBufferSize / 2);
+
     // signal GPS "thread" to initialize when it gets to it
     gpsSetState(GPS_STATE_DETECT_BAUD);
     // NB gpsData.state_position is set to zero by gpsSetState(), requesting the fastest baud rate option first time around.
@@ -1324,6 +1330,23 @@ static void updateGpsIndicator(timeUs_t currentTimeUs)
     }
 }
 
+bool gpsUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs)
+{
+    UNUSED(currentTimeUs);
+
+    if (gpsRxEvent.pending) {
+        return true;
+    }
+
+    // Ports which can't raise the event are polled at the fast rate while data is arriving
+    if (gpsPort && !gpsRxEventCapable && currentDeltaTimeUs >= TASK_PERIOD_HZ(TASK_GPS_RATE_FAST) && serialRxBytesWaiting(gpsPort)) {
+        return true;
+    }
+
+    // The state machine and timeouts run at the task rate
+    return currentDeltaTimeUs >= TASK_PERIOD_HZ(TASK_GPS_RATE);
+}
+
 void gpsUpdate(timeUs_t currentTimeUs)
 {
     static timeDelta_t gpsStateDurationFractionUs[GPS_STATE_COUNT];
@@ -1333,28 +1356,16 @@ void gpsUpdate(timeUs_t currentTimeUs)
 
     if (gpsPort) {
         DEBUG_SET(DEBUG_GPS_CONNECTION, 7, serialRxBytesWaiting(gpsPort));
-        static uint8_t wait = 0;
-        static bool isFast = false;
+        gpsRxEvent.pending = false;
         while (serialRxBytesWaiting(gpsPort)) {
-            wait = 0;
-            if (!isFast) {
-                rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(TASK_GPS_RATE_FAST));
-                isFast = true;
-            }
             if (cmpTimeUs(micros(), currentTimeUs) > GPS_RECV_TIME_MAX) {
+                // let other tasks run and come straight back for the rest
+                gpsRxEvent.pending = true;
                 break;
             }
             // Add every byte to _buffer, when enough bytes are received, convert data to values
             gpsNewData(serialRead(gpsPort));
         }
-        if (wait < 1) {
-            wait++;
-        } else if (wait == 1) {
-            wait++;
-            // wait one iteration be sure the buffer is empty, then reset to the slower task interval
-            isFast = false;
-            rescheduleTask(TASK_SELF, TASK_PERIOD_HZ(TASK_GPS_RATE));
-        }
     } else if (gpsConfig()->provider == GPS_MSP) {
         if (GPS_update & GPS_MSP_UPDATE) { // GPS data received via MSP
             if (gpsData.state == GPS_STATE_INITIALIZED) {
@@ -348,7 +348,7 @@ extern uint8_t GPS_svinfo_quality[GPS_SV_MAXSATS_M8N];  // When NumCh is 16 or l
 extern uint8_t GPS_svinfo_cno[GPS_SV_MAXSATS_M8N];      // Carrier to Noise Ratio (Signal Strength)
 
 #define TASK_GPS_RATE       100     // default update rate of GPS task
-#define TASK_GPS_RATE_FAST  500    // update rate of GPS task while Rx buffer is not empty
+#define TASK_GPS_RATE_FAST  500    // update rate of GPS task while Rx buffer is not empty, for ports which can't signal received data
 
 
 #ifdef USE_DASHBOARD
@@ -384,6 +384,7 @@ extern uint32_t dashboardGpsNavSvInfoRcvCount;                  // Count of time
 ubloxVersion_e ubloxParseVersion(const uint32_t version);
 #endif
 void gpsInit(void);
+bool gpsUpdateCheck(timeUs_t currentTimeUs, timeDelta_t currentDeltaTimeUs);
 void gpsUpdate(timeUs_t currentTimeUs);
 bool gpsNewFrame(uint8_t c);
 bool gpsIsHealthy(void); // Returns true when the gps state is RECEIVING_DATA
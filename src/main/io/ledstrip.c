@@ -83,6 +83,10 @@
 
 static bool ledStripEnabled = false;
 static uint8_t previousProfileColorIndex = COLOR_UNDEFINED;
+// cleared whenever the strip colors are written outside of the status layer compositing
+static bool statusCompositeValid = false;
+// the composited colors have not been sent yet, the strip was busy
+static bool statusUpdatePending = false;
 
 #define HZ_TO_US(hz) ((int32_t)((1000 * 1000) / (hz)))
 
@@ -287,6 +291,8 @@ void reevaluateLedConfig(void)
     updateDimensions();
     updateLedRingCounts();
     updateRequiredOverlay();
+
+    statusCompositeValid = false;
 }
 
 // get specialColor by index
@@ -473,8 +479,30 @@ static const struct {
     {0,             LED_MODE_ORIENTATION},
 };
 
-static void applyLedFixedLayers(void)
+// one bit per LED, see LED_STRIP_MAX_LENGTH
+typedef uint64_t ledMask_t;
+
+STATIC_ASSERT(LED_STRIP_MAX_LENGTH <= sizeof(ledMask_t) * 8, ledMask_too_small);
+
+#define LED_MASK(ledIndex) ((ledMask_t)1 << (ledIndex))
+
+// colors of the fixed layers, the base each LED is composited on
+static hsvColor_t fixedLayerColors[LED_STRIP_MAX_LENGTH];
+// LEDs being recomposited this update, layers only write to these
+static ledMask_t compositeMask;
+
+static void setCompositeLedHsv(int ledIndex, const hsvColor_t *color)
 {
+    if (compositeMask & LED_MASK(ledIndex)) {
+        setLedHsv(ledIndex, color);
+    }
+}
+
+// returns the LEDs whose fixed layer color changed
+static ledMask_t applyLedFixedLayers(void)
+{
+    ledMask_t changedMask = 0;
+
     for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
         const ledConfig_t *ledConfig = &ledStripStatusModeConfig()->ledConfigs[ledIndex];
         hsvColor_t color = *getSC(LED_SCOLOR_BACKGROUND);
@@ -541,8 +569,28 @@ static void applyLedFixedLayers(void)
         }
 
         color.h = (color.h + hOffset) % (HSV_HUE_MAX + 1);
-        setLedHsv(ledIndex, &color);
+
+        hsvColor_t *fixedColor = &fixedLayerColors[ledIndex];
+        if (color.h != fixedColor->h || color.s != fixedColor->s || color.v != fixedColor->v) {
+            *fixedColor = color;
+            changedMask |= LED_MASK(ledIndex);
+        }
     }
+
+    return changedMask;
+}
+
+static ledMask_t ledMaskForFlags(uint32_t mask)
+{
+    ledMask_t ledMask = 0;
+
+    for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
+        const ledConfig_t *ledConfig = &ledStripStatusModeConfig()->ledConfigs[ledIndex];
+        if ((*ledConfig & mask) == mask)
+            ledMask |= LED_MASK(ledIndex);
+    }
+
+    return ledMask;
 }
 
 static void applyLedHsv(uint32_t mask, const hsvColor_t *color)
@@ -550,7 +598,7 @@ static void applyLedHsv(uint32_t mask, const hsvColor_t *color)
     for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
         const ledConfig_t *ledConfig = &ledStripStatusModeConfig()->ledConfigs[ledIndex];
         if ((*ledConfig & mask) == mask)
-            setLedHsv(ledIndex, color);
+            setCompositeLedHsv(ledIndex, color);
     }
 }
 
@@ -684,7 +732,7 @@ static void applyLedVtxLayer(bool updateNow, timeUs_t *timer)
                     color.s = HSV(BLACK).s;
                     color.v = HSV(BLACK).v;
                 }
-                setLedHsv(i, &color);
+                setCompositeLedHsv(i, &color);
                 ++vtxLedCount;
             }
         }
@@ -741,9 +789,9 @@ static void applyLedBatteryLayer(bool updateNow, timeUs_t *timer)
 
                 break;
         }
-    }
 
-    *timer += timerDelayUs;
+        *timer += timerDelayUs;
+    }
 
     if (!flash) {
        const hsvColor_t *bgc = getSC(LED_SCOLOR_BACKGROUND);
@@ -770,9 +818,9 @@ static void applyLedRssiLayer(bool updateNow, timeUs_t *timer)
             flash = !flash;
             timerDelay = HZ_TO_US(8);
         }
-    }
 
-    *timer += timerDelay;
+        *timer += timerDelay;
+    }
 
     if (!flash) {
         const hsvColor_t *bgc = getSC(LED_SCOLOR_BACKGROUND);
@@ -858,7 +906,7 @@ static void applyLedIndicatorLayer(bool updateNow, timeUs_t *timer)
         const ledConfig_t *ledConfig = &ledStripStatusModeConfig()->ledConfigs[ledIndex];
         if (ledGetOverlayBit(ledConfig, LED_OVERLAY_INDICATOR)) {
             if (getLedQuadrant(ledIndex) & quadrants)
-                setLedHsv(ledIndex, flashColor);
+                setCompositeLedHsv(ledIndex, flashColor);
         }
     }
 }
@@ -888,7 +936,7 @@ static void applyLedThrustRingLayer(bool updateNow, timeUs_t *timer)
 
             if (applyColor) {
                 const hsvColor_t *ringColor = &ledStripStatusModeConfig()->colors[ledGetColor(ledConfig)];
-                setLedHsv(ledIndex, ringColor);
+                setCompositeLedHsv(ledIndex, ringColor);
             }
 
             ledRingIndex++;
@@ -914,7 +962,7 @@ static void applyRainbowLayer(bool updateNow, timeUs_t *timer)
             ledColor.h = (offset / TASK_LEDSTRIP_RATE_HZ + rainbowLedIndex * ledStripConfig()->ledstrip_rainbow_delta) % (HSV_HUE_MAX + 1);
             ledColor.s = 0;
             ledColor.v = HSV_VALUE_MAX;
-            setLedHsv(i, &ledColor);
+            setCompositeLedHsv(i, &ledColor);
             rainbowLedIndex++;
         }
     }
@@ -976,7 +1024,7 @@ static void applyLarsonScannerLayer(bool updateNow, timeUs_t *timer)
             hsvColor_t ledColor;
             getLedHsv(i, &ledColor);
             ledColor.v = brightnessForLarsonIndex(&larsonParameters, scannerLedIndex);
-            setLedHsv(i, &ledColor);
+            setCompositeLedHsv(i, &ledColor);
             scannerLedIndex++;
         }
     }
@@ -1002,7 +1050,7 @@ static void applyLedBlinkLayer(bool updateNow, timeUs_t *timer)
             const ledConfig_t *ledConfig = &ledStripStatusModeConfig()->ledConfigs[i];
 
             if (ledGetOverlayBit(ledConfig, LED_OVERLAY_BLINK)) {
-                setLedHsv(i, getSC(LED_SCOLOR_BLINKBACKGROUND));
+                setCompositeLedHsv(i, getSC(LED_SCOLOR_BLINKBACKGROUND));
             }
         }
     }
@@ -1029,6 +1077,8 @@ typedef enum {
 
 static timeUs_t timerVal[timTimerCount];
 static uint16_t disabledTimerMask;
+// LEDs each layer can write to
+static ledMask_t layerLedMask[timTimerCount];
 
 STATIC_ASSERT(timTimerCount <= sizeof(disabledTimerMask) * 8, disabledTimerMask_too_small);
 
@@ -1078,6 +1128,28 @@ void updateRequiredOverlay(void)
     disabledTimerMask |= !isOverlayTypeUsed(LED_OVERLAY_VTX) << timVtx;
 #endif
     disabledTimerMask |= !isOverlayTypeUsed(LED_OVERLAY_INDICATOR) << timIndicator;
+
+    // matches the LEDs written by each layer
+    layerLedMask[timRainbow] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_RAINBOW)));
+    layerLedMask[timBlink] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_BLINK)));
+    layerLedMask[timLarson] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_LARSON_SCANNER)));
+    layerLedMask[timIndicator] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_INDICATOR)));
+    layerLedMask[timWarning] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_WARNING)));
+#ifdef USE_VTX_COMMON
+    layerLedMask[timVtx] = ledMaskForFlags(LED_MOV_OVERLAY(LED_FLAG_OVERLAY(LED_OVERLAY_VTX)));
+#endif
+#ifdef USE_GPS
+    layerLedMask[timGps] = ledMaskForFlags(LED_MOV_FUNCTION(LED_FUNCTION_GPS));
+#endif
+    layerLedMask[timBattery] = ledMaskForFlags(LED_MOV_FUNCTION(LED_FUNCTION_BATTERY));
+    layerLedMask[timRssi] = ledMaskForFlags(LED_MOV_FUNCTION(LED_FUNCTION_RSSI));
+
+    layerLedMask[timRing] = 0;
+    for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
+        if (ledGetFunction(&ledStripStatusModeConfig()->ledConfigs[ledIndex]) == LED_FUNCTION_THRUST_RING) {
+            layerLedMask[timRing] |= LED_MASK(ledIndex);
+        }
+    }
 }
 
 static void applyStatusProfile(timeUs_t now)
@@ -1100,19 +1172,50 @@ static void applyStatusProfile(timeUs_t now)
         }
     }
 
-    if (!timActive) {
+    if (!timActive && statusCompositeValid && !statusUpdatePending) {
         // Call schedulerIgnoreTaskExecTime() unless data is being processed
         schedulerIgnoreTaskExecTime();
         return;          // no change this update, keep old state
     }
 
-    applyLedFixedLayers();
+    // Only the LEDs whose fixed color changed, or which are covered by a triggered layer, are recomposited
+    ledMask_t dirtyMask = applyLedFixedLayers();
+    if (!statusCompositeValid) {
+        dirtyMask = ~(ledMask_t)0;
+        statusCompositeValid = true;
+    }
+    for (timId_e timId = 0; timId < timTimerCount; timId++) {
+        if (timActive & (1 << timId)) {
+            dirtyMask |= layerLedMask[timId];
+        }
+    }
+    compositeMask = dirtyMask;
+
+    for (int ledIndex = 0; ledIndex < ledCounts.count; ledIndex++) {
+        if (dirtyMask & LED_MASK(ledIndex)) {
+            setLedHsv(ledIndex, &fixedLayerColors[ledIndex]);
+        }
+    }
+
+    // triggered layers always run to update their state, the others only to redraw recomposited LEDs
     for (timId_e timId = 0; timId < ARRAYLEN(layerTable); timId++) {
         uint32_t *timer = &timerVal[timId];
         bool updateNow = timActive & (1 << timId);
-        (*layerTable[timId])(updateNow, timer);
+        if (updateNow || (layerLedMask[timId] & dirtyMask)) {
+            (*layerTable[timId])(updateNow, timer);
+        }
+    }
+
+    static uint8_t compositeFormat;
+    static uint8_t compositeBrightness;
+    const uint8_t format = ledStripConfig()->ledstrip_grb_rgb;
+    const uint8_t brightness = ledStripConfig()->ledstrip_brightness;
+    if (dirtyMask || format != compositeFormat || brightness != compositeBrightness || statusUpdatePending) {
+        // the colors stay in the LED buffer, so a skipped update only needs sending again
+        statusUpdatePending = !ws2811UpdateStrip((ledStripFormatRGB_e)format, brightness);
+        compositeFormat = format;
+        compositeBrightness = brightness;
     }
-    ws2811UpdateStrip((ledStripFormatRGB_e) ledStripConfig()->ledstrip_grb_rgb, ledStripConfig()->ledstrip_brightness);
 }
 
 bool parseColor(int index, const char *colorConfig)
@@ -1200,6 +1303,8 @@ void ledStripDisable(void)
     ledStripEnabled = false;
     previousProfileColorIndex = COLOR_UNDEFINED;
 
+    statusCompositeValid = false;
+
     setStripColor(&HSV(BLACK));
     ws2811UpdateStrip((ledStripFormatRGB_e)ledStripConfig()->ledstrip_grb_rgb, ledStripConfig()->ledstrip_brightness);
 }
@@ -1274,6 +1379,8 @@ static void applySimpleProfile(timeUs_t currentTimeUs)
     }
 
     if ((colorIndex != previousProfileColorIndex) || (currentTimeUs >= colorUpdateTimeUs)) {
+        statusCompositeValid = false;
+
         setStripColor(&hsv[colorIndex]);
         ws2811UpdateStrip((ledStripFormatRGB_e)ledStripConfig()->ledstrip_grb_rgb, ledStripConfig()->ledstrip_brightness);
         previousProfileColorIndex = colorIndex;
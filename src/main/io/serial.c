@@ -507,6 +507,7 @@ void closeSerialPort(serialPort_t *serialPort)
 
     // TODO wait until data has been transmitted.
     serialPort->rxCallback = NULL;
+    serialPort->rxEvent = NULL;
 
     serialPortUsage->function = FUNCTION_NONE;
     serialPortUsage->serialPort = NULL;
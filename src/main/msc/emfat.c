@@ -30,6 +30,7 @@
 
 #include "platform.h"
 
+#include "common/maths.h"
 #include "common/utils.h"
 
 #include "emfat.h"
@@ -400,21 +401,22 @@ void read_boot_sector(const emfat_t *emfat, uint8_t *sect)
 
 emfat_entry_t *find_entry(const emfat_t *emfat, uint32_t clust, emfat_entry_t *nearest)
 {
-    if (nearest == NULL) {
-        nearest = emfat->priv.entries;
+    if (nearest != NULL && IS_CLUST_OF(clust, nearest)) {
+        return nearest;
     }
 
-    if (nearest->priv.first_clust > clust) {
-        while (nearest >= emfat->priv.entries) { // backward finding
-            if (IS_CLUST_OF(clust, nearest))
-                return nearest;
-            nearest--;
-        }
-    } else {
-        while (nearest->name != NULL) { // forward finding
-            if (IS_CLUST_OF(clust, nearest))
-                return nearest;
-            nearest++;
+    // emfat_init() allocates each entry a contiguous range of clusters in ascending order
+    int low = 0;
+    int high = emfat->priv.num_entries - 1;
+    while (low <= high) {
+        const int mid = (low + high) / 2;
+        emfat_entry_t *entry = &emfat->priv.entries[mid];
+        if (clust < entry->priv.first_clust) {
+            high = mid - 1;
+        } else if (clust > entry->priv.last_reserved) {
+            low = mid + 1;
+        } else {
+            return entry;
         }
     }
     return NULL;
@@ -456,24 +458,21 @@ void read_fat_sector(emfat_t *emfat, uint8_t *sect, uint32_t index)
 
     le = emfat->priv.last_entry;
     while (count != 0) {
-        if (!IS_CLUST_OF(curr, le)) {
-            le = find_entry(emfat, curr, le);
-            if (le == NULL) {
-                le = emfat->priv.last_entry;
-                *values = CLUST_RESERVED;
-                values++;
+        emfat_entry_t *entry = find_entry(emfat, curr, le);
+        if (entry == NULL) {
+            // no entries follow the last one, the rest of the sector is unallocated
+            while (count != 0) {
+                *values++ = CLUST_RESERVED;
                 count--;
-                curr++;
-                continue;
             }
+            break;
         }
-        if (le->dir) {
-            if (curr == le->priv.last_clust) {
-                *values = CLUST_EOF;
-            } else {
-                *values = curr + 1;
-            }
-        } else {
+        le = entry;
+
+        // fill the run of clusters held by this entry, directories are never reserved beyond their last cluster
+        uint32_t run = MIN(count, le->priv.last_reserved - curr + 1);
+        count -= run;
+        while (run != 0) {
             if (curr == le->priv.last_clust) {
                 *values = CLUST_EOF;
             } else if (curr > le->priv.last_clust) {
@@ -481,10 +480,10 @@ void read_fat_sector(emfat_t *emfat, uint8_t *sect, uint32_t index)
             } else {
                 *values = curr + 1;
             }
+            values++;
+            run--;
+            curr++;
         }
-        values++;
-        count--;
-        curr++;
     }
     emfat->priv.last_entry = le;
 }
@@ -600,46 +599,62 @@ void fill_dir_sector(emfat_t *emfat, uint8_t *data, emfat_entry_t *entry, uint32
     }
 }
 
-void read_data_sector(emfat_t *emfat, uint8_t *data, uint32_t rel_sect)
+// returns the number of consecutive sectors read, file data is read up to the end of the entry in a single callback
+int read_data_sectors(emfat_t *emfat, uint8_t *data, uint32_t rel_sect, int num_sectors)
 {
     emfat_entry_t *le;
     uint32_t cluster;
     cluster = rel_sect / 8 + 2;
     rel_sect = rel_sect % 8;
 
-    le = emfat->priv.last_entry;
-    if (!IS_CLUST_OF(cluster, le)) {
-        le = find_entry(emfat, cluster, le);
-        if (le == NULL) {
-            int i;
-            for (i = 0; i < SECT / 4; i++)
-                ((uint32_t *)data)[i] = 0xEFBEADDE;
-            return;
-        }
-        emfat->priv.last_entry = le;
+    le = find_entry(emfat, cluster, emfat->priv.last_entry);
+    if (le == NULL) {
+        int i;
+        for (i = 0; i < SECT / 4; i++)
+            ((uint32_t *)data)[i] = 0xEFBEADDE;
+        return 1;
     }
+    emfat->priv.last_entry = le;
 
     if (le->dir) {
         fill_dir_sector(emfat, data, le, rel_sect);
-        return;
+        return 1;
     }
 
+    const uint32_t entry_sectors = (le->priv.last_reserved - cluster) * SECT_PER_CLUST + SECT_PER_CLUST - rel_sect;
+    const int count = MIN((uint32_t)num_sectors, entry_sectors);
+
     if (le->readcb == NULL) {
-        memset(data, 0, SECT);
+        memset(data, 0, count * SECT);
     } else {
         uint32_t offset = cluster - le->priv.first_clust;
-        offset = offset * CLUST + rel_sect * SECT;
-        le->readcb(data, SECT, offset + le->offset, le);
+        offset = offset * CLUST + rel_sect * SECT + le->offset;
+        // the callback may stop short, e.g. at a flash page boundary, so keep asking until the sectors are filled
+        int remaining = count * SECT;
+        while (remaining > 0) {
+            const int bytesRead = le->readcb(data, remaining, offset, le);
+            if (bytesRead <= 0) {
+                memset(data, 0, remaining);
+                break;
+            }
+            data += bytesRead;
+            offset += bytesRead;
+            remaining -= bytesRead;
+        }
     }
 
-    return;
+    return count;
 }
 
 void emfat_read(emfat_t *emfat, uint8_t *data, uint32_t sector, int num_sectors)
 {
     while (num_sectors > 0) {
         if (sector >= emfat->priv.root_lba) {
-            read_data_sector(emfat, data, sector - emfat->priv.root_lba);
+            const int count = read_data_sectors(emfat, data, sector - emfat->priv.root_lba, num_sectors);
+            data += count * SECT;
+            num_sectors -= count;
+            sector += count;
+            continue;
         } else if (sector == 0) {
             read_mbr_sector(emfat, data);
         } else if (sector == emfat->priv.fsinfo_lba) {
@@ -666,13 +681,9 @@ void write_data_sector(emfat_t *emfat, const uint8_t *data, uint32_t rel_sect)
     cluster = rel_sect / 8 + 2;
     rel_sect = rel_sect % 8;
 
-    le = emfat->priv.last_entry;
-
-    if (!IS_CLUST_OF(cluster, le)) {
-        le = find_entry(emfat, cluster, le);
-        if (le == NULL) return;
-        emfat->priv.last_entry = le;
-    }
+    le = find_entry(emfat, cluster, emfat->priv.last_entry);
+    if (le == NULL) return;
+    emfat->priv.last_entry = le;
 
     if (le->dir) {
         // TODO: handle changing a filesize
@@ -40,7 +40,8 @@ extern "C" {
 #endif
 
 struct emfat_entry_s;
-typedef void (*emfat_readcb_t)(uint8_t *dest, int size, uint32_t offset, struct emfat_entry_s *entry);
+// returns the number of bytes read, which may be fewer than asked for
+typedef int (*emfat_readcb_t)(uint8_t *dest, int size, uint32_t offset, struct emfat_entry_s *entry);
 typedef void (*emfat_writecb_t)(const uint8_t *data, int size, uint32_t offset, struct emfat_entry_s *entry);
 
 typedef struct emfat_entry_s {
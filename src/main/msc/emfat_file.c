@@ -228,12 +228,12 @@ static const char icon_file[] =
 #define CMA { CMA_TIME, CMA_TIME, CMA_TIME }
 
 #if defined(USE_EMFAT_AUTORUN) || defined(USE_EMFAT_ICON) || defined(USE_EMFAT_README)
-static void memory_read_proc(uint8_t *dest, int size, uint32_t offset, emfat_entry_t *entry)
+static int memory_read_proc(uint8_t *dest, int size, uint32_t offset, emfat_entry_t *entry)
 {
     int len;
 
-    if (offset > entry->curr_size) {
-        return;
+    if (offset >= entry->curr_size) {
+        return 0;
     }
 
     if (offset + size > entry->curr_size) {
@@ -243,14 +243,15 @@ static void memory_read_proc(uint8_t *dest, int size, uint32_t offset, emfat_ent
     }
 
     memcpy(dest, &((char *)entry->user_data)[offset], len);
+    return len;
 }
 #endif
 
-static void bblog_read_proc(uint8_t *dest, int size, uint32_t offset, emfat_entry_t *entry)
+static int bblog_read_proc(uint8_t *dest, int size, uint32_t offset, emfat_entry_t *entry)
 {
     UNUSED(entry);
 
-    flashfsReadAbs(offset, dest, size);
+    return flashfsReadAbs(offset, dest, size);
 }
 
 static const emfat_entry_t entriesPredefined[] =
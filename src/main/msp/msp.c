@@ -33,6 +33,7 @@
 
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/trace.h"
 #include "build/version.h"
 
 #include "cli/cli.h"
@@ -66,6 +67,7 @@
 #include "drivers/sdcard.h"
 #include "drivers/serial.h"
 #include "drivers/serial_escserial.h"
+#include "drivers/stack_check.h"
 #include "drivers/system.h"
 #include "drivers/transponder_ir.h"
 #include "drivers/usb_msc.h"
@@ -73,6 +75,7 @@
 #include "drivers/vtx_table.h"
 
 #include "fc/board_info.h"
+#include "fc/boot.h"
 #include "fc/controlrate_profile.h"
 #include "fc/core.h"
 #include "fc/dispatch.h"
@@ -119,6 +122,7 @@
 
 #include "pg/beeper.h"
 #include "pg/board.h"
+#include "pg/boot.h"
 #include "pg/dyn_notch.h"
 #include "pg/gyrodev.h"
 #include "pg/motor.h"
@@ -241,6 +245,8 @@ static bool mspIsMspArmingEnabled(void)
 
 #define MSP_PASSTHROUGH_ESC_4WAY 0xff
 
+#define MSP_TRACE_RECORDS_MAX 32    // 256 bytes of records fits the minimum MSP output buffer
+
 static uint8_t mspPassthroughMode;
 static uint8_t mspPassthroughArgument;
 
@@ -407,7 +413,7 @@ void mspReboot(dispatchEntry_t* self)
 
 dispatchEntry_t mspRebootEntry =
 {
-    mspReboot, 0, NULL, false
+    .dispatch = mspReboot,
 };
 
 void writeReadEeprom(dispatchEntry_t* self)
@@ -431,7 +437,7 @@ void writeReadEeprom(dispatchEntry_t* self)
 
 dispatchEntry_t writeReadEepromEntry =
 {
-    writeReadEeprom, 0, NULL, false
+    .dispatch = writeReadEeprom,
 };
 
 static void serializeSDCardSummaryReply(sbuf_t *dst)
@@ -1329,6 +1335,31 @@ case MSP_NAME:
         }
 #endif
 
+#if defined(USE_BOOT_PROFILE)
+    case MSP2_GET_BOOT_PROFILE:
+        // fast boot flag, phase count, then the time in us since power on at the end of each phase, 0 if not reached yet
+        sbufWriteU8(dst, bootConfig()->fastBoot);
+        sbufWriteU8(dst, BOOT_PHASE_COUNT);
+        for (bootPhase_e phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+            sbufWriteU32(dst, bootProfileGetPhaseEndUs(phase));
+        }
+        break;
+#endif
+
+#if defined(USE_STACK_CHECK)
+    case MSP2_GET_STACK_USAGE:
+        // stack size, stack used, task count, then the peak stack use of each task in bytes, 0 if not sampled yet
+        sbufWriteU16(dst, stackTotalSize());
+        sbufWriteU16(dst, stackUsedSize());
+        sbufWriteU8(dst, TASK_COUNT);
+        for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
+            taskInfo_t taskInfo;
+            getTaskInfo(taskId, &taskInfo);
+            sbufWriteU16(dst, taskInfo.stackPeakBytes);
+        }
+        break;
+#endif
+
     case MSP_RC:
         for (int i = 0; i < rxRuntimeState.channelCount; i++) {
             sbufWriteU16(dst, rcData[i]);
@@ -2573,6 +2604,50 @@ static mspResult_e mspFcProcessOutCommandWithArg(mspDescriptor_t srcDesc, int16_
             }
         }
         break;
+#if defined(USE_TRACE)
+    case MSP2_GET_TRACE:
+        {
+            // request is the sequence number of the first record wanted. Reply is cycles per us,
+            // the sequence number of the first record returned, the record count and then the records
+            uint32_t sequence = sbufBytesRemaining(src) >= 4 ? sbufReadU32(src) : 0;
+            traceRecord_t records[MSP_TRACE_RECORDS_MAX];
+            const unsigned count = traceGetRecords(&sequence, records, ARRAYLEN(records));
+
+            sbufWriteU32(dst, clockMicrosToCycles(1));
+            sbufWriteU32(dst, sequence);
+            sbufWriteU8(dst, count);
+            for (unsigned i = 0; i < count; i++) {
+                sbufWriteU32(dst, records[i].cycles);
+                sbufWriteU8(dst, records[i].type);
+                sbufWriteU8(dst, records[i].id);
+                sbufWriteU16(dst, records[i].arg);
+            }
+        }
+        break;
+#endif
+#if defined(USE_TASK_HISTOGRAMS)
+    case MSP2_GET_TASK_HISTOGRAM:
+        {
+            // task id, bucket count, then the execution time and start latency buckets
+            const taskId_e taskId = sbufBytesRemaining(src) ? sbufReadU8(src) : TASK_COUNT;
+            if (taskId >= TASK_COUNT) {
+                return MSP_RESULT_ERROR;
+            }
+
+            taskHistogram_t histogram;
+            getTaskHistogram(taskId, &histogram);
+
+            sbufWriteU8(dst, taskId);
+            sbufWriteU8(dst, TASK_HISTOGRAM_BUCKET_COUNT);
+            for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+                sbufWriteU16(dst, histogram.execTime[i]);
+            }
+            for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+                sbufWriteU16(dst, histogram.startLatency[i]);
+            }
+        }
+        break;
+#endif
 #ifdef USE_LED_STRIP
     case MSP2_GET_LED_STRIP_CONFIG_VALUES:
         sbufWriteU8(dst, ledStripConfig()->ledstrip_brightness);
@@ -3969,6 +4044,20 @@ static mspResult_e mspProcessInCommand(mspDescriptor_t srcDesc, int16_t cmdMSP,
         break;
 #endif
 #endif // USE_BOARD_INFO
+#if defined(USE_TASK_HISTOGRAMS)
+    case MSP2_RESET_TASK_HISTOGRAMS:
+        {
+            // optional task id, all tasks are reset if absent
+            const taskId_e taskId = sbufBytesRemaining(src) ? sbufReadU8(src) : TASK_COUNT;
+            for (taskId_e i = 0; i < TASK_COUNT; i++) {
+                if (taskId == TASK_COUNT || taskId == i) {
+                    schedulerResetTaskHistogram(i);
+                }
+            }
+        }
+
+        break;
+#endif
 #if defined(USE_RX_BIND)
     case MSP2_BETAFLIGHT_BIND:
         if (!startRxBind()) {
@@ -28,6 +28,11 @@
 #define MSP2_SET_TEXT                       0x3007
 #define MSP2_GET_LED_STRIP_CONFIG_VALUES    0x3008
 #define MSP2_SET_LED_STRIP_CONFIG_VALUES    0x3009
+#define MSP2_GET_TASK_HISTOGRAM             0x300A  // returns execution time and start latency histograms for a task
+#define MSP2_RESET_TASK_HISTOGRAMS          0x300B
+#define MSP2_GET_TRACE                      0x300C  // returns records from the hot path trace ring
+#define MSP2_GET_BOOT_PROFILE               0x300D  // returns the end time of each boot phase
+#define MSP2_GET_STACK_USAGE                0x300E  // returns the stack high-water mark and the peak stack use of each task
 
 // MSP2_SET_TEXT and MSP2_GET_TEXT variable types
 #define MSP2TEXT_PILOT_NAME                      1
@@ -44,6 +44,11 @@
 
 static mspPort_t mspPorts[MAX_MSP_PORT_COUNT];
 
+// Raised by the MSP ports when a request may have arrived, shared by all ports
+static serialRxEvent_t mspRxEvent;
+// Set once a port has been allocated that can't raise mspRxEvent
+static bool mspPollRequired;
+
 static void resetMspPort(mspPort_t *mspPortToReset, serialPort_t *serialPort, bool sharedWithTelemetry)
 {
     memset(mspPortToReset, 0, sizeof(mspPort_t));
@@ -76,6 +81,11 @@ void mspSerialAllocatePorts(void)
             bool sharedWithTelemetry = isSerialPortShared(portConfig, FUNCTION_MSP, TELEMETRY_PORT_FUNCTIONS_MASK);
             resetMspPort(mspPort, serialPort, sharedWithTelemetry);
 
+            // MSP frames carry no delimiter so rely on the idle line, the watermark wakes the task before the buffer fills
+            if (!serialSetRxEvent(serialPort, &mspRxEvent, -1, serialPort->rxBufferSize / 2)) {
+                mspPollRequired = true;
+            }
+
             portIndex++;
         }
 
@@ -503,6 +513,18 @@ static void mspSerialProcessReceivedReply(mspPort_t *msp, mspProcessReplyFnPtr m
     msp->c_state = MSP_IDLE;
 }
 
+// Returns true once the byte completes a command
+static bool mspSerialProcessReceivedByte(mspPort_t *mspPort, uint8_t c, mspEvaluateNonMspData_e evaluateNonMspData)
+{
+    const bool consumed = mspSerialProcessReceivedData(mspPort, c);
+
+    if (!consumed && evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA) {
+        mspEvaluateNonMspData(mspPort, c);
+    }
+
+    return mspPort->c_state == MSP_COMMAND_RECEIVED;
+}
+
 /*
  * Process MSP commands from serial ports configured as MSP ports.
  *
@@ -524,14 +546,22 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
             mspPort->pendingRequest = MSP_PENDING_NONE;
 
             while (serialRxBytesWaiting(mspPort->port)) {
-                const uint8_t c = serialRead(mspPort->port);
-                const bool consumed = mspSerialProcessReceivedData(mspPort, c);
-
-                if (!consumed && evaluateNonMspData == MSP_EVALUATE_NON_MSP_DATA) {
-                    mspEvaluateNonMspData(mspPort, c);
+                // Scan the contiguous receive buffer in place where the driver allows it, otherwise read a byte at a time
+                const uint8_t *data;
+                uint32_t count = serialRxSpan(mspPort->port, &data);
+                uint32_t consumed = 0;
+                bool commandReceived = false;
+
+                if (count) {
+                    while (consumed < count && !commandReceived) {
+                        commandReceived = mspSerialProcessReceivedByte(mspPort, data[consumed++], evaluateNonMspData);
+                    }
+                    serialRxConsume(mspPort->port, consumed);
+                } else {
+                    commandReceived = mspSerialProcessReceivedByte(mspPort, serialRead(mspPort->port), evaluateNonMspData);
                 }
 
-                if (mspPort->c_state == MSP_COMMAND_RECEIVED) {
+                if (commandReceived) {
                     if (mspPort->packetType == MSP_PACKET_COMMAND) {
                         mspPostProcessFn = mspSerialProcessReceivedCommand(mspPort, mspProcessCommandFn);
                     } else if (mspPort->packetType == MSP_PACKET_REPLY) {
@@ -550,9 +580,40 @@ void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessComm
         } else {
             mspProcessPendingRequest(mspPort);
         }
+
+        // Only one command is processed per call, come back for the rest
+        if (mspPort->port && serialRxBytesWaiting(mspPort->port)) {
+            mspRxEvent.pending = true;
+        }
     }
 }
 
+bool mspSerialRxEventPending(void)
+{
+    return mspRxEvent.pending;
+}
+
+void mspSerialRxEventClear(void)
+{
+    mspRxEvent.pending = false;
+}
+
+bool mspSerialPollRequired(void)
+{
+    if (mspPollRequired) {
+        return true;
+    }
+
+    // Pending requests wait out their guard time at the polling rate
+    for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
+        if (mspPorts[portIndex].port && mspPorts[portIndex].pendingRequest != MSP_PENDING_NONE) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool mspSerialWaiting(void)
 {
     for (uint8_t portIndex = 0; portIndex < MAX_MSP_PORT_COUNT; portIndex++) {
@@ -571,6 +632,7 @@ bool mspSerialWaiting(void)
 void mspSerialInit(void)
 {
     memset(mspPorts, 0, sizeof(mspPorts));
+    mspPollRequired = false;
     mspSerialAllocatePorts();
 }
 
@@ -116,6 +116,10 @@ typedef struct mspPort_s {
 
 void mspSerialInit(void);
 bool mspSerialWaiting(void);
+// Event driven processing of the MSP ports, ports which can't signal received data have to be polled
+bool mspSerialRxEventPending(void);
+void mspSerialRxEventClear(void);
+bool mspSerialPollRequired(void);
 void mspSerialProcess(mspEvaluateNonMspData_e evaluateNonMspData, mspProcessCommandFnPtr mspProcessCommandFn, mspProcessReplyFnPtr mspProcessReplyFn);
 void mspSerialAllocatePorts(void);
 void mspSerialReleasePortIfAllocated(struct serialPort_s *serialPort);
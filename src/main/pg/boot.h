@@ -0,0 +1,37 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "pg/pg.h"
+#include "pg/gyrodev.h"
+
+// Hardware found on the last boot. With fast_boot on, detection tries it before probing for anything else
+// and init which is not needed to fly is deferred until the scheduler has started.
+typedef struct bootConfig_s {
+    uint8_t fastBoot;
+    uint8_t gyroSpiDetectHint[MAX_GYRODEV_COUNT];   // gyro SPI detection table entry + 1 which found the gyro, 0 if unknown
+    uint8_t baroHardware;                           // baroSensor_e, BARO_DEFAULT if unknown
+    uint8_t osdDisplayPortDevice;                   // osdDisplayPortDevice_e, OSD_DISPLAYPORT_DEVICE_NONE if unknown, kept with the next config save
+} bootConfig_t;
+
+PG_DECLARE(bootConfig_t, bootConfig);
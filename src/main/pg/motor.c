@@ -44,7 +44,7 @@
 #define DEFAULT_DSHOT_BURST DSHOT_DMAR_OFF
 #endif
 
-PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 2);
+PG_REGISTER_WITH_RESET_FN(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 3);
 
 void pgResetFn_motorConfig(motorConfig_t *motorConfig)
 {
@@ -69,6 +69,7 @@ void pgResetFn_motorConfig(motorConfig_t *motorConfig)
     motorConfig->mincommand = 1000;
     motorConfig->digitalIdleOffsetValue = 550;
     motorConfig->kv = 1960;
+    motorConfig->motorOutputPhaseUs = 0; // the phase hold busy waits in the PID task, off unless asked for
 
 #ifdef USE_TIMER
 #ifdef MOTOR1_PIN
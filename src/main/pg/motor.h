@@ -60,6 +60,7 @@ typedef struct motorConfig_s {
     uint16_t mincommand;                    // This is the value for the ESCs when they are not armed. In some cases, this value must be lowered down to 900 for some specific ESCs
     uint16_t kv;                            // Motor velocity constant (Kv) to estimate RPM under no load (unloadedRpm = Kv * batteryVoltage)
     uint8_t motorPoleCount;                 // Number of magnetic poles in the motor bell for calculating actual RPM from eRPM provided by ESC telemetry
+    uint16_t motorOutputPhaseUs;            // Time from the start of the PID loop cycle to the start of the motor output transfer, 0 to send as soon as mixed
 } motorConfig_t;
 
 PG_DECLARE(motorConfig_t, motorConfig);
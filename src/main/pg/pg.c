@@ -28,15 +28,69 @@
 #include "common/maths.h"
 
 #include "pg.h"
+#include "pg_ids.h"
 
-const pgRegistry_t* pgFind(pgn_t pgn)
+// Registry position of every PGN up to PG_BETAFLIGHT_END, PG_INDEX_NONE if it is not registered.
+// The registry is only known at link time, so the index is built on first use.
+// PGNs above that range (OSD, testing) are few and kept in a short list instead.
+#define PG_INDEX_NONE 0xff
+#define PG_DIRECT_INDEX_SIZE (PG_BETAFLIGHT_END + 1)
+#define PG_OTHER_INDEX_SIZE 8
+
+static uint8_t pgDirectIndex[PG_DIRECT_INDEX_SIZE];
+static uint8_t pgOtherIndex[PG_OTHER_INDEX_SIZE];
+static uint8_t pgOtherIndexCount;
+static bool pgIndexValid = false;
+
+static bool pgBuildIndex(void)
 {
-    PG_FOREACH(reg) {
-        if (pgN(reg) == pgn) {
-            return reg;
+    memset(pgDirectIndex, PG_INDEX_NONE, sizeof(pgDirectIndex));
+    pgOtherIndexCount = 0;
+    for (int i = 0; i < PG_REGISTRY_SIZE; i++) {
+        const pgn_t pgn = pgN(&__pg_registry_start[i]);
+        if (pgn < PG_DIRECT_INDEX_SIZE) {
+            pgDirectIndex[pgn] = i;
+        } else if (pgOtherIndexCount < PG_OTHER_INDEX_SIZE) {
+            pgOtherIndex[pgOtherIndexCount++] = i;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Returns the position of the PG in the registry, or -1 if it is not registered
+int pgRegistryIndex(pgn_t pgn)
+{
+    if (!pgIndexValid) {
+        // a registry that does not fit the index is searched linearly
+        pgIndexValid = PG_REGISTRY_SIZE <= PG_REGISTRY_INDEX_SIZE && pgBuildIndex();
+        if (!pgIndexValid) {
+            for (int i = 0; i < PG_REGISTRY_SIZE; i++) {
+                if (pgN(&__pg_registry_start[i]) == pgn) {
+                    return i;
+                }
+            }
+            return -1;
         }
     }
-    return NULL;
+
+    if (pgn < PG_DIRECT_INDEX_SIZE) {
+        const uint8_t index = pgDirectIndex[pgn];
+        return index == PG_INDEX_NONE ? -1 : index;
+    }
+    for (int i = 0; i < pgOtherIndexCount; i++) {
+        if (pgN(&__pg_registry_start[pgOtherIndex[i]]) == pgn) {
+            return pgOtherIndex[i];
+        }
+    }
+    return -1;
+}
+
+const pgRegistry_t* pgFind(pgn_t pgn)
+{
+    const int index = pgRegistryIndex(pgn);
+    return index >= 0 ? &__pg_registry_start[index] : NULL;
 }
 
 static uint8_t *pgOffset(const pgRegistry_t* reg)
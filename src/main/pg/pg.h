@@ -83,6 +83,8 @@ extern const uint8_t __pg_resetdata_end[];
 #endif
 
 #define PG_REGISTRY_SIZE (__pg_registry_end - __pg_registry_start)
+// Largest registry covered by the PGN lookup index, bigger registries fall back to a linear search
+#define PG_REGISTRY_INDEX_SIZE 255
 
 // Helper to iterate over the PG register.  Cheaper than a visitor style callback.
 #define PG_FOREACH(_name) \
@@ -197,6 +199,7 @@ extern const uint8_t __pg_resetdata_end[];
 #define CONVERT_PARAMETER_TO_PERCENT(param) (0.01f * param)
 
 const pgRegistry_t* pgFind(pgn_t pgn);
+int pgRegistryIndex(pgn_t pgn);
 
 bool pgLoad(const pgRegistry_t* reg, const void *from, int size, int version);
 int pgStore(const pgRegistry_t* reg, void *to, int size);
@@ -408,13 +408,15 @@ STATIC_UNIT_TESTED void crsfDataReceive(uint16_t c, void *data)
                     break;
                 }
 #endif
+#if defined(USE_TELEMETRY_CRSF) && defined(USE_CRSF_V3)
+                case CRSF_FRAMETYPE_DEVICE_INFO:
+                    crsfHandleDeviceInfoResponse(crsfFrame.frame.payload);
+                    break;
+#endif
 #if defined(USE_CRSF_CMS_TELEMETRY)
                 case CRSF_FRAMETYPE_DEVICE_PING:
                     crsfScheduleDeviceInfoResponse();
                     break;
-                case CRSF_FRAMETYPE_DEVICE_INFO:
-                    crsfHandleDeviceInfoResponse(crsfFrame.frame.payload);
-                    break;
                 case CRSF_FRAMETYPE_DISPLAYPORT_CMD: {
                     uint8_t *frameStart = (uint8_t *)&crsfFrame.frame.payload + CRSF_FRAME_ORIGIN_DEST_SIZE;
                     crsfProcessDisplayPortCmd(frameStart);
@@ -31,8 +31,10 @@
 
 #ifdef USE_RX_EXPRESSLRS
 
+#include "common/crc.h"
 #include "common/maths.h"
 #include "config/feature.h"
+#include "drivers/time.h"
 #include "fc/runtime_config.h"
 
 #include "msp/msp_protocol.h"
@@ -41,30 +43,22 @@
 #include "rx/expresslrs_telemetry.h"
 
 #include "telemetry/crsf.h"
+#include "telemetry/frame_scheduler.h"
 #include "telemetry/telemetry.h"
 
 #include "sensors/battery.h"
 #include "sensors/sensors.h"
 
-static uint8_t tlmBuffer[CRSF_FRAME_SIZE_MAX];
-
-typedef enum {
-    CRSF_FRAME_GPS_INDEX = 0,
-    CRSF_FRAME_BATTERY_SENSOR_INDEX,
-    CRSF_FRAME_ATTITUDE_INDEX,
-    CRSF_FRAME_FLIGHT_MODE_INDEX,
-    CRSF_FRAME_PAYLOAD_TYPES_COUNT //should be last
-} frameTypeIndex_e;
+#define ELRS_FLIGHT_MODE_PAYLOAD_SIZE_TYPICAL 6 // e.g. "ACRO*" and its terminator
+#define ELRS_TELEMETRY_PAYLOAD_TYPES_COUNT 4
 
-static crsfFrameType_e payloadTypes[] = {
-    CRSF_FRAMETYPE_GPS,
-    CRSF_FRAMETYPE_BATTERY_SENSOR,
-    CRSF_FRAMETYPE_ATTITUDE,
-    CRSF_FRAMETYPE_FLIGHT_MODE
-};
+static uint8_t tlmBuffer[CRSF_FRAME_SIZE_MAX];
 
-STATIC_UNIT_TESTED uint8_t tlmSensors = 0;
-STATIC_UNIT_TESTED uint8_t currentPayloadIndex;
+// The flight controller picks every downlink frame, so the frames share the link by weighted fair
+// queuing within the byte rate the telemetry ratio allows, see telemetry/frame_scheduler.h
+static frameScheduler_t tlmScheduler;
+static crsfFrameType_e tlmSchedule[ELRS_TELEMETRY_PAYLOAD_TYPES_COUNT];
+STATIC_UNIT_TESTED uint8_t tlmScheduleCount;
 
 static uint8_t *data = NULL;
 static uint8_t length = 0;
@@ -291,7 +285,6 @@ void processMspPacket(uint8_t *packet)
     case CRSF_FRAMETYPE_MSP_REQ:
     case CRSF_FRAMETYPE_MSP_WRITE:
         if (bufferCrsfMspFrame(&packet[ELRS_MSP_PACKET_OFFSET], CRSF_FRAME_RX_MSP_FRAME_SIZE)) {
-            handleCrsfMspFrameBuffer(&bufferMspResponse);
             mspReplyPending = true;
         }
         break;
@@ -314,6 +307,9 @@ void updateTelemetryRate(const uint16_t airRate, const uint8_t tlmRatio, const u
     // The expected number of packet periods between telemetry packets
     uint32_t packsBetween = tlmRatio * (1 + tlmBurst) / tlmBurst;
     maxWaitCount = packsBetween * ELRS_TELEMETRY_MAX_MISSED_PACKETS;
+
+    // Each of those packets carries ELRS_TELEMETRY_BYTES_PER_CALL bytes of a frame
+    frameSchedulerSetRate(&tlmScheduler, airRate * ELRS_TELEMETRY_BYTES_PER_CALL / MAX(packsBetween, 1));
 }
 
 void initTelemetry(void)
@@ -322,22 +318,31 @@ void initTelemetry(void)
         return;
     }
 
+    // weight, frame size, then the minimum and maximum update intervals; unchanged frames wait for the maximum.
+    // Nothing is sent until updateTelemetryRate() sets the budget from the telemetry ratio
+    frameSchedulerInit(&tlmScheduler, 0);
+    int index = 0;
     if (sensors(SENSOR_ACC) && telemetryIsSensorEnabled(SENSOR_PITCH | SENSOR_ROLL | SENSOR_HEADING)) {
-        tlmSensors |= BIT(CRSF_FRAME_ATTITUDE_INDEX);
+        frameSchedulerAdd(&tlmScheduler, 4, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 20000, 200000);
+        tlmSchedule[index++] = CRSF_FRAMETYPE_ATTITUDE;
     }
     if ((isBatteryVoltageConfigured() && telemetryIsSensorEnabled(SENSOR_VOLTAGE))
         || (isAmperageConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT | SENSOR_FUEL))) {
-        tlmSensors |= BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX);
+        frameSchedulerAdd(&tlmScheduler, 4, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 50000, 1000000);
+        tlmSchedule[index++] = CRSF_FRAMETYPE_BATTERY_SENSOR;
     }
     if (telemetryIsSensorEnabled(SENSOR_MODE)) {
-        tlmSensors |= BIT(CRSF_FRAME_FLIGHT_MODE_INDEX);
+        frameSchedulerAdd(&tlmScheduler, 2, ELRS_FLIGHT_MODE_PAYLOAD_SIZE_TYPICAL + CRSF_FRAME_LENGTH_NON_PAYLOAD, 50000, 1000000);
+        tlmSchedule[index++] = CRSF_FRAMETYPE_FLIGHT_MODE;
     }
 #ifdef USE_GPS
     if (featureIsEnabled(FEATURE_GPS)
        && telemetryIsSensorEnabled(SENSOR_ALTITUDE | SENSOR_LAT_LONG | SENSOR_GROUND_SPEED | SENSOR_HEADING)) {
-        tlmSensors |= BIT(CRSF_FRAME_GPS_INDEX);
+        frameSchedulerAdd(&tlmScheduler, 2, CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 100000, 1000000);
+        tlmSchedule[index++] = CRSF_FRAMETYPE_GPS;
     }
 #endif
+    tlmScheduleCount = (uint8_t)index;
 
     telemetrySenderResetState();
 #ifdef USE_MSP_OVER_TELEMETRY
@@ -347,30 +352,48 @@ void initTelemetry(void)
 
 bool getNextTelemetryPayload(uint8_t *nextPayloadSize, uint8_t **payloadData)
 {
+    *nextPayloadSize = 0;
+    *payloadData = 0;
+
 #ifdef USE_MSP_OVER_TELEMETRY
+    // Replies go out ahead of the scheduled frames, the bytes they take are charged to the same budget
     if (deviceInfoReplyPending) {
         *nextPayloadSize = getCrsfFrame(tlmBuffer, CRSF_FRAMETYPE_DEVICE_INFO);
         *payloadData = tlmBuffer;
         deviceInfoReplyPending = false;
+        frameSchedulerCharge(&tlmScheduler, *nextPayloadSize);
         return true;
     } else if (mspReplyPending) {
+        // Build the next response chunk only once the previous one has gone out, so a reply spread over
+        // several chunks keeps flowing at the telemetry ratio rather than a chunk per request
+        mspFrameSize = 0;
+        mspReplyPending = handleCrsfMspFrameBuffer(&bufferMspResponse);
         *nextPayloadSize = mspFrameSize;
         *payloadData = tlmBuffer;
-        mspReplyPending = false;
-        return true;
-    } else
+        frameSchedulerCharge(&tlmScheduler, mspFrameSize);
+        return mspFrameSize > 0;
+    }
 #endif
-    if (tlmSensors & BIT(currentPayloadIndex)) {
-        *nextPayloadSize = getCrsfFrame(tlmBuffer, payloadTypes[currentPayloadIndex]);
-        *payloadData = tlmBuffer;
-        currentPayloadIndex = (currentPayloadIndex + 1) % CRSF_FRAME_PAYLOAD_TYPES_COUNT;
-        return true;
-    } else {
-        currentPayloadIndex = (currentPayloadIndex + 1) % CRSF_FRAME_PAYLOAD_TYPES_COUNT;
-        *nextPayloadSize = 0;
-        *payloadData = 0;
-        return false;
+
+    const timeUs_t currentTimeUs = micros();
+
+    // Unchanged frames are passed over, so more than one may be built before one is sent
+    for (int i = 0; i < tlmScheduleCount; i++) {
+        const int index = frameSchedulerNext(&tlmScheduler, currentTimeUs);
+        if (index < 0) {
+            return false;
+        }
+
+        const uint8_t frameSize = getCrsfFrame(tlmBuffer, tlmSchedule[index]);
+        if (frameSchedulerCommit(&tlmScheduler, index, currentTimeUs, crc16_ccitt_update(0, tlmBuffer, frameSize))) {
+            frameSchedulerCharge(&tlmScheduler, frameSize);
+            *nextPayloadSize = frameSize;
+            *payloadData = tlmBuffer;
+            return true;
+        }
     }
+
+    return false;
 }
 
 #endif
@@ -93,6 +93,12 @@ static timeUs_t ghstRxFrameEndAtUs = 0;
 static uint8_t telemetryBuf[GHST_FRAME_SIZE];
 static uint8_t telemetryBufLen = 0;
 
+#if defined(USE_TELEMETRY_GHST) && defined(USE_MSP_OVER_TELEMETRY)
+// An MSP request frame that arrived while the reply queue was full, handled once a reply has been sent
+static uint8_t ghstMspHeldPayload[GHST_PAYLOAD_SIZE];
+static uint8_t ghstMspHeldLength = 0;
+#endif
+
 /* GHST Protocol
  * Ghost uses 420k baud single-wire, half duplex connection, connected to a FC UART 'Tx' pin
  * Each control packet is interleaved with one or more corresponding downlink packets
@@ -236,6 +242,32 @@ STATIC_UNIT_TESTED uint8_t ghstFrameStatus(rxRuntimeState_t *rxRuntimeState)
     return status;
 }
 
+#if defined(USE_TELEMETRY_GHST) && defined(USE_MSP_OVER_TELEMETRY)
+static void ghstHandleMspFrame(uint8_t *payload, uint8_t length)
+{
+    if (handleMspFrame(payload, length, NULL)) {
+        ghstScheduleMspResponse();
+    }
+}
+
+static void ghstHandleHeldMspFrame(void)
+{
+    if (ghstMspHeldLength && !isMspReplyQueueFull()) {
+        ghstHandleMspFrame(ghstMspHeldPayload, ghstMspHeldLength);
+        ghstMspHeldLength = 0;
+    }
+}
+
+// Frames that arrive while one is held are dropped, the client retries the request they belong to
+static void ghstHoldMspFrame(const uint8_t *payload, uint8_t length)
+{
+    if (!ghstMspHeldLength) {
+        ghstMspHeldLength = MIN(length, sizeof(ghstMspHeldPayload));
+        memcpy(ghstMspHeldPayload, payload, ghstMspHeldLength);
+    }
+}
+#endif
+
 static bool ghstProcessFrame(const rxRuntimeState_t *rxRuntimeState)
 {
     // Assume that the only way we get here is if ghstFrameStatus returned RX_FRAME_PROCESSING_REQUIRED, which indicates that the CRC
@@ -244,6 +276,10 @@ static bool ghstProcessFrame(const rxRuntimeState_t *rxRuntimeState)
     UNUSED(rxRuntimeState);
     static int16_t unknownFrameCount = 0;
 
+#if defined(USE_TELEMETRY_GHST) && defined(USE_MSP_OVER_TELEMETRY)
+    ghstHandleHeldMspFrame();
+#endif
+
 #ifdef USE_TELEMETRY_GHST
     // do we have a telemetry buffer to send?
     if (checkGhstTelemetryState() && shouldSendTelemetryFrame()) {
@@ -358,8 +394,11 @@ static bool ghstProcessFrame(const rxRuntimeState_t *rxRuntimeState)
             case GHST_UL_MSP_WRITE: {
                 static uint8_t mspFrameCounter = 0;
                 DEBUG_SET(DEBUG_GHST_MSP, 0, ++mspFrameCounter);
-                if (handleMspFrame(ghstValidatedFrame->frame.payload, ghstValidatedFrame->frame.len - GHST_FRAME_LENGTH_CRC - GHST_FRAME_LENGTH_TYPE, NULL)) {
-                    ghstScheduleMspResponse();
+                const uint8_t mspPayloadLength = ghstValidatedFrame->frame.len - GHST_FRAME_LENGTH_CRC - GHST_FRAME_LENGTH_TYPE;
+                if (ghstMspHeldLength || isMspReplyQueueFull()) {
+                    ghstHoldMspFrame(ghstValidatedFrame->frame.payload, mspPayloadLength);
+                } else {
+                    ghstHandleMspFrame(ghstValidatedFrame->frame.payload, mspPayloadLength);
                 }
                 break;
             }
@@ -28,6 +28,7 @@
 
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/trace.h"
 
 #include "common/maths.h"
 #include "common/utils.h"
@@ -548,6 +549,7 @@ FAST_CODE_NOINLINE void rxFrameCheck(timeUs_t currentTimeUs, timeDelta_t current
     }
 
     if (signalReceived) {
+        TRACE_EVENT(TRACE_EVENT_RX_FRAME, rxRuntimeState.rxProvider);
         //  true only when a new packet arrives
         needRxSignalBefore = currentTimeUs + needRxSignalMaxDelayUs;
         rxSignalReceived = true; // immediately process packet data
@@ -30,6 +30,7 @@
 
 #include "build/build_config.h"
 #include "build/debug.h"
+#include "build/trace.h"
 
 #include "common/maths.h"
 #include "common/time.h"
@@ -37,6 +38,7 @@
 
 #include "drivers/time.h"
 #include "drivers/accgyro/accgyro.h"
+#include "drivers/stack_check.h"
 #include "drivers/system.h"
 
 #include "fc/core.h"
@@ -108,6 +110,15 @@ static uint32_t nextTimingCycles;
 
 static timeMs_t lastFailsafeCheckMs = 0;
 
+#if defined(USE_STACK_CHECK)
+// A slow task is given this many stack check periods to run once armed before the sample moves on
+#define STACK_SAMPLE_WAIT_PERIODS 10
+
+static task_t *stackSampleTask;
+static taskId_e stackSampleTaskId = TASK_COUNT - 1;
+static uint8_t stackSampleWaitPeriods;
+#endif
+
 // No need for a linked list for the queue, since items are only inserted at startup
 
 STATIC_UNIT_TESTED FAST_DATA_ZERO_INIT task_t* taskQueueArray[TASK_COUNT + 1]; // extra item for NULL pointer at end of queue
@@ -226,7 +237,29 @@ void getTaskInfo(taskId_e taskId, taskInfo_t * taskInfo)
     taskInfo->runCount = getTask(taskId)->runCount;
     taskInfo->execTime = getTask(taskId)->execTime;
 #endif
+#if defined(USE_STACK_CHECK)
+    taskInfo->stackPeakBytes = getTask(taskId)->stackPeakBytes;
+#endif
+}
+
+#if defined(USE_STACK_CHECK)
+// Arm the stack depth sample for the next enabled task, called from the stack check task
+void schedulerSampleNextTaskStack(void)
+{
+    if (stackSampleTask && ++stackSampleWaitPeriods < STACK_SAMPLE_WAIT_PERIODS) {
+        return;
+    }
+
+    taskId_e taskId = stackSampleTaskId;
+    do {
+        taskId = (taskId + 1) % TASK_COUNT;
+    } while (!queueContains(getTask(taskId)) && taskId != stackSampleTaskId);
+
+    stackSampleTaskId = taskId;
+    stackSampleTask = getTask(taskId);
+    stackSampleWaitPeriods = 0;
 }
+#endif
 
 void rescheduleTask(taskId_e taskId, timeDelta_t newPeriodUs)
 {
@@ -328,6 +361,63 @@ void schedulerResetCheckFunctionMaxExecutionTime(void)
     checkFuncMaxExecutionTimeUs = 0;
 }
 
+#if defined(USE_TASK_HISTOGRAMS)
+static FAST_CODE void taskHistogramAdd(uint16_t *buckets, timeDelta_t durationUs)
+{
+    const unsigned bucket = (durationUs > 0) ? MIN(llog2(durationUs) + 1, TASK_HISTOGRAM_BUCKET_COUNT - 1U) : 0;
+
+    if (++buckets[bucket] == UINT16_MAX) {
+        // Rather than saturate, halve all counts so the shape of the distribution is retained
+        for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+            buckets[i] >>= 1;
+        }
+    }
+}
+
+void getTaskHistogram(taskId_e taskId, taskHistogram_t *histogram)
+{
+    if (taskId == TASK_SELF) {
+        *histogram = currentTask->histogram;
+    } else if (taskId < TASK_COUNT) {
+        *histogram = getTask(taskId)->histogram;
+    }
+}
+
+void schedulerResetTaskHistogram(taskId_e taskId)
+{
+    if (taskId == TASK_SELF) {
+        memset(&currentTask->histogram, 0, sizeof(currentTask->histogram));
+    } else if (taskId < TASK_COUNT) {
+        memset(&getTask(taskId)->histogram, 0, sizeof(getTask(taskId)->histogram));
+    }
+}
+
+// Return the upper bound in us of the histogram bucket containing the given percentile, or 0 if there are no samples
+timeUs_t taskHistogramPercentileUs(const uint16_t *buckets, uint8_t percentile)
+{
+    uint32_t total = 0;
+    for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+        total += buckets[i];
+    }
+
+    if (total == 0) {
+        return 0;
+    }
+
+    const uint32_t threshold = (total * MIN(percentile, 100) + 99) / 100;
+    uint32_t count = 0;
+    int bucket;
+    for (bucket = 0; bucket < TASK_HISTOGRAM_BUCKET_COUNT - 1; bucket++) {
+        count += buckets[bucket];
+        if (count >= threshold) {
+            break;
+        }
+    }
+
+    return 1 << bucket;
+}
+#endif
+
 void schedulerInit(void)
 {
     queueClear();
@@ -355,6 +445,9 @@ void schedulerInit(void)
 
     for (taskId_e taskId = 0; taskId < TASK_COUNT; taskId++) {
         schedulerResetTaskStatistics(taskId);
+#if defined(USE_TASK_HISTOGRAMS)
+        schedulerResetTaskHistogram(taskId);
+#endif
     }
 }
 
@@ -380,14 +473,40 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
         ignoreCurrentTaskExecTime = false;
         taskNextStateTime = -1;
         float period = currentTimeUs - selectedTask->lastExecutedAtUs;
+#if defined(USE_TASK_HISTOGRAMS)
+        // Event driven tasks are due when signalled, time driven tasks one period after they last ran
+        const timeDelta_t startLatencyUs = selectedTask->attribute->checkFunc ?
+            cmpTimeUs(currentTimeUs, selectedTask->lastSignaledAtUs) :
+            cmpTimeUs(currentTimeUs, selectedTask->lastExecutedAtUs) - selectedTask->attribute->desiredPeriodUs;
+        const bool hasRunBefore = selectedTask->lastExecutedAtUs != 0;
+#endif
         selectedTask->lastExecutedAtUs = currentTimeUs;
         selectedTask->lastDesiredAt += selectedTask->attribute->desiredPeriodUs;
         selectedTask->dynamicPriority = 0;
 
+#if defined(USE_STACK_CHECK)
+        const bool sampleStack = selectedTask == stackSampleTask;
+        if (sampleStack) {
+            stackSampleBegin();
+        }
+#endif
+
         // Execute task
         const timeUs_t currentTimeBeforeTaskCallUs = micros();
+        TRACE_TASK_START(selectedTask - tasks);
         selectedTask->attribute->taskFunc(currentTimeBeforeTaskCallUs);
+        TRACE_TASK_END(selectedTask - tasks);
         taskExecutionTimeUs = micros() - currentTimeBeforeTaskCallUs;
+
+#if defined(USE_STACK_CHECK)
+        if (sampleStack) {
+            selectedTask->stackPeakBytes = MAX(selectedTask->stackPeakBytes, stackSampleEnd());
+            // The stack check task arms the next sample itself
+            if (stackSampleTask == selectedTask) {
+                stackSampleTask = NULL;
+            }
+        }
+#endif
         taskTotalExecutionTime += taskExecutionTimeUs;
         selectedTask->movingSumExecutionTime10thUs += (taskExecutionTimeUs * 10) - selectedTask->movingSumExecutionTime10thUs / TASK_STATS_MOVING_SUM_COUNT;
         if (!ignoreCurrentTaskExecRate) {
@@ -395,6 +514,11 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
             selectedTask->taskLatestDeltaTimeUs = cmpTimeUs(currentTimeUs, selectedTask->lastStatsAtUs);
             selectedTask->movingSumDeltaTime10thUs += (selectedTask->taskLatestDeltaTimeUs * 10) - selectedTask->movingSumDeltaTime10thUs / TASK_STATS_MOVING_SUM_COUNT;
             selectedTask->lastStatsAtUs = currentTimeUs;
+#if defined(USE_TASK_HISTOGRAMS)
+            if (hasRunBefore) {
+                taskHistogramAdd(selectedTask->histogram.startLatency, startLatencyUs);
+            }
+#endif
         }
 
         // Update estimate of expected task duration
@@ -411,6 +535,9 @@ FAST_CODE timeUs_t schedulerExecuteTask(task_t *selectedTask, timeUs_t currentTi
 
         if (!ignoreCurrentTaskExecTime) {
             selectedTask->maxExecutionTimeUs = MAX(selectedTask->maxExecutionTimeUs, taskExecutionTimeUs);
+#if defined(USE_TASK_HISTOGRAMS)
+            taskHistogramAdd(selectedTask->histogram.execTime, taskExecutionTimeUs);
+#endif
         }
 
         selectedTask->totalExecutionTimeUs += taskExecutionTimeUs;   // time consumed by scheduler + task
@@ -55,6 +55,10 @@
 #define TASK_AGE_EXPEDITE_COUNT         1   // Make aged tasks more schedulable
 #define TASK_AGE_EXPEDITE_SCALE         0.9 // By scaling their expected execution time
 
+// Task execution time and start latency histograms use log2 buckets. Bucket 0 counts durations of 0us,
+// bucket n counts durations in the range [2^(n-1), 2^n) us and the last bucket collects everything longer
+#define TASK_HISTOGRAM_BUCKET_COUNT     16
+
 // Gyro interrupt counts over which to measure loop time and skew
 #define GYRO_RATE_COUNT 25000
 #define GYRO_LOCK_COUNT 50
@@ -76,6 +80,11 @@ typedef struct {
     timeUs_t     averageDeltaTimeUs;
 } cfCheckFuncInfo_t;
 
+typedef struct {
+    uint16_t     execTime[TASK_HISTOGRAM_BUCKET_COUNT];        // task execution time
+    uint16_t     startLatency[TASK_HISTOGRAM_BUCKET_COUNT];    // task start time relative to when it became due
+} taskHistogram_t;
+
 typedef struct {
     const char * taskName;
     const char * subTaskName;
@@ -93,6 +102,9 @@ typedef struct {
     uint32_t     lateCount;
     timeUs_t     execTime;
 #endif
+#if defined(USE_STACK_CHECK)
+    uint16_t     stackPeakBytes;                // deepest stack use seen while the task ran
+#endif
 } taskInfo_t;
 
 typedef enum {
@@ -179,6 +191,7 @@ typedef enum {
 #ifdef USE_RC_STATS
     TASK_RC_STATS,
 #endif
+    TASK_DEFERRED_INIT,
 
     /* Count of real tasks */
     TASK_COUNT,
@@ -223,6 +236,12 @@ typedef struct {
     uint32_t lateCount;
     timeUs_t execTime;
 #endif
+#if defined(USE_TASK_HISTOGRAMS)
+    taskHistogram_t histogram;
+#endif
+#if defined(USE_STACK_CHECK)
+    uint16_t stackPeakBytes;            // deepest stack use seen in sampled runs, measured from the top of the stack
+#endif
 } task_t;
 
 void getCheckFuncInfo(cfCheckFuncInfo_t *checkFuncInfo);
@@ -237,6 +256,14 @@ bool schedulerGetIgnoreTaskExecTime();
 void schedulerResetTaskStatistics(taskId_e taskId);
 void schedulerResetTaskMaxExecutionTime(taskId_e taskId);
 void schedulerResetCheckFunctionMaxExecutionTime(void);
+#if defined(USE_TASK_HISTOGRAMS)
+void getTaskHistogram(taskId_e taskId, taskHistogram_t *histogram);
+void schedulerResetTaskHistogram(taskId_e taskId);
+timeUs_t taskHistogramPercentileUs(const uint16_t *buckets, uint8_t percentile);
+#endif
+#if defined(USE_STACK_CHECK)
+void schedulerSampleNextTaskStack(void);
+#endif
 void schedulerSetNextStateTime(timeDelta_t nextStateTime);
 timeDelta_t schedulerGetNextStateTime(void);
 void schedulerInit(void);
@@ -31,6 +31,7 @@
 #include "common/maths.h"
 #include "common/filter.h"
 
+#include "pg/boot.h"
 #include "pg/pg.h"
 #include "pg/pg_ids.h"
 
@@ -331,7 +332,15 @@ static bool baroDetect(baroDev_t *baroDev, baroSensor_e baroHardwareToUse)
 void baroInit(void)
 {
 #ifndef USE_VIRTUAL_BARO
-    baroReady = baroDetect(&baro.dev, barometerConfig()->baro_hardware);
+    baroReady = false;
+    if (bootConfig()->fastBoot && barometerConfig()->baro_hardware == BARO_DEFAULT && bootConfig()->baroHardware != BARO_DEFAULT) {
+        // Start the search at the baro found on the last boot
+        baroReady = baroDetect(&baro.dev, bootConfig()->baroHardware);
+    }
+    if (!baroReady) {
+        baroReady = baroDetect(&baro.dev, barometerConfig()->baro_hardware);
+    }
+    bootConfigMutable()->baroHardware = baroReady ? detectedSensors[SENSOR_INDEX_BARO] : BARO_DEFAULT;
 #else
     baroReady = baroDetect(&baro.dev, BARO_VIRTUAL);
 #endif
@@ -66,6 +66,7 @@
 #include "flight/dyn_notch_filter.h"
 #endif
 
+#include "pg/boot.h"
 #include "pg/gyrodev.h"
 
 #include "sensors/gyro.h"
@@ -527,6 +528,9 @@ STATIC_UNIT_TESTED gyroHardware_e gyroDetect(gyroDev_t *dev)
 
 static bool gyroDetectSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t *config)
 {
+    uint8_t *spiDetectHint = &bootConfigMutable()->gyroSpiDetectHint[config->index];
+    gyroSensor->gyroDev.spiDetectHint = bootConfig()->fastBoot ? *spiDetectHint : 0;
+
 #if defined(USE_GYRO_MPU6050) || defined(USE_GYRO_MPU3050) || defined(USE_GYRO_MPU6500) || defined(USE_GYRO_SPI_MPU6500) || defined(USE_GYRO_SPI_MPU6000) \
  || defined(USE_ACC_MPU6050) || defined(USE_GYRO_SPI_MPU9250) || defined(USE_GYRO_SPI_ICM20601) || defined(USE_GYRO_SPI_ICM20649) \
  || defined(USE_GYRO_SPI_ICM20689) || defined(USE_GYRO_L3GD20) || defined(USE_ACCGYRO_BMI160) || defined(USE_ACCGYRO_BMI270) || defined(USE_ACCGYRO_LSM6DSO) || defined(USE_GYRO_SPI_ICM42605) || defined(USE_GYRO_SPI_ICM42688P)
@@ -546,6 +550,7 @@ static bool gyroDetectSensor(gyroSensor_t *gyroSensor, const gyroDeviceConfig_t
 
     const gyroHardware_e gyroHardware = gyroDetect(&gyroSensor->gyroDev);
     gyroSensor->gyroDev.gyroHardware = gyroHardware;
+    *spiDetectHint = gyroHardware != GYRO_NONE ? gyroSensor->gyroDev.spiDetectHint : 0;
 
     return gyroHardware != GYRO_NONE;
 }
@@ -27,6 +27,8 @@
 #include <errno.h>
 #include <time.h>
 
+#include "build/trace.h"
+
 #include "common/maths.h"
 
 #include "drivers/io.h"
@@ -216,6 +218,8 @@ static void* udpThread(void* data)
                 printf("[SITL] new fdm %d t:%f from %s:%d\n", n, fdmPkt.timestamp, inet_ntoa(stateLink.recv.sin_addr), stateLink.recv.sin_port);
                 fdm_received = true;
             }
+            // The arrival of simulator state stands in for the gyro interrupt
+            TRACE_EVENT(TRACE_EVENT_GYRO_EXTI, 0);
             updateState(&fdmPkt);
         }
     }
@@ -101,6 +101,9 @@
 
 #define USE_PWM_OUTPUT
 
+#define USE_TRACE
+#define USE_CRC_SLICE_BY_4
+
 #undef USE_STACK_CHECK // I think SITL don't need this
 #undef USE_DASHBOARD
 #undef USE_TELEMETRY_LTM
@@ -68,6 +68,10 @@
 #define USE_GYRO_REGISTER_DUMP  // Adds gyroregisters command to cli to dump configured register values
 #define USE_IMU_CALC
 
+#if TARGET_FLASH_SIZE > 512
+#define USE_CRC_SLICE_BY_4      // ~3KB of CRC tables instead of ~1KB, to checksum buffers four bytes at a time
+#endif
+
 // all the settings for classic build
 #if !defined(CLOUD_BUILD) && !defined(SITL)
 
@@ -366,6 +370,10 @@
 #define USE_LAUNCH_CONTROL
 #endif
 
+#if !defined(USE_BOOT_PROFILE)
+#define USE_BOOT_PROFILE
+#endif
+
 #endif // !defined(CORE_BUILD)
 
 #ifdef USE_GPS
@@ -45,6 +45,7 @@
 #include "drivers/nvic.h"
 #include "drivers/persistent.h"
 
+#include "fc/rc.h"
 #include "fc/rc_modes.h"
 #include "fc/runtime_config.h"
 
@@ -64,22 +65,29 @@
 #include "sensors/battery.h"
 #include "sensors/sensors.h"
 
+#include "telemetry/frame_scheduler.h"
 #include "telemetry/telemetry.h"
 #include "telemetry/msp_shared.h"
 
 #include "crsf.h"
 
 
-#define CRSF_CYCLETIME_US                   100000 // 100ms, 10 Hz
+// Receivers send telemetry in a fixed ratio of the air packets, so the downlink follows the RC packet rate
+#define CRSF_TELEMETRY_BYTES_PER_RC_FRAME 10
+#define CRSF_TELEMETRY_BYTES_PER_SECOND_MIN 200
+#define CRSF_TELEMETRY_BYTES_PER_SECOND_MAX 1000
+#define CRSF_FLIGHT_MODE_PAYLOAD_SIZE_TYPICAL 6 // e.g. "ACRO*" and its terminator
 #define CRSF_DEVICEINFO_VERSION             0x01
 #define CRSF_DEVICEINFO_PARAMETER_COUNT     0
 
 #define CRSF_MSP_BUFFER_SIZE 96
 #define CRSF_MSP_LENGTH_OFFSET 1
+#define CRSF_MSP_CHUNKS_PER_CALL_MAX 4
 
 static bool crsfTelemetryEnabled;
 static bool deviceInfoReplyPending;
 static uint8_t crsfFrame[CRSF_FRAME_SIZE_MAX];
+static frameScheduler_t crsfFrameScheduler;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 typedef struct mspBuffer_s {
@@ -93,9 +101,7 @@ static mspBuffer_t mspRxBuffer;
 
 #define CRSF_TELEMETRY_FRAME_INTERVAL_MAX_US 20000 // 20ms
 
-#if defined(USE_CRSF_CMS_TELEMETRY)
 #define CRSF_LINK_TYPE_CHECK_US 250000 // 250 ms
-#define CRSF_ELRS_DISLAYPORT_CHUNK_INTERVAL_US 75000 // 75 ms
 
 typedef enum {
     CRSF_LINK_UNKNOWN,
@@ -104,6 +110,10 @@ typedef enum {
 } crsfLinkType_t;
 
 static crsfLinkType_t crsfLinkType = CRSF_LINK_UNKNOWN;
+
+#if defined(USE_CRSF_CMS_TELEMETRY)
+#define CRSF_ELRS_DISLAYPORT_CHUNK_INTERVAL_US 75000 // 75 ms
+
 static timeDelta_t crsfDisplayPortChunkIntervalUs = 0;
 #endif
 
@@ -174,37 +184,29 @@ bool bufferCrsfMspFrame(uint8_t *frameStart, int frameLength)
     }
 }
 
+// Processes buffered requests while there is room to queue their responses, so that the host can keep
+// several requests in flight, then sends one response chunk. Returns true while there is more to send.
 bool handleCrsfMspFrameBuffer(mspResponseFnPtr responseFn)
 {
-    static bool replyPending = false;
-    if (replyPending) {
-        if (crsfRxIsTelemetryBufEmpty()) {
-            replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
-        }
-        return replyPending;
-    }
-    if (!mspRxBuffer.len) {
-        return false;
-    }
+    const int len = mspRxBuffer.len; // frames are only ever appended behind this
     int pos = 0;
-    while (true) {
+    while (pos < len && !isMspReplyQueueFull()) {
         const uint8_t mspFrameLength = mspRxBuffer.bytes[pos];
-        if (handleMspFrame(&mspRxBuffer.bytes[CRSF_MSP_LENGTH_OFFSET + pos], mspFrameLength, NULL)) {
-            if (crsfRxIsTelemetryBufEmpty()) {
-                replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
-            } else {
-                replyPending = true;
-            }
-        }
+        handleMspFrame(&mspRxBuffer.bytes[CRSF_MSP_LENGTH_OFFSET + pos], mspFrameLength, NULL);
         pos += CRSF_MSP_LENGTH_OFFSET + mspFrameLength;
+    }
+    if (pos) {
         ATOMIC_BLOCK(NVIC_PRIO_SERIALUART1) {
-            if (pos >= mspRxBuffer.len) {
-                mspRxBuffer.len = 0;
-                return replyPending;
-            }
+            memmove(mspRxBuffer.bytes, mspRxBuffer.bytes + pos, mspRxBuffer.len - pos);
+            mspRxBuffer.len -= pos;
         }
     }
-    return replyPending;
+
+    bool replyPending = hasPendingMspReply();
+    if (replyPending && crsfRxIsTelemetryBufEmpty()) {
+        replyPending = sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, responseFn);
+    }
+    return replyPending || mspRxBuffer.len;
 }
 #endif
 
@@ -216,14 +218,23 @@ static void crsfInitializeFrame(sbuf_t *dst)
     sbufWriteU8(dst, CRSF_SYNC_BYTE);
 }
 
-static void crsfFinalize(sbuf_t *dst)
+static void crsfFinalizeFrame(sbuf_t *dst, bool charge)
 {
     crc8_dvb_s2_sbuf_append(dst, &crsfFrame[2]); // start at byte 2, since CRC does not include device address and frame length
     sbufSwitchToReader(dst, crsfFrame);
+    if (charge) {
+        frameSchedulerCharge(&crsfFrameScheduler, sbufBytesRemaining(dst));
+    }
     // write the telemetry frame to the receiver.
     crsfRxWriteTelemetryData(sbufPtr(dst), sbufBytesRemaining(dst));
 }
 
+// Every frame written, scheduled or not, comes out of the telemetry budget
+static void crsfFinalize(sbuf_t *dst)
+{
+    crsfFinalizeFrame(dst, true);
+}
+
 /*
 CRSF frame has the structure:
 <Device address> <Frame length> <Type> <Payload> <CRC>
@@ -505,7 +516,6 @@ void speedNegotiationProcess(timeUs_t currentTimeUs)
         crsfRxSendTelemetryData(); // prevent overwriting previous data
         crsfFinalize(dst);
         crsfRxSendTelemetryData();
-#if defined(USE_CRSF_CMS_TELEMETRY)
     } else if (crsfLinkType == CRSF_LINK_UNKNOWN) {
         static timeUs_t lastPing;
 
@@ -521,7 +531,6 @@ void speedNegotiationProcess(timeUs_t currentTimeUs)
 
             lastPing = currentTimeUs;
         }
-#endif
     }
 }
 #endif
@@ -615,19 +624,18 @@ static void crsfFrameDisplayPortClear(sbuf_t *dst)
 
 #endif
 
-// schedule array to decide how often each type of frame is sent
+// frame types handed to the frame scheduler
 typedef enum {
     CRSF_FRAME_START_INDEX = 0,
     CRSF_FRAME_ATTITUDE_INDEX = CRSF_FRAME_START_INDEX,
     CRSF_FRAME_BATTERY_SENSOR_INDEX,
     CRSF_FRAME_FLIGHT_MODE_INDEX,
     CRSF_FRAME_GPS_INDEX,
-    CRSF_FRAME_HEARTBEAT_INDEX,
     CRSF_SCHEDULE_COUNT_MAX
 } crsfFrameTypeIndex_e;
 
 static uint8_t crsfScheduleCount;
-static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];
+static uint8_t crsfSchedule[CRSF_SCHEDULE_COUNT_MAX];     // frame type of each frame scheduler entry
 
 #if defined(USE_MSP_OVER_TELEMETRY)
 
@@ -640,6 +648,19 @@ void crsfScheduleMspResponse(uint8_t requestOriginID)
     mspRequestOriginID = requestOriginID;
 }
 
+// A faster negotiated link carries more response chunks in the time of one telemetry task period
+static int crsfMspChunksPerCall(void)
+{
+#if defined(USE_CRSF_V3)
+    // An ELRS receiver sends telemetry over the air at the telemetry ratio, whatever the UART speed,
+    // and drops the chunks it has no room for. Burst only once the receiver has identified itself as another kind.
+    if (isCrsfV3Running && crsfLinkType == CRSF_LINK_NOT_ELRS) {
+        return constrain(getCrsfDesiredSpeed() / CRSF_BAUDRATE, 1, CRSF_MSP_CHUNKS_PER_CALL_MAX);
+    }
+#endif
+    return 1;
+}
+
 // sends MSP response chunk over CRSF. Must be of type mspResponseFnPtr
 static void crsfSendMspResponse(uint8_t *payload, const uint8_t payloadSize)
 {
@@ -656,52 +677,61 @@ static void crsfSendMspResponse(uint8_t *payload, const uint8_t payloadSize)
 }
 #endif
 
-static void processCrsf(void)
+static void crsfFrameScheduled(sbuf_t *dst, crsfFrameTypeIndex_e frameType)
 {
-    if (!crsfRxIsTelemetryBufEmpty()) {
-        return; // do nothing if telemetry ouptut buffer is not empty yet.
+    switch (frameType) {
+    default:
+    case CRSF_FRAME_ATTITUDE_INDEX:
+        crsfFrameAttitude(dst);
+        break;
+    case CRSF_FRAME_BATTERY_SENSOR_INDEX:
+        crsfFrameBatterySensor(dst);
+        break;
+    case CRSF_FRAME_FLIGHT_MODE_INDEX:
+        crsfFrameFlightMode(dst);
+        break;
+#ifdef USE_GPS
+    case CRSF_FRAME_GPS_INDEX:
+        crsfFrameGps(dst);
+        break;
+#endif
     }
+}
 
-    static uint8_t crsfScheduleIndex = 0;
+static uint32_t crsfTelemetryBytesPerSecond(void)
+{
+    if (!getRxRateValid()) {
+        return CRSF_TELEMETRY_BYTES_PER_SECOND_MIN;
+    }
 
-    const uint8_t currentSchedule = crsfSchedule[crsfScheduleIndex];
+    return constrain(CRSF_TELEMETRY_BYTES_PER_RC_FRAME * 1000000 / getCurrentRxIntervalUs(), CRSF_TELEMETRY_BYTES_PER_SECOND_MIN, CRSF_TELEMETRY_BYTES_PER_SECOND_MAX);
+}
 
+// Returns true if a frame was sent
+static bool processCrsf(timeUs_t currentTimeUs)
+{
     sbuf_t crsfPayloadBuf;
     sbuf_t *dst = &crsfPayloadBuf;
 
-    if (currentSchedule & BIT(CRSF_FRAME_ATTITUDE_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameAttitude(dst);
-        crsfFinalize(dst);
-    }
-    if (currentSchedule & BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameBatterySensor(dst);
-        crsfFinalize(dst);
-    }
+    frameSchedulerSetRate(&crsfFrameScheduler, crsfTelemetryBytesPerSecond());
 
-    if (currentSchedule & BIT(CRSF_FRAME_FLIGHT_MODE_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameFlightMode(dst);
-        crsfFinalize(dst);
-    }
-#ifdef USE_GPS
-    if (currentSchedule & BIT(CRSF_FRAME_GPS_INDEX)) {
-        crsfInitializeFrame(dst);
-        crsfFrameGps(dst);
-        crsfFinalize(dst);
-    }
-#endif
+    // Unchanged frames are passed over, so more than one may be built before one is sent
+    for (int i = 0; i < crsfScheduleCount; i++) {
+        const int index = frameSchedulerNext(&crsfFrameScheduler, currentTimeUs);
+        if (index < 0) {
+            return false;
+        }
 
-#if defined(USE_CRSF_V3)
-    if (currentSchedule & BIT(CRSF_FRAME_HEARTBEAT_INDEX)) {
         crsfInitializeFrame(dst);
-        crsfFrameHeartbeat(dst);
-        crsfFinalize(dst);
+        crsfFrameScheduled(dst, crsfSchedule[index]);
+        const uint16_t signature = crc16_ccitt_update(0, crsfFrame, sbufPtr(dst) - crsfFrame);
+        if (frameSchedulerCommit(&crsfFrameScheduler, index, currentTimeUs, signature)) {
+            crsfFinalize(dst);
+            return true;
+        }
     }
-#endif
 
-    crsfScheduleIndex = (crsfScheduleIndex + 1) % crsfScheduleCount;
+    return false;
 }
 
 void crsfScheduleDeviceInfoResponse(void)
@@ -709,7 +739,7 @@ void crsfScheduleDeviceInfoResponse(void)
     deviceInfoReplyPending = true;
 }
 
-#if defined(USE_CRSF_CMS_TELEMETRY)
+#if defined(USE_CRSF_V3)
 void crsfHandleDeviceInfoResponse(uint8_t *payload)
 {
     // Skip over dst/src address bytes
@@ -721,7 +751,9 @@ void crsfHandleDeviceInfoResponse(uint8_t *payload)
     // Check the serial number
     if (memcmp(payload, "ELRS", 4) == 0) {
         crsfLinkType = CRSF_LINK_ELRS;
+#if defined(USE_CRSF_CMS_TELEMETRY)
         crsfDisplayPortChunkIntervalUs = CRSF_ELRS_DISLAYPORT_CHUNK_INTERVAL_US;
+#endif
     } else {
         crsfLinkType = CRSF_LINK_NOT_ELRS;
     }
@@ -743,28 +775,27 @@ void initCrsfTelemetry(void)
     mspReplyPending = false;
 #endif
 
+    // weight, frame size, then the minimum and maximum update intervals; unchanged frames wait for the maximum
+    frameSchedulerInit(&crsfFrameScheduler, CRSF_TELEMETRY_BYTES_PER_SECOND_MIN);
     int index = 0;
     if (sensors(SENSOR_ACC) && telemetryIsSensorEnabled(SENSOR_PITCH | SENSOR_ROLL | SENSOR_HEADING)) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_ATTITUDE_INDEX);
+        frameSchedulerAdd(&crsfFrameScheduler, 4, CRSF_FRAME_ATTITUDE_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 20000, 200000);
+        crsfSchedule[index++] = CRSF_FRAME_ATTITUDE_INDEX;
     }
     if ((isBatteryVoltageConfigured() && telemetryIsSensorEnabled(SENSOR_VOLTAGE))
         || (isAmperageConfigured() && telemetryIsSensorEnabled(SENSOR_CURRENT | SENSOR_FUEL))) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_BATTERY_SENSOR_INDEX);
+        frameSchedulerAdd(&crsfFrameScheduler, 4, CRSF_FRAME_BATTERY_SENSOR_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 50000, 1000000);
+        crsfSchedule[index++] = CRSF_FRAME_BATTERY_SENSOR_INDEX;
     }
     if (telemetryIsSensorEnabled(SENSOR_MODE)) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_FLIGHT_MODE_INDEX);
+        frameSchedulerAdd(&crsfFrameScheduler, 2, CRSF_FLIGHT_MODE_PAYLOAD_SIZE_TYPICAL + CRSF_FRAME_LENGTH_NON_PAYLOAD, 50000, 1000000);
+        crsfSchedule[index++] = CRSF_FRAME_FLIGHT_MODE_INDEX;
     }
 #ifdef USE_GPS
     if (featureIsEnabled(FEATURE_GPS)
        && telemetryIsSensorEnabled(SENSOR_ALTITUDE | SENSOR_LAT_LONG | SENSOR_GROUND_SPEED | SENSOR_HEADING)) {
-        crsfSchedule[index++] = BIT(CRSF_FRAME_GPS_INDEX);
-    }
-#endif
-
-#if defined(USE_CRSF_V3)
-    while (index < (CRSF_CYCLETIME_US / CRSF_TELEMETRY_FRAME_INTERVAL_MAX_US) && index < CRSF_SCHEDULE_COUNT_MAX) {
-        // schedule heartbeat to ensure that telemetry/heartbeat frames are sent at minimum 50Hz
-        crsfSchedule[index++] = BIT(CRSF_FRAME_HEARTBEAT_INDEX);
+        frameSchedulerAdd(&crsfFrameScheduler, 2, CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD, 100000, 1000000);
+        crsfSchedule[index++] = CRSF_FRAME_GPS_INDEX;
     }
 #endif
 
@@ -852,7 +883,13 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     // Send ad-hoc response frames as soon as possible
 #if defined(USE_MSP_OVER_TELEMETRY)
     if (mspReplyPending) {
-        mspReplyPending = handleCrsfMspFrameBuffer(&crsfSendMspResponse);
+        const int chunkCount = crsfMspChunksPerCall();
+        for (int i = 0; i < chunkCount && mspReplyPending; i++) {
+            if (i) {
+                crsfRxSendTelemetryData(); // hand the previous chunk to the UART before building the next
+            }
+            mspReplyPending = handleCrsfMspFrameBuffer(&crsfSendMspResponse);
+        }
         crsfLastCycleTime = currentTimeUs; // reset telemetry timing due to ad-hoc request
         return;
     }
@@ -917,12 +954,25 @@ void handleCrsfTelemetry(timeUs_t currentTimeUs)
     }
 #endif
 
-    // Actual telemetry data only needs to be sent at a low frequency, ie 10Hz
-    // Spread out scheduled frames evenly so each frame is sent at the same frequency.
-    if (currentTimeUs >= crsfLastCycleTime + (CRSF_CYCLETIME_US / crsfScheduleCount)) {
+    if (processCrsf(currentTimeUs)) {
         crsfLastCycleTime = currentTimeUs;
-        processCrsf();
+        return;
     }
+
+#if defined(USE_CRSF_V3)
+    // Fill gaps left by unchanged frames with heartbeats so a frame goes out at least every 20ms
+    if (cmpTimeUs(currentTimeUs, crsfLastCycleTime) >= CRSF_TELEMETRY_FRAME_INTERVAL_MAX_US && crsfRxIsTelemetryBufEmpty()) {
+        sbuf_t crsfPayloadBuf;
+        sbuf_t *dst = &crsfPayloadBuf;
+        crsfInitializeFrame(dst);
+        crsfFrameHeartbeat(dst);
+        // Not charged, at low rates a heartbeat every 20ms would use up the credit the scheduled frames are waiting for
+        crsfFinalizeFrame(dst, false);
+        crsfLastCycleTime = currentTimeUs;
+    }
+#else
+    UNUSED(crsfLastCycleTime);
+#endif
 }
 
 #if defined(UNIT_TEST) || defined(USE_RX_EXPRESSLRS)
@@ -0,0 +1,162 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef USE_TELEMETRY
+
+#include "common/maths.h"
+#include "common/time.h"
+
+#include "telemetry/frame_scheduler.h"
+
+// Fair queuing tag units per byte of a frame of weight 1
+#define FRAME_SCHEDULER_TAG_SCALE 256
+
+// Credit is capped so an idle link cannot save up more than a couple of frames
+#define FRAME_SCHEDULER_BURST_FRAMES 2
+
+// Longest gap between refills that is credited, keeps the credit arithmetic within 32 bits
+#define FRAME_SCHEDULER_REFILL_MAX_US 100000
+
+void frameSchedulerInit(frameScheduler_t *scheduler, uint32_t bytesPerSecond)
+{
+    memset(scheduler, 0, sizeof(*scheduler));
+    scheduler->bytesPerSecond = bytesPerSecond;
+}
+
+// Takes effect from the next refill, credit already earned is kept
+void frameSchedulerSetRate(frameScheduler_t *scheduler, uint32_t bytesPerSecond)
+{
+    scheduler->bytesPerSecond = bytesPerSecond;
+}
+
+// Returns the index of the new frame, or -1 if the scheduler is full
+int frameSchedulerAdd(frameScheduler_t *scheduler, uint8_t weight, uint8_t cost, timeDelta_t minIntervalUs, timeDelta_t maxIntervalUs)
+{
+    if (scheduler->entryCount >= FRAME_SCHEDULER_ENTRY_COUNT_MAX) {
+        return -1;
+    }
+
+    frameSchedulerEntry_t *entry = &scheduler->entries[scheduler->entryCount];
+    memset(entry, 0, sizeof(*entry));
+    entry->weight = MAX(weight, 1);
+    entry->cost = cost;
+    entry->minIntervalUs = minIntervalUs;
+    entry->maxIntervalUs = maxIntervalUs;
+    scheduler->costMax = MAX(scheduler->costMax, cost);
+
+    return scheduler->entryCount++;
+}
+
+static void frameSchedulerRefill(frameScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    const timeDelta_t elapsedUs = MIN(cmpTimeUs(currentTimeUs, scheduler->lastRefillAtUs), FRAME_SCHEDULER_REFILL_MAX_US);
+    scheduler->lastRefillAtUs = currentTimeUs;
+
+    if (elapsedUs > 0) {
+        const int32_t creditMax = scheduler->costMax * FRAME_SCHEDULER_BURST_FRAMES * 1000;
+        scheduler->creditMilliBytes = MIN(scheduler->creditMilliBytes + (int32_t)(scheduler->bytesPerSecond * elapsedUs / 1000), creditMax);
+    }
+}
+
+static uint32_t frameSchedulerFinishTag(const frameSchedulerEntry_t *entry)
+{
+    return entry->virtualStart + entry->cost * FRAME_SCHEDULER_TAG_SCALE / entry->weight;
+}
+
+static bool tagBefore(uint32_t a, uint32_t b)
+{
+    return (int32_t)(a - b) < 0;
+}
+
+// Returns the index of the frame to build next, or -1 if no frame is due or the budget does not allow one yet
+int frameSchedulerNext(frameScheduler_t *scheduler, timeUs_t currentTimeUs)
+{
+    frameSchedulerRefill(scheduler, currentTimeUs);
+
+    int best = -1;
+    uint32_t bestFinish = 0;
+    for (int i = 0; i < scheduler->entryCount; i++) {
+        frameSchedulerEntry_t *entry = &scheduler->entries[i];
+        if (entry->sent && cmpTimeUs(currentTimeUs, entry->nextDueAtUs) < 0) {
+            continue;
+        }
+
+        if (!entry->queued) {
+            // A frame that has been idle starts from the current virtual time rather than catching up
+            entry->virtualStart = tagBefore(entry->virtualFinish, scheduler->virtualTime) ? scheduler->virtualTime : entry->virtualFinish;
+            entry->queued = true;
+        }
+
+        const uint32_t finish = frameSchedulerFinishTag(entry);
+        if (best < 0 || tagBefore(finish, bestFinish)) {
+            best = i;
+            bestFinish = finish;
+        }
+    }
+
+    if (best >= 0 && scheduler->creditMilliBytes < scheduler->entries[best].cost * 1000) {
+        return -1;
+    }
+
+    return best;
+}
+
+// Called with a signature of the built frame's contents, returns true if the frame should be sent.
+// The caller charges the bytes it then writes with frameSchedulerCharge()
+bool frameSchedulerCommit(frameScheduler_t *scheduler, int index, timeUs_t currentTimeUs, uint16_t signature)
+{
+    frameSchedulerEntry_t *entry = &scheduler->entries[index];
+
+    entry->nextDueAtUs = currentTimeUs + entry->minIntervalUs;
+    entry->queued = false;
+
+    if (entry->sent && signature == entry->signature && cmpTimeUs(currentTimeUs, entry->lastSentAtUs) < entry->maxIntervalUs) {
+        // Unchanged, look again once the minimum interval has passed
+        return false;
+    }
+
+    entry->virtualFinish = frameSchedulerFinishTag(entry);
+    if (tagBefore(scheduler->virtualTime, entry->virtualStart)) {
+        scheduler->virtualTime = entry->virtualStart;
+    }
+
+    entry->lastSentAtUs = currentTimeUs;
+    entry->signature = signature;
+    entry->sent = true;
+
+    return true;
+}
+
+// Account for a frame written to the link, scheduled or not.
+// The debt is bounded like the credit, so a burst of ad-hoc frames delays scheduled frames by a
+// couple of frame times at most rather than starving them for as long as the burst lasted
+void frameSchedulerCharge(frameScheduler_t *scheduler, uint8_t cost)
+{
+    const int32_t debtMax = scheduler->costMax * FRAME_SCHEDULER_BURST_FRAMES * 1000;
+    scheduler->creditMilliBytes = MAX(scheduler->creditMilliBytes - cost * 1000, -debtMax);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "common/time.h"
+
+/*
+ * Shared telemetry frame scheduler.
+ *
+ * Each frame type registers a weight, the air time it costs and its minimum and maximum update
+ * intervals. Frames are picked by weighted fair queuing within a byte rate budget, so a frame with
+ * twice the weight gets twice the share of the link when everything is due. A frame whose contents
+ * have not changed since it was last sent is skipped until its maximum interval expires.
+ *
+ * The byte rate is set by the protocol from what its link can carry, e.g. from the RC packet rate,
+ * and can be changed at any time.
+ */
+
+#define FRAME_SCHEDULER_ENTRY_COUNT_MAX 8
+
+typedef struct frameSchedulerEntry_s {
+    // Configuration
+    uint8_t weight;                 // share of the link relative to the other frames
+    uint8_t cost;                   // bytes of air time the frame takes
+    timeDelta_t minIntervalUs;      // never sent more often than this
+    timeDelta_t maxIntervalUs;      // resent at least this often even if unchanged
+
+    // State
+    uint32_t virtualStart;          // fair queuing start tag, assigned when the frame falls due
+    uint32_t virtualFinish;         // fair queuing finish tag of the last transmission
+    timeUs_t lastSentAtUs;
+    timeUs_t nextDueAtUs;
+    uint16_t signature;             // contents of the last transmission
+    bool sent;
+    bool queued;                    // due and waiting for its turn
+} frameSchedulerEntry_t;
+
+typedef struct frameScheduler_s {
+    frameSchedulerEntry_t entries[FRAME_SCHEDULER_ENTRY_COUNT_MAX];
+    uint8_t entryCount;
+    uint8_t costMax;
+    uint32_t virtualTime;
+    uint32_t bytesPerSecond;        // current budget
+    int32_t creditMilliBytes;       // bytes that may be sent now, in thousandths
+    timeUs_t lastRefillAtUs;
+} frameScheduler_t;
+
+void frameSchedulerInit(frameScheduler_t *scheduler, uint32_t bytesPerSecond);
+void frameSchedulerSetRate(frameScheduler_t *scheduler, uint32_t bytesPerSecond);
+int frameSchedulerAdd(frameScheduler_t *scheduler, uint8_t weight, uint8_t cost, timeDelta_t minIntervalUs, timeDelta_t maxIntervalUs);
+int frameSchedulerNext(frameScheduler_t *scheduler, timeUs_t currentTimeUs);
+bool frameSchedulerCommit(frameScheduler_t *scheduler, int index, timeUs_t currentTimeUs, uint16_t signature);
+void frameSchedulerCharge(frameScheduler_t *scheduler, uint8_t cost);
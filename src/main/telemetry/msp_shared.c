@@ -31,6 +31,9 @@
 #include "common/utils.h"
 #include "common/crc.h"
 #include "common/streambuf.h"
+#include "common/time.h"
+
+#include "drivers/time.h"
 
 #include "msp/msp.h"
 #include "msp/msp_protocol.h"
@@ -122,17 +125,25 @@ enum { // byte position(index) in msp-over-telemetry request payload
 };
 
 STATIC_UNIT_TESTED uint8_t requestBuffer[MSP_TLM_INBUF_SIZE];
-STATIC_UNIT_TESTED uint8_t responseBuffer[MSP_TLM_OUTBUF_SIZE];
 STATIC_UNIT_TESTED mspPacket_t requestPacket;
-STATIC_UNIT_TESTED mspPacket_t responsePacket;
+STATIC_UNIT_TESTED mspTlmResponse_t responses[MSP_TLM_RESPONSE_COUNT];
 static uint8_t lastRequestVersion; // MSP version of last request. Temporary solution. It's better to keep it in requestPacket.
 
+static uint8_t responseQueue[MSP_TLM_RESPONSE_COUNT];
+static uint8_t responseQueueHead;
+static uint8_t responseQueueCount;
+static uint16_t responseOffset;     // bytes of the response at the head of the queue already sent
+static bool responseStarted;
+
 static mspDescriptor_t mspSharedDescriptor = -1;
 
 void initSharedMsp(void)
 {
-    responsePacket.buf.ptr = responseBuffer;
-    responsePacket.buf.end = ARRAYEND(responseBuffer);
+    memset(responses, 0, sizeof(responses));
+    responseQueueHead = 0;
+    responseQueueCount = 0;
+    responseOffset = 0;
+    responseStarted = false;
 
     mspSharedDescriptor = mspDescriptorAlloc();
 }
@@ -142,33 +153,165 @@ mspDescriptor_t getMspTelemetryDescriptor(void)
     return mspSharedDescriptor;
 }
 
-static void processMspPacket(void)
+bool hasPendingMspReply(void)
+{
+    return responseQueueCount > 0;
+}
+
+bool isMspReplyQueueFull(void)
+{
+    return responseQueueCount >= MSP_TLM_RESPONSE_COUNT;
+}
+
+// Reads without arguments whose responses are fixed by the firmware build. Configuration that can be changed at
+// runtime (profile switches, adjustments, the CLI or another MSP port) is never cached, as clients read, modify and
+// write it back.
+static bool isCacheableRequest(mspPacket_t *request)
+{
+    if (sbufBytesRemaining(&request->buf)) {
+        return false;
+    }
+
+    switch (request->cmd) {
+    case MSP_API_VERSION:
+    case MSP_FC_VARIANT:
+    case MSP_FC_VERSION:
+    case MSP_BOARD_INFO:
+    case MSP_BUILD_INFO:
+    case MSP_BOXNAMES:
+    case MSP_BOXIDS:
+    case MSP_PIDNAMES:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void invalidateMspResponseCache(void)
+{
+    for (int i = 0; i < MSP_TLM_RESPONSE_COUNT; i++) {
+        responses[i].cached = false;
+    }
+}
+
+static mspTlmResponse_t *findCachedMspResponse(int16_t cmd, uint8_t version)
+{
+    for (int i = 0; i < MSP_TLM_RESPONSE_COUNT; i++) {
+        mspTlmResponse_t *response = &responses[i];
+        if (response->cached && response->packet.cmd == cmd && response->version == version) {
+            return response;
+        }
+    }
+    return NULL;
+}
+
+// Picks a slot that is not waiting to be sent, preferring one that holds no cached response
+static mspTlmResponse_t *allocMspResponse(void)
+{
+    mspTlmResponse_t *oldest = NULL;
+    for (int i = 0; i < MSP_TLM_RESPONSE_COUNT; i++) {
+        mspTlmResponse_t *response = &responses[i];
+        if (response->queuedCount) {
+            continue;
+        }
+        if (!response->cached) {
+            return response;
+        }
+        if (!oldest || cmpTimeUs(response->cachedAtUs, oldest->cachedAtUs) < 0) {
+            oldest = response;
+        }
+    }
+    if (oldest) {
+        oldest->cached = false;
+    }
+    return oldest;
+}
+
+static void resetMspResponse(mspTlmResponse_t *response, int16_t cmd)
 {
-    responsePacket.cmd = 0;
-    responsePacket.result = 0;
-    responsePacket.buf.ptr = responseBuffer;
-    responsePacket.buf.end = ARRAYEND(responseBuffer);
+    response->packet.cmd = cmd;
+    response->packet.flags = 0;
+    response->packet.result = 0;
+    response->packet.buf.ptr = response->buffer;
+    response->packet.buf.end = ARRAYEND(response->buffer);
+    response->version = lastRequestVersion;
+}
+
+static bool queueMspResponse(mspTlmResponse_t *response)
+{
+    if (isMspReplyQueueFull()) {
+        return false;
+    }
+
+    responseQueue[(responseQueueHead + responseQueueCount) % MSP_TLM_RESPONSE_COUNT] = response - responses;
+    responseQueueCount++;
+    response->queuedCount++;
+    return true;
+}
+
+static bool processMspPacket(void)
+{
+    // Refused before the command is run, as there would be no way to reply. The link handlers hold
+    // their requests back while the queue is full, so this only drops a request from a misbehaving one
+    if (isMspReplyQueueFull()) {
+        return false;
+    }
+
+    const timeUs_t currentTimeUs = micros();
+    const bool cacheable = isCacheableRequest(&requestPacket);
+
+    if (cacheable) {
+        mspTlmResponse_t *cachedResponse = findCachedMspResponse(requestPacket.cmd, lastRequestVersion);
+        if (cachedResponse) {
+            return queueMspResponse(cachedResponse);
+        }
+    } else if (sbufBytesRemaining(&requestPacket.buf) || requestPacket.cmd == MSP_RESET_CONF) {
+        // Anything that carries data may change the configuration, e.g. MSP_SET_BOARD_INFO
+        invalidateMspResponseCache();
+    }
+
+    mspTlmResponse_t *response = allocMspResponse();
+    if (!response) {
+        return false;
+    }
+    resetMspResponse(response, 0);
 
     mspPostProcessFnPtr mspPostProcessFn = NULL;
-    if (mspFcProcessCommand(mspSharedDescriptor, &requestPacket, &responsePacket, &mspPostProcessFn) == MSP_RESULT_ERROR) {
-        sbufWriteU8(&responsePacket.buf, TELEMETRY_MSP_ERROR);
+    const mspResult_e result = mspFcProcessCommand(mspSharedDescriptor, &requestPacket, &response->packet, &mspPostProcessFn);
+    if (result == MSP_RESULT_ERROR) {
+        sbufWriteU8(&response->packet.buf, TELEMETRY_MSP_ERROR);
     }
     if (mspPostProcessFn) {
         mspPostProcessFn(NULL);
     }
 
-    sbufSwitchToReader(&responsePacket.buf, responseBuffer);
+    sbufSwitchToReader(&response->packet.buf, response->buffer);
+
+    if (cacheable && result != MSP_RESULT_ERROR) {
+        response->cached = true;
+        response->cachedAtUs = currentTimeUs;
+    }
+
+    return queueMspResponse(response);
 }
 
-void sendMspErrorResponse(uint8_t error, int16_t cmd)
+static bool sendMspErrorResponse(uint8_t error, int16_t cmd)
 {
-    responsePacket.cmd = cmd;
-    responsePacket.result = 0;
-    responsePacket.buf.ptr = responseBuffer;
+    if (isMspReplyQueueFull()) {
+        return false;
+    }
 
-    sbufWriteU8(&responsePacket.buf, error);
-    responsePacket.result = TELEMETRY_MSP_RES_ERROR;
-    sbufSwitchToReader(&responsePacket.buf, responseBuffer);
+    mspTlmResponse_t *response = allocMspResponse();
+    if (!response) {
+        return false;
+    }
+    resetMspResponse(response, cmd);
+
+    sbufWriteU8(&response->packet.buf, error);
+    response->packet.result = TELEMETRY_MSP_RES_ERROR;
+    sbufSwitchToReader(&response->packet.buf, response->buffer);
+
+    return queueMspResponse(response);
 }
 
 // despite its name, the function actually handles telemetry frame payload with MSP in it
@@ -189,8 +332,7 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
     lastRequestVersion = (status & MSP_STATUS_VERSION_MASK) >> MSP_STATUS_VERSION_SHIFT;
 
     if (lastRequestVersion > TELEMETRY_MSP_VERSION) {
-        sendMspErrorResponse(TELEMETRY_MSP_VER_MISMATCH, 0);
-        return true;
+        return sendMspErrorResponse(TELEMETRY_MSP_VER_MISMATCH, 0);
     }
 
     if (status & MSP_STATUS_START_MASK) { // first packet in sequence
@@ -226,8 +368,7 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
             requestPacket.buf.end = requestBuffer + mspPayloadSize;
             mspStarted = 1;
         } else { // this MSP packet is too big to fit in the buffer.
-            sendMspErrorResponse(TELEMETRY_MSP_REQUEST_IS_TOO_BIG, requestPacket.cmd);
-            return true;
+            return sendMspErrorResponse(TELEMETRY_MSP_REQUEST_IS_TOO_BIG, requestPacket.cmd);
         }
     } else { // second onward chunk
         if (!mspStarted) { // no start packet yet, throw this one away
@@ -265,65 +406,79 @@ bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t
 
     mspStarted = 0;
     sbufSwitchToReader(&requestPacket.buf, requestBuffer);
-    processMspPacket();
-    return true;
+    return processMspPacket();
 }
 
 bool sendMspReply(const uint8_t payloadSizeMax, mspResponseFnPtr responseFn)
 {
     static uint8_t seq = 0;
 
+    if (!responseQueueCount) {
+        return false;
+    }
+
+    mspTlmResponse_t *response = &responses[responseQueue[responseQueueHead]];
+    const mspPacket_t *responsePacket = &response->packet;
+    const uint8_t version = response->version;
+
     uint8_t payloadArray[payloadSizeMax];
     sbuf_t payloadBufStruct;
     sbuf_t *payloadBuf = sbufInit(&payloadBufStruct, payloadArray, payloadArray + payloadSizeMax);
 
+    const int size = responsePacket->buf.end - response->buffer;  // size might be bigger than 0xff
+
     // detect first reply packet
-    if (responsePacket.buf.ptr == responseBuffer) {
+    if (!responseStarted) {
         // this is the first frame of the response packet. Add proper header and size.
         // header
-        uint8_t status = MSP_STATUS_START_MASK | (seq++ & MSP_STATUS_SEQUENCE_MASK) | (lastRequestVersion << MSP_STATUS_VERSION_SHIFT);
-        if (responsePacket.result < 0) {
+        uint8_t status = MSP_STATUS_START_MASK | (seq++ & MSP_STATUS_SEQUENCE_MASK) | (version << MSP_STATUS_VERSION_SHIFT);
+        if (responsePacket->result < 0) {
             status |= MSP_STATUS_ERROR_MASK;
         }
         sbufWriteU8(payloadBuf, status);
 
-        const int size = sbufBytesRemaining(&responsePacket.buf);  // size might be bigger than 0xff
-        if (lastRequestVersion == 1) { // MSPv1
+        if (version == 1) { // MSPv1
             if (size >= 0xff) {
                 // Sending Jumbo-frame
                 sbufWriteU8(payloadBuf, 0xff);
-                sbufWriteU8(payloadBuf, responsePacket.cmd); 
+                sbufWriteU8(payloadBuf, responsePacket->cmd);
                 sbufWriteU16(payloadBuf, (uint16_t)size);
             } else {
                 sbufWriteU8(payloadBuf, size);
-                sbufWriteU8(payloadBuf, responsePacket.cmd); 
+                sbufWriteU8(payloadBuf, responsePacket->cmd);
             }
         } else { // MSPv2
-            sbufWriteU8 (payloadBuf, responsePacket.flags);  // MSPv2 flags
-            sbufWriteU16(payloadBuf, responsePacket.cmd);    // command is 16 bit in MSPv2
-            sbufWriteU16(payloadBuf, (uint16_t)size);        // size is 16 bit in MSPv2
+            sbufWriteU8 (payloadBuf, responsePacket->flags);  // MSPv2 flags
+            sbufWriteU16(payloadBuf, responsePacket->cmd);    // command is 16 bit in MSPv2
+            sbufWriteU16(payloadBuf, (uint16_t)size);         // size is 16 bit in MSPv2
         }
+        responseStarted = true;
     } else {
-        sbufWriteU8(payloadBuf, (seq++ & MSP_STATUS_SEQUENCE_MASK) | (lastRequestVersion << MSP_STATUS_VERSION_SHIFT)); // header without 'start' flag
+        sbufWriteU8(payloadBuf, (seq++ & MSP_STATUS_SEQUENCE_MASK) | (version << MSP_STATUS_VERSION_SHIFT)); // header without 'start' flag
     }
 
-    const int inputRemainder = sbufBytesRemaining(&responsePacket.buf);// size might be bigger than 0xff
+    const int inputRemainder = size - responseOffset;
     const int chunkRemainder = sbufBytesRemaining(payloadBuf); // free space remainder for current chunk
 
     if (inputRemainder >= chunkRemainder) {
         // partial send
-        sbufWriteData(payloadBuf, responsePacket.buf.ptr, chunkRemainder);
-        sbufAdvance(&responsePacket.buf, chunkRemainder);
+        sbufWriteData(payloadBuf, response->buffer + responseOffset, chunkRemainder);
+        responseOffset += chunkRemainder;
         responseFn(payloadArray, payloadSizeMax);
         return true;
     }
     // last/only chunk
-    sbufWriteData(payloadBuf, responsePacket.buf.ptr, inputRemainder);
-    sbufAdvance(&responsePacket.buf, inputRemainder);
-    sbufSwitchToReader(&responsePacket.buf, responseBuffer);// for CRC calculation
+    sbufWriteData(payloadBuf, response->buffer + responseOffset, inputRemainder);
+
+    // the response stays in its slot, a cached one can be sent again
+    response->queuedCount--;
+    responseQueueHead = (responseQueueHead + 1) % MSP_TLM_RESPONSE_COUNT;
+    responseQueueCount--;
+    responseOffset = 0;
+    responseStarted = false;
 
     responseFn(payloadArray, payloadBuf->ptr - payloadArray);
-    return false;
+    return responseQueueCount > 0;
 }
 
 #endif
@@ -20,11 +20,31 @@
 
 #pragma once
 
+#include "common/time.h"
+
 #include "msp/msp.h"
+#include "msp/msp_serial.h"
 
 #define MSP_TLM_INBUF_SIZE MSP_PORT_INBUF_SIZE
 #define MSP_TLM_OUTBUF_SIZE MSP_PORT_OUTBUF_SIZE_MIN
 
+// Responses are queued so that several requests can be in flight over the link at once. A response
+// slot that is not queued keeps its contents, so a repeated read-only query can be answered from it.
+// Each slot takes about 350 bytes of RAM, targets short of RAM can define a count of 1 for the old
+// one request at a time behaviour.
+#ifndef MSP_TLM_RESPONSE_COUNT
+#define MSP_TLM_RESPONSE_COUNT 3
+#endif
+
+typedef struct mspTlmResponse_s {
+    mspPacket_t packet;
+    uint8_t buffer[MSP_TLM_OUTBUF_SIZE];
+    uint8_t version;                // MSP version of the request
+    uint8_t queuedCount;            // times the response is in the send queue
+    bool cached;
+    timeUs_t cachedAtUs;
+} mspTlmResponse_t;
+
 // type of function to send MSP response chunk over telemetry.
 typedef void (*mspResponseFnPtr)(uint8_t *payload, const uint8_t payloadSize);
 
@@ -36,5 +56,11 @@ mspDescriptor_t getMspTelemetryDescriptor(void);
 // receives telemetry payload with msp and handles it.
 bool handleMspFrame(uint8_t *const payload, uint8_t const payloadLength, uint8_t *const skipsBeforeResponse);
 
-// sends MSP reply from previously handled msp-request over telemetry
+// sends the next chunk of the queued MSP replies over telemetry, returns true while more remain
 bool sendMspReply(const uint8_t payloadSize_max, mspResponseFnPtr responseFn);
+
+// true while MSP replies are waiting to be sent
+bool hasPendingMspReply(void);
+
+// true when no further request can be handled until a reply has been sent
+bool isMspReplyQueueFull(void);
@@ -209,7 +209,14 @@ typedef struct smartPortFrame_s {
 static smartPortWriteFrameFn *smartPortWriteFrame;
 
 #if defined(USE_MSP_OVER_TELEMETRY)
+#define SMARTPORT_MSP_RX_BUFFER_FRAMES 16
+
 static bool smartPortMspReplyPending = false;
+
+// MSP frames are held here while the response queue is full, there is no way to have them sent again
+static uint8_t smartPortMspRxBuffer[SMARTPORT_MSP_RX_BUFFER_FRAMES][SMARTPORT_MSP_PAYLOAD_SIZE];
+static uint8_t smartPortMspRxHead;
+static uint8_t smartPortMspRxCount;
 #endif
 
 smartPortPayload_t *smartPortDataReceive(uint16_t c, bool *clearToSend, smartPortReadyToSendFn *readyToSend, bool useChecksum)
@@ -530,12 +537,23 @@ void processSmartPortTelemetry(smartPortPayload_t *payload, volatile bool *clear
 #if defined(USE_MSP_OVER_TELEMETRY)
     if (skipRequests) {
         skipRequests--;
-    } else if (payload && smartPortPayloadContainsMSP(payload)) {
+    } else {
         // Do not check the physical ID here again
         // unless we start receiving other sensors' packets
         // Pass only the payload: skip frameId
-        uint8_t *frameStart = (uint8_t *)&payload->valueId;
-        smartPortMspReplyPending = handleMspFrame(frameStart, SMARTPORT_MSP_PAYLOAD_SIZE, &skipRequests);
+        if (payload && smartPortPayloadContainsMSP(payload) && smartPortMspRxCount < SMARTPORT_MSP_RX_BUFFER_FRAMES) {
+            const uint8_t tail = (smartPortMspRxHead + smartPortMspRxCount) % SMARTPORT_MSP_RX_BUFFER_FRAMES;
+            memcpy(smartPortMspRxBuffer[tail], &payload->valueId, SMARTPORT_MSP_PAYLOAD_SIZE);
+            smartPortMspRxCount++;
+        }
+
+        // Only take frames while there is room to queue their responses, a full queue would drop the request
+        while (smartPortMspRxCount && !isMspReplyQueueFull() && !skipRequests) {
+            handleMspFrame(smartPortMspRxBuffer[smartPortMspRxHead], SMARTPORT_MSP_PAYLOAD_SIZE, &skipRequests);
+            smartPortMspRxHead = (smartPortMspRxHead + 1) % SMARTPORT_MSP_RX_BUFFER_FRAMES;
+            smartPortMspRxCount--;
+        }
+        smartPortMspReplyPending = hasPendingMspReply(); // a partial request must not hold up a queued reply
 
         // Don't send MSP response after write to eeprom
         // CPU just got out of suspended state after writeEEPROM()
@@ -1073,6 +1073,7 @@ extern "C" {
     void pidStabilisationState(pidStabilisationState_e) {}
     void mixTable(timeUs_t) {};
     void writeMotors(void) {};
+    void writeMotorsAtPhase(timeUs_t) {};
     void writeServos(void) {};
     bool calculateRxChannelsAndUpdateFailsafe(timeUs_t) { return true; }
     bool isMixerUsingServos(void) { return false; }
@@ -1135,6 +1136,7 @@ extern "C" {
     void pinioBoxTaskControl(void) {}
     void schedulerSetNextStateTime(timeDelta_t) {}
     float getAltitude(void) { return 3000.0f; }
+    float getAltitudeDerivative(void) { return 0.0f; }
     float pt1FilterGain(float, float) { return 0.5f; }
     float pt2FilterGain(float, float)  { return 0.1f; }
     float pt3FilterGain(float, float)  { return 0.1f; }
@@ -0,0 +1,159 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "platform.h"
+#include "target.h"
+#include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_2smpb_02b.h"
+#include "drivers/bus.h"
+
+}
+
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define REG_CHIP_ID             0xD1
+#define REG_CTRL_MEAS           0xF4
+#define REG_PRESS_TXD2          0xF7
+#define BARO_2SMBP_CHIP_ID      0x5C
+#define REG_CLT_MEAS_VAL_TAVG4X_PAVG32X_FORCED ((0x03 << 5) | (0x05 << 2) | 0x01)
+
+static uint8_t registers[256];
+static int busyPolls;
+static int blockingWrites;
+static int queuedWrites;
+static uint8_t queuedWriteReg;
+static uint8_t queuedWriteValue;
+static int readStarts;
+static uint8_t readStartReg;
+
+static busDevice_t baroBus;
+static baroDev_t baro;
+
+static void b2smpbSetup(void)
+{
+    memset(registers, 0, sizeof(registers));
+    registers[REG_CHIP_ID] = BARO_2SMBP_CHIP_ID;
+
+    memset(&baro, 0, sizeof(baro));
+    baroBus.busType = BUS_TYPE_I2C;
+    baro.dev.bus = &baroBus;
+    ASSERT_TRUE(baro2SMPB02BDetect(&baro));
+
+    busyPolls = 0;
+    blockingWrites = 0;
+    queuedWrites = 0;
+    readStarts = 0;
+}
+
+TEST(baro2smpbTest, TestStartQueuesForcedMeasurement)
+{
+    b2smpbSetup();
+
+    baro.start_up(&baro);
+
+    EXPECT_EQ(0, blockingWrites);
+    EXPECT_EQ(1, queuedWrites);
+    EXPECT_EQ(REG_CTRL_MEAS, queuedWriteReg);
+    EXPECT_EQ(REG_CLT_MEAS_VAL_TAVG4X_PAVG32X_FORCED, queuedWriteValue);
+}
+
+TEST(baro2smpbTest, TestReadWaitsForTrigger)
+{
+    b2smpbSetup();
+
+    baro.start_up(&baro);
+
+    busyPolls = 1;
+    EXPECT_FALSE(baro.read_up(&baro));
+    EXPECT_EQ(0, readStarts);
+
+    EXPECT_TRUE(baro.read_up(&baro));
+    EXPECT_EQ(1, readStarts);
+    EXPECT_EQ(REG_PRESS_TXD2, readStartReg);
+}
+
+TEST(baro2smpbTest, TestGetWaitsForData)
+{
+    b2smpbSetup();
+
+    baro.start_up(&baro);
+    EXPECT_TRUE(baro.read_up(&baro));
+
+    busyPolls = 2;
+    EXPECT_FALSE(baro.get_up(&baro));
+    EXPECT_FALSE(baro.get_up(&baro));
+    EXPECT_TRUE(baro.get_up(&baro));
+    EXPECT_EQ(0, blockingWrites);
+}
+
+// STUBS
+
+extern "C" {
+
+void delay(uint32_t) {}
+
+bool busBusy(const extDevice_t*, bool*)
+{
+    if (busyPolls > 0) {
+        busyPolls--;
+        return true;
+    }
+    return false;
+}
+
+uint8_t busReadRegister(const extDevice_t*, uint8_t reg)
+{
+    return registers[reg];
+}
+
+bool busReadRegisterBuffer(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &registers[reg], length);
+    return true;
+}
+
+bool busReadRegisterBufferStart(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &registers[reg], length);
+    readStarts++;
+    readStartReg = reg;
+    return true;
+}
+
+bool busWriteRegister(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    blockingWrites++;
+    return true;
+}
+
+bool busWriteRegisterStart(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    queuedWrites++;
+    queuedWriteReg = reg;
+    queuedWriteValue = data;
+    return true;
+}
+
+}
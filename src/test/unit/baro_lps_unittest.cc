@@ -0,0 +1,198 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "platform.h"
+#include "target.h"
+#include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_lps.h"
+#include "drivers/bus.h"
+
+}
+
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define LPS_WHO_AM_I    0x0F
+#define LPS_STATUS      0x27
+#define LPS25_ID        0xBD
+
+// register file of the fake sensor, reads auto-increment through it
+static uint8_t lpsRegisters[0x40];
+static bool busInUse;
+static int busyPolls;
+static int burstReads;
+
+static busDevice_t lpsBus;
+static baroDev_t lpsBaro;
+
+static void lpsSetSample(uint8_t status, uint32_t pressure, uint16_t temperature)
+{
+    lpsRegisters[LPS_STATUS] = status;
+    lpsRegisters[LPS_STATUS + 1] = pressure & 0xff;
+    lpsRegisters[LPS_STATUS + 2] = (pressure >> 8) & 0xff;
+    lpsRegisters[LPS_STATUS + 3] = (pressure >> 16) & 0xff;
+    lpsRegisters[LPS_STATUS + 4] = temperature & 0xff;
+    lpsRegisters[LPS_STATUS + 5] = temperature >> 8;
+}
+
+static void lpsSetup(void)
+{
+    memset(lpsRegisters, 0, sizeof(lpsRegisters));
+    lpsRegisters[LPS_WHO_AM_I] = LPS25_ID;
+    busInUse = false;
+    busyPolls = 0;
+    burstReads = 0;
+
+    memset(&lpsBaro, 0, sizeof(lpsBaro));
+    lpsBus.busType = BUS_TYPE_SPI;
+    lpsBaro.dev.bus = &lpsBus;
+
+    lpsSetSample(0x03, 1, 1);
+    ASSERT_TRUE(lpsDetect(&lpsBaro));
+    burstReads = 0;
+}
+
+TEST(baroLpsTest, TestLpsDetect)
+{
+    lpsSetup();
+
+    EXPECT_TRUE(lpsBaro.combined_read);
+    EXPECT_NE(nullptr, lpsBaro.read_up);
+    EXPECT_NE(nullptr, lpsBaro.get_up);
+}
+
+TEST(baroLpsTest, TestLpsReadRetriedWhileBusInUse)
+{
+    lpsSetup();
+    lpsSetSample(0x03, 0x3f0000, 480);
+
+    busInUse = true;
+    EXPECT_FALSE(lpsBaro.read_up(&lpsBaro));
+    EXPECT_EQ(0, burstReads);
+
+    busInUse = false;
+    EXPECT_TRUE(lpsBaro.read_up(&lpsBaro));
+    EXPECT_EQ(1, burstReads);
+}
+
+TEST(baroLpsTest, TestLpsSampleTakenOnceTransferComplete)
+{
+    lpsSetup();
+    lpsSetSample(0x03, 0x3f0000, 480);
+
+    EXPECT_TRUE(lpsBaro.read_up(&lpsBaro));
+
+    busyPolls = 2;
+    EXPECT_FALSE(lpsBaro.get_up(&lpsBaro));
+    EXPECT_FALSE(lpsBaro.get_up(&lpsBaro));
+    EXPECT_TRUE(lpsBaro.get_up(&lpsBaro));
+
+    int32_t pressure, temperature;
+    lpsBaro.calculate(&pressure, &temperature);
+    EXPECT_EQ(100800, pressure); // 0x3f0000 / 4096 hPa
+    EXPECT_EQ(4350, temperature); // 42.5 + 480 / 480 degC, in centidegrees
+}
+
+TEST(baroLpsTest, TestLpsNoNewSample)
+{
+    lpsSetup();
+    lpsSetSample(0x00, 0x3f0000, 480);
+
+    EXPECT_TRUE(lpsBaro.read_up(&lpsBaro));
+    EXPECT_TRUE(lpsBaro.get_up(&lpsBaro));
+
+    int32_t pressure, temperature;
+    lpsBaro.calculate(&pressure, &temperature);
+    EXPECT_EQ(0, pressure);
+}
+
+// STUBS
+
+extern "C" {
+
+static uint32_t fakeMillis;
+uint32_t millis(void) { return fakeMillis++; }
+void delay(uint32_t) {}
+
+bool busBusy(const extDevice_t*, bool*)
+{
+    if (busyPolls > 0) {
+        busyPolls--;
+        return true;
+    }
+    return false;
+}
+
+bool busReadRegisterBufferStart(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    if (busInUse) {
+        return false;
+    }
+    memcpy(data, &lpsRegisters[reg & 0x3f], length);
+    burstReads++;
+    return true;
+}
+
+bool spiReadRegMskBufRB(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &lpsRegisters[reg & 0x3f], length);
+    return true;
+}
+
+bool spiWriteRegRB(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    lpsRegisters[reg & 0x3f] = data;
+    return true;
+}
+
+void spiWriteReg(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    lpsRegisters[reg & 0x3f] = data;
+}
+
+uint8_t spiReadRegMsk(const extDevice_t*, uint8_t reg)
+{
+    return lpsRegisters[reg & 0x3f];
+}
+
+uint16_t spiCalculateDivider()
+{
+    return 2;
+}
+
+void spiSetClkDivisor()
+{
+}
+
+void IOConfigGPIO()
+{
+}
+
+void IOHi()
+{
+}
+
+void IOInit()
+{
+}
+
+}
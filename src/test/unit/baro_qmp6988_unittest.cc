@@ -0,0 +1,166 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "platform.h"
+#include "target.h"
+#include "drivers/barometer/barometer.h"
+#include "drivers/barometer/barometer_qmp6988.h"
+#include "drivers/bus.h"
+
+extern int32_t qmp6988_up;
+extern int32_t qmp6988_ut;
+
+}
+
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define QMP6988_DEFAULT_CHIP_ID         0x5c
+#define QMP6988_CHIP_ID_REG             0xD1
+#define QMP6988_CTRL_MEAS_REG           0xF4
+#define QMP6988_PRESSURE_MSB_REG        0xF7
+#define QMP6988_PWR_SAMPLE_MODE         0x7B
+
+static uint8_t registers[256];
+static int busyPolls;
+static int blockingWrites;
+static int queuedWrites;
+static uint8_t queuedWriteReg;
+static uint8_t queuedWriteValue;
+static int readStarts;
+static uint8_t readStartReg;
+
+static busDevice_t baroBus;
+static baroDev_t baro;
+
+static void qmp6988Setup(void)
+{
+    memset(registers, 0, sizeof(registers));
+    registers[QMP6988_CHIP_ID_REG] = QMP6988_DEFAULT_CHIP_ID;
+
+    memset(&baro, 0, sizeof(baro));
+    baroBus.busType = BUS_TYPE_I2C;
+    baro.dev.bus = &baroBus;
+    ASSERT_TRUE(qmp6988Detect(&baro));
+
+    busyPolls = 0;
+    blockingWrites = 0;
+    queuedWrites = 0;
+    readStarts = 0;
+}
+
+TEST(baroQmp6988Test, TestStartQueuesMeasurement)
+{
+    qmp6988Setup();
+
+    baro.start_up(&baro);
+
+    EXPECT_EQ(0, blockingWrites);
+    EXPECT_EQ(1, queuedWrites);
+    EXPECT_EQ(QMP6988_CTRL_MEAS_REG, queuedWriteReg);
+    EXPECT_EQ(QMP6988_PWR_SAMPLE_MODE, queuedWriteValue);
+}
+
+TEST(baroQmp6988Test, TestReadWaitsForTrigger)
+{
+    qmp6988Setup();
+
+    baro.start_up(&baro);
+
+    busyPolls = 1;
+    EXPECT_FALSE(baro.read_up(&baro));
+    EXPECT_EQ(0, readStarts);
+
+    EXPECT_TRUE(baro.read_up(&baro));
+    EXPECT_EQ(1, readStarts);
+    EXPECT_EQ(QMP6988_PRESSURE_MSB_REG, readStartReg);
+}
+
+TEST(baroQmp6988Test, TestSampleTakenOnceTransferComplete)
+{
+    qmp6988Setup();
+    const uint8_t frame[] = { 0x81, 0x23, 0x45, 0x7f, 0xed, 0xcb };
+    memcpy(&registers[QMP6988_PRESSURE_MSB_REG], frame, sizeof(frame));
+    qmp6988_up = 0;
+    qmp6988_ut = 0;
+
+    baro.start_up(&baro);
+    EXPECT_TRUE(baro.read_up(&baro));
+
+    busyPolls = 2;
+    EXPECT_FALSE(baro.get_up(&baro));
+    EXPECT_FALSE(baro.get_up(&baro));
+    EXPECT_EQ(0, qmp6988_up);
+
+    EXPECT_TRUE(baro.get_up(&baro));
+    EXPECT_EQ(0x812345, qmp6988_up);
+    EXPECT_EQ(0x7fedcb, qmp6988_ut);
+}
+
+// STUBS
+
+extern "C" {
+
+void delay(uint32_t) {}
+
+bool busBusy(const extDevice_t*, bool*)
+{
+    if (busyPolls > 0) {
+        busyPolls--;
+        return true;
+    }
+    return false;
+}
+
+bool busReadRegisterBuffer(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &registers[reg], length);
+    return true;
+}
+
+bool busReadRegisterBufferStart(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &registers[reg], length);
+    readStarts++;
+    readStartReg = reg;
+    return true;
+}
+
+bool busWriteRegister(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    blockingWrites++;
+    return true;
+}
+
+bool busWriteRegisterStart(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    queuedWrites++;
+    queuedWriteReg = reg;
+    queuedWriteValue = data;
+    return true;
+}
+
+void busDeviceRegister(const extDevice_t*) {}
+
+}
@@ -23,6 +23,7 @@ extern "C" {
     #include "build/debug.h"
 
     #include "blackbox/blackbox.h"
+    #include "blackbox/blackbox_fielddefs.h"
     #include "common/utils.h"
 
     #include "pg/pg.h"
@@ -51,6 +52,9 @@ extern "C" {
 
     extern int16_t blackboxIInterval;
     extern int16_t blackboxPInterval;
+    extern bool blackboxBurstActive;
+    bool blackboxShouldLogField(FlightLogFieldSelect_e field);
+    uint8_t blackboxMainFieldPPredictor(uint8_t predictor, uint8_t condition);
 }
 
 #include "unittest_macros.h"
@@ -223,6 +227,68 @@ TEST(BlackboxTest, Test_zero_p_interval)
     EXPECT_FALSE(blackboxShouldLogPFrame());
 }
 
+TEST(BlackboxTest, Test_FieldDecimation)
+{
+    blackboxConfigMutable()->sample_rate = 1;
+    blackboxConfigMutable()->fields_rate[FLIGHT_LOG_FIELD_SELECT_MOTOR] = BLACKBOX_RATE_HALF;
+    blackboxConfigMutable()->fields_rate[FLIGHT_LOG_FIELD_SELECT_RC_COMMANDS] = BLACKBOX_RATE_QUARTER;
+    blackboxConfigMutable()->fields_rate[FLIGHT_LOG_FIELD_SELECT_DEBUG_LOG] = BLACKBOX_RATE_8TH;
+    // 2kHz PIDloop
+    targetPidLooptime = 500;
+    blackboxInit();
+    EXPECT_EQ(2, blackboxPInterval);
+
+    int motorFrames = 0;
+    int rcFrames = 0;
+    int debugFrames = 0;
+    int gyroFrames = 0;
+    for (int ii = 0; ii < blackboxIInterval; ++ii) {
+        if (blackboxShouldLogIFrame()) {
+            EXPECT_TRUE(blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_DEBUG_LOG));
+        } else if (blackboxShouldLogPFrame()) {
+            motorFrames += blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_MOTOR);
+            rcFrames += blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_RC_COMMANDS);
+            debugFrames += blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_DEBUG_LOG);
+            gyroFrames += blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_GYRO);
+        }
+        blackboxAdvanceIterationTimers();
+    }
+
+    // 31 P-frames between each I-frame
+    EXPECT_EQ(31, gyroFrames);
+    EXPECT_EQ(15, motorFrames);
+    EXPECT_EQ(7, rcFrames);
+    EXPECT_EQ(3, debugFrames);
+
+    // a burst logs every field in each P-frame
+    blackboxBurstActive = true;
+    for (int ii = 0; ii < 8; ++ii) {
+        blackboxAdvanceIterationTimers();
+        EXPECT_TRUE(blackboxShouldLogField(FLIGHT_LOG_FIELD_SELECT_DEBUG_LOG));
+    }
+
+    memset(blackboxConfigMutable()->fields_rate, 0, sizeof(blackboxConfig()->fields_rate));
+}
+
+TEST(BlackboxTest, Test_DecimatedFieldPredictor)
+{
+    blackboxConfigMutable()->fields_rate[FLIGHT_LOG_FIELD_SELECT_MOTOR] = BLACKBOX_RATE_HALF;
+    blackboxConfigMutable()->fields_rate[FLIGHT_LOG_FIELD_SELECT_PID] = BLACKBOX_RATE_HALF;
+    blackboxInit();
+
+    // held values of decimated groups must encode as zero deltas, so they are predicted from the previous frame
+    EXPECT_EQ(FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS, blackboxMainFieldPPredictor(FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2, FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_1));
+    EXPECT_EQ(FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS, blackboxMainFieldPPredictor(FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2, FLIGHT_LOG_FIELD_CONDITION_AT_LEAST_MOTORS_4));
+    EXPECT_EQ(FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS, blackboxMainFieldPPredictor(FLIGHT_LOG_FIELD_PREDICTOR_PREVIOUS, FLIGHT_LOG_FIELD_CONDITION_PID));
+
+    // groups logged in every frame keep their predictor
+    EXPECT_EQ(FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2, blackboxMainFieldPPredictor(FLIGHT_LOG_FIELD_PREDICTOR_AVERAGE_2, FLIGHT_LOG_FIELD_CONDITION_GYRO));
+    EXPECT_EQ(FLIGHT_LOG_FIELD_PREDICTOR_STRAIGHT_LINE, blackboxMainFieldPPredictor(FLIGHT_LOG_FIELD_PREDICTOR_STRAIGHT_LINE, FLIGHT_LOG_FIELD_CONDITION_ALWAYS));
+
+    memset(blackboxConfigMutable()->fields_rate, 0, sizeof(blackboxConfig()->fields_rate));
+    blackboxInit();
+}
+
 TEST(BlackboxTest, Test_CalculatePDenom)
 {
     blackboxConfigMutable()->sample_rate = 0;
@@ -382,6 +448,8 @@ failsafePhase_e failsafePhase(void) {return FAILSAFE_IDLE;}
 bool rxAreFlightChannelsValid(void) {return false;}
 bool rxIsReceivingSignal(void) {return false;}
 bool isRssiConfigured(void) {return false;}
+bool crashRecoveryModeActive(void) {return false;}
+bool isFlipOverAfterCrashActive(void) {return false;}
 float getMotorOutputLow(void) {return 0.0;}
 float getMotorOutputHigh(void) {return 0.0;}
 }
@@ -0,0 +1,118 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "fc/boot.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static timeUs_t currentTimeUs;
+static int callOrder[BOOT_DEFERRED_INIT_MAX + 1];
+static int callCount;
+
+static void initA(void)
+{
+    callOrder[callCount++] = 1;
+}
+
+static void initB(void)
+{
+    callOrder[callCount++] = 2;
+}
+
+TEST(BootTest, ProfileMarksPhases)
+{
+    currentTimeUs = 1000;
+    bootProfileMark(BOOT_PHASE_SYSTEM);
+    currentTimeUs = 2500;
+    bootProfileMark(BOOT_PHASE_CONFIG);
+
+    EXPECT_EQ(1000, bootProfileGetPhaseEndUs(BOOT_PHASE_SYSTEM));
+    EXPECT_EQ(2500, bootProfileGetPhaseEndUs(BOOT_PHASE_CONFIG));
+    EXPECT_EQ(0, bootProfileGetPhaseEndUs(BOOT_PHASE_SENSORS));
+    EXPECT_STREQ("CONFIG", bootProfileGetPhaseName(BOOT_PHASE_CONFIG));
+
+    for (int phase = 0; phase < BOOT_PHASE_COUNT; phase++) {
+        EXPECT_NE(nullptr, bootProfileGetPhaseName((bootPhase_e)phase));
+    }
+}
+
+TEST(BootTest, DeferredInitRunsInOrder)
+{
+    callCount = 0;
+    EXPECT_FALSE(bootHasDeferredInit());
+
+    bootDeferInit(initB);
+    bootDeferInit(initA);
+    EXPECT_EQ(0, callCount);
+    EXPECT_TRUE(bootHasDeferredInit());
+
+    // one step per call
+    currentTimeUs = 5000;
+    EXPECT_TRUE(bootRunDeferredInit());
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(0, bootProfileGetPhaseEndUs(BOOT_PHASE_DEFERRED));
+
+    currentTimeUs = 6000;
+    EXPECT_FALSE(bootRunDeferredInit());
+    EXPECT_EQ(2, callCount);
+    EXPECT_EQ(2, callOrder[0]);
+    EXPECT_EQ(1, callOrder[1]);
+    EXPECT_FALSE(bootHasDeferredInit());
+    EXPECT_EQ(6000, bootProfileGetPhaseEndUs(BOOT_PHASE_DEFERRED));
+
+    EXPECT_FALSE(bootRunDeferredInit());
+    EXPECT_EQ(2, callCount);
+}
+
+TEST(BootTest, FullQueueRunsImmediately)
+{
+    callCount = 0;
+
+    for (int i = 0; i < BOOT_DEFERRED_INIT_MAX; i++) {
+        bootDeferInit(initA);
+    }
+    EXPECT_EQ(0, callCount);
+
+    bootDeferInit(initB);
+    EXPECT_EQ(1, callCount);
+    EXPECT_EQ(2, callOrder[0]);
+
+    while (bootRunDeferredInit());
+    EXPECT_EQ(BOOT_DEFERRED_INIT_MAX + 1, callCount);
+}
+
+// STUBS
+
+extern "C" {
+
+timeUs_t micros(void)
+{
+    return currentTimeUs;
+}
+
+}
@@ -0,0 +1,174 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <vector>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/bus.h"
+    #include "drivers/bus_spi_queue.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static busDevice_t bus;
+static extDevice_t gyro = { .bus = &bus, .priority = BUS_PRIORITY_REALTIME };
+static extDevice_t baro = { .bus = &bus, .priority = BUS_PRIORITY_NORMAL };
+static extDevice_t osd = { .bus = &bus, .priority = BUS_PRIORITY_LOW };
+static extDevice_t flash = { .bus = &bus, .priority = BUS_PRIORITY_LOW };
+
+static uint8_t buf[4];
+
+static busSegment_t segment(int len, bool negateCS)
+{
+    busSegment_t segment = {};
+    segment.u.buffers.txData = buf;
+    segment.len = len;
+    segment.negateCS = negateCS;
+    return segment;
+}
+
+// Segments are identified by their length
+static busSegment_t gyroSegments[] = { segment(1, true), segment(0, true) };
+static busSegment_t baroSegments[] = { segment(2, true), segment(0, true) };
+static busSegment_t osdSegments[] = { segment(3, true), segment(0, true) };
+static busSegment_t flashSegments[] = { segment(4, true), segment(5, false), segment(6, true), segment(0, true) };
+
+static void resetSegments(void)
+{
+    busSegment_t *lists[] = { gyroSegments, baroSegments, osdSegments, flashSegments };
+    for (busSegment_t *segments : lists) {
+        for (; segments->len; segments++);
+        segments->u.link.dev = NULL;
+        segments->u.link.segments = NULL;
+    }
+}
+
+// Mocked bus, runs the transfers as the DMA completion handler does, recording the segments as they complete
+static std::vector<int> runBus(const extDevice_t *dev, busSegment_t *segments, std::vector<const extDevice_t *> *arrivals = NULL, size_t arriveAfter = 0)
+{
+    std::vector<int> completed;
+
+    while (dev) {
+        completed.push_back(segments->len);
+
+        if (arrivals && completed.size() == arriveAfter) {
+            // A transfer queued while the bus is busy
+            for (const extDevice_t *arrival : *arrivals) {
+                busSegment_t *arrivalSegments = arrival == &gyro ? gyroSegments : arrival == &baro ? baroSegments : osdSegments;
+                EXPECT_TRUE(spiQueueTransfer(segments, arrival, arrivalSegments));
+            }
+        }
+
+        busSegment_t *nextSegment = segments + 1;
+
+        if (nextSegment->len == 0) {
+            const extDevice_t *nextDev = nextSegment->u.link.dev;
+            segments = (busSegment_t *)nextSegment->u.link.segments;
+            nextSegment->u.link.dev = NULL;
+            nextSegment->u.link.segments = NULL;
+            dev = nextDev;
+        } else {
+            busSegment_t *preemptSegments;
+            const extDevice_t *preemptDev = segments->negateCS ? spiQueuePreempt(dev, nextSegment, &preemptSegments) : NULL;
+
+            if (preemptDev) {
+                dev = preemptDev;
+                segments = preemptSegments;
+            } else {
+                segments = nextSegment;
+            }
+        }
+    }
+
+    return completed;
+}
+
+TEST(BusSpiQueueUnittest, TestPriorityOrder)
+{
+    resetSegments();
+
+    // osd is running, the others arrive in order of increasing priority
+    EXPECT_TRUE(spiQueueTransfer(osdSegments, &flash, flashSegments));
+    EXPECT_TRUE(spiQueueTransfer(osdSegments, &baro, baroSegments));
+    EXPECT_TRUE(spiQueueTransfer(osdSegments, &gyro, gyroSegments));
+
+    const std::vector<int> expected = { 3, 1, 2, 4, 5, 6 };
+    EXPECT_EQ(expected, runBus(&osd, osdSegments));
+}
+
+TEST(BusSpiQueueUnittest, TestFifoWithinPriority)
+{
+    resetSegments();
+
+    EXPECT_TRUE(spiQueueTransfer(gyroSegments, &flash, flashSegments));
+    EXPECT_TRUE(spiQueueTransfer(gyroSegments, &osd, osdSegments));
+
+    const std::vector<int> expected = { 1, 4, 5, 6, 3 };
+    EXPECT_EQ(expected, runBus(&gyro, gyroSegments));
+}
+
+TEST(BusSpiQueueUnittest, TestQueueTwiceRejected)
+{
+    resetSegments();
+
+    EXPECT_TRUE(spiQueueTransfer(flashSegments, &osd, osdSegments));
+    EXPECT_FALSE(spiQueueTransfer(flashSegments, &osd, osdSegments));
+    // nor can the running transfer be queued behind itself
+    EXPECT_FALSE(spiQueueTransfer(flashSegments, &flash, flashSegments));
+
+    const std::vector<int> expected = { 4, 5, 6, 3 };
+    EXPECT_EQ(expected, runBus(&flash, flashSegments));
+}
+
+TEST(BusSpiQueueUnittest, TestPreemptWhereCsNegated)
+{
+    resetSegments();
+
+    // gyro arrives during the first flash segment, after which CS is negated, so runs before the rest of the flash transfer
+    std::vector<const extDevice_t *> arrivals = { &osd, &gyro };
+    const std::vector<int> expected = { 4, 1, 5, 6, 3 };
+    EXPECT_EQ(expected, runBus(&flash, flashSegments, &arrivals, 1));
+}
+
+TEST(BusSpiQueueUnittest, TestNoPreemptWithCsAsserted)
+{
+    resetSegments();
+
+    // gyro arrives during the second flash segment which keeps CS asserted
+    std::vector<const extDevice_t *> arrivals = { &gyro };
+    const std::vector<int> expected = { 4, 5, 6, 1 };
+    EXPECT_EQ(expected, runBus(&flash, flashSegments, &arrivals, 2));
+}
+
+TEST(BusSpiQueueUnittest, TestNoPreemptByEqualPriority)
+{
+    resetSegments();
+
+    std::vector<const extDevice_t *> arrivals = { &osd };
+    const std::vector<int> expected = { 4, 5, 6, 3 };
+    EXPECT_EQ(expected, runBus(&flash, flashSegments, &arrivals, 1));
+}
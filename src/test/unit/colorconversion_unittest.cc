@@ -0,0 +1,74 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/color.h"
+    #include "common/colorconversion.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static void expectRgb(uint8_t r, uint8_t g, uint8_t b, const rgbColor24bpp_t *rgb)
+{
+    EXPECT_EQ(r, rgb->rgb.r);
+    EXPECT_EQ(g, rgb->rgb.g);
+    EXPECT_EQ(b, rgb->rgb.b);
+}
+
+TEST(ColorConversionTest, hsvToRgb24)
+{
+    const hsvColor_t red = { 0, 0, 255 };
+    const hsvColor_t white = { 0, 255, 255 };
+    const hsvColor_t blue = { 240, 0, 255 };
+    const hsvColor_t black = { 0, 0, 0 };
+
+    expectRgb(255, 0, 0, hsvToRgb24(&red));
+    expectRgb(255, 255, 255, hsvToRgb24(&white));
+    expectRgb(0, 0, 255, hsvToRgb24(&blue));
+    expectRgb(0, 0, 0, hsvToRgb24(&black));
+}
+
+TEST(ColorConversionTest, hsvToRgb24Cached)
+{
+    // given the conversions of more colors than the cache holds
+    rgbColor24bpp_t expected[360 / 15];
+    for (int i = 0; i < 360 / 15; i++) {
+        const hsvColor_t color = { (uint16_t)(i * 15), 64, (uint8_t)(255 - i) };
+        expected[i] = *hsvToRgb24(&color);
+    }
+
+    // when converted again, in a different order
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 360 / 15 - 1; i >= 0; i--) {
+            const hsvColor_t color = { (uint16_t)(i * 15), 64, (uint8_t)(255 - i) };
+            const rgbColor24bpp_t *rgb = hsvToRgb24(&color);
+
+            // then
+            expectRgb(expected[i].rgb.r, expected[i].rgb.g, expected[i].rgb.b, rgb);
+        }
+    }
+}
@@ -114,3 +114,91 @@ TEST(FilterUnittest, TestSlewFilter)
     slewFilterApply(&filter, 200.0f);
     EXPECT_EQ(200, filter.state);
 }
+
+TEST(FilterUnittest, TestFramePredictor)
+{
+    framePredictor_t filter;
+    framePredictorInit(&filter, 1.0f);
+    EXPECT_EQ(0, framePredictorApply(&filter));
+
+    // first frame predicts the whole step again over the following 4 loops
+    framePredictorNewFrame(&filter, 100.0f, 4);
+    EXPECT_FLOAT_EQ(125.0f, framePredictorApply(&filter));
+    EXPECT_FLOAT_EQ(150.0f, framePredictorApply(&filter));
+    EXPECT_FLOAT_EQ(175.0f, framePredictorApply(&filter));
+    EXPECT_FLOAT_EQ(200.0f, framePredictorApply(&filter));
+    // prediction stops after one frame interval
+    EXPECT_FLOAT_EQ(200.0f, framePredictorApply(&filter));
+
+    // a repeated frame holds the value
+    framePredictorNewFrame(&filter, 100.0f, 4);
+    EXPECT_FLOAT_EQ(100.0f, framePredictorApply(&filter));
+    EXPECT_FLOAT_EQ(100.0f, framePredictorApply(&filter));
+
+    // an invalid frame interval holds the value
+    framePredictorNewFrame(&filter, 200.0f, 0);
+    EXPECT_FLOAT_EQ(200.0f, framePredictorApply(&filter));
+
+    // gain scales the prediction
+    framePredictorInit(&filter, 0.5f);
+    framePredictorNewFrame(&filter, 100.0f, 2);
+    EXPECT_FLOAT_EQ(125.0f, framePredictorApply(&filter));
+    EXPECT_FLOAT_EQ(150.0f, framePredictorApply(&filter));
+}
+
+// Latency and overshoot of the setpoint delivered to the PID loop for a stick ramp, with and without
+// prediction, for an 8kHz PID loop and common link rates. The setpoint is smoothed as in rc.c.
+typedef struct {
+    float lagUs;        // mean lag behind the stick during the ramp
+    float overshoot;    // peak excursion past the final stick position
+} framePredictorBenchmark_t;
+
+static framePredictorBenchmark_t benchmarkFramePredictor(uint32_t rxRateHz, float gain)
+{
+    const uint32_t pidLooptimeUs = 125;
+    const uint32_t loopsPerFrame = 1000000 / rxRateHz / pidLooptimeUs;
+    const float rampRate = 5000.0f;     // deg/s per second, full rate in 100ms
+    const float target = 500.0f;
+
+    framePredictor_t predictor;
+    framePredictorInit(&predictor, gain);
+    pt3Filter_t smoothing;
+    pt3FilterInit(&smoothing, pt3FilterGain(rxRateHz / 4.0f, pidLooptimeUs * 1e-6f));
+
+    framePredictorBenchmark_t result = { 0.0f, 0.0f };
+    float lagSum = 0.0f;
+    int lagCount = 0;
+    for (uint32_t loop = 0; loop < 8000 / 2; loop++) {
+        const float timeS = loop * pidLooptimeUs * 1e-6f;
+        const float stick = fminf(timeS * rampRate, target);
+        if (loop % loopsPerFrame == 0) {
+            framePredictorNewFrame(&predictor, stick, loopsPerFrame);
+        }
+        const float setpoint = pt3FilterApply(&smoothing, framePredictorApply(&predictor));
+
+        if (timeS > 0.02f && stick < target) {
+            lagSum += (stick - setpoint) / rampRate;
+            lagCount++;
+        }
+        result.overshoot = fmaxf(result.overshoot, setpoint - target);
+    }
+    result.lagUs = lagSum / lagCount * 1e6f;
+    return result;
+}
+
+TEST(FilterUnittest, TestFramePredictorBenchmark)
+{
+    const uint32_t rxRates[] = { 250, 500, 1000 };
+    for (unsigned i = 0; i < sizeof(rxRates) / sizeof(rxRates[0]); i++) {
+        const framePredictorBenchmark_t held = benchmarkFramePredictor(rxRates[i], 0.0f);
+        const framePredictorBenchmark_t predicted = benchmarkFramePredictor(rxRates[i], 1.0f);
+        printf("%4uHz: lag %6.0fus -> %6.0fus, overshoot %5.2f -> %5.2f deg/s\n",
+            rxRates[i], held.lagUs, predicted.lagUs, held.overshoot, predicted.overshoot);
+
+        const float framePeriodUs = 1e6f / rxRates[i];
+        // prediction removes the half frame lag of holding the value
+        EXPECT_NEAR(framePeriodUs / 2, held.lagUs - predicted.lagUs, framePeriodUs * 0.1f);
+        // and overshoots by less than one frame step
+        EXPECT_LT(predicted.overshoot, 5000.0f / rxRates[i]);
+    }
+}
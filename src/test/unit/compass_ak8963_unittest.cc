@@ -0,0 +1,188 @@
+/*
+ * This file is part of Cleanflight.
+ *
+ * Cleanflight is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Cleanflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Cleanflight.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+
+#include "platform.h"
+#include "target.h"
+#include "common/axis.h"
+#include "drivers/bus.h"
+#include "drivers/compass/compass.h"
+#include "drivers/compass/compass_ak8963.h"
+
+}
+
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define AK8963_DEVICE_ID                0x48
+#define AK8963_MAG_REG_WIA              0x00
+#define AK8963_MAG_REG_ST1              0x02
+#define AK8963_MAG_REG_HXL              0x03
+#define AK8963_MAG_REG_ST2              0x09
+#define AK8963_MAG_REG_CNTL1            0x0A
+#define AK8963_MAG_REG_ASAX             0x10
+
+#define ST1_DATA_READY                  0x01
+#define CNTL1_MODE_ONCE                 0x01
+#define CNTL1_BIT_16_BIT                0x10
+
+static uint8_t registers[0x20];
+static bool busInUse;
+static int blockingWrites;
+static int queuedWrites;
+static uint8_t queuedWriteReg;
+static uint8_t queuedWriteValue;
+static int readStarts;
+
+static busDevice_t magBus;
+static magDev_t mag;
+
+static void ak8963Setup(void)
+{
+    memset(registers, 0, sizeof(registers));
+    registers[AK8963_MAG_REG_WIA] = AK8963_DEVICE_ID;
+    // unity sensitivity adjustment
+    registers[AK8963_MAG_REG_ASAX] = 128;
+    registers[AK8963_MAG_REG_ASAX + 1] = 128;
+    registers[AK8963_MAG_REG_ASAX + 2] = 128;
+
+    memset(&mag, 0, sizeof(mag));
+    magBus.busType = BUS_TYPE_I2C;
+    mag.dev.bus = &magBus;
+    ASSERT_TRUE(ak8963Detect(&mag));
+    ASSERT_TRUE(mag.init(&mag));
+
+    busInUse = false;
+    blockingWrites = 0;
+    queuedWrites = 0;
+    readStarts = 0;
+}
+
+static void ak8963SetSample(int16_t x, int16_t y, int16_t z)
+{
+    const int16_t sample[] = { x, y, z };
+    memcpy(&registers[AK8963_MAG_REG_HXL], sample, sizeof(sample));
+    registers[AK8963_MAG_REG_ST1] = ST1_DATA_READY;
+    registers[AK8963_MAG_REG_ST2] = 0;
+}
+
+TEST(compassAk8963Test, TestReadWaitsForDataReady)
+{
+    ak8963Setup();
+    int16_t magData[XYZ_AXIS_COUNT];
+
+    // each call starts one transfer and returns, the status is polled until a sample is ready
+    for (int i = 0; i < 3; i++) {
+        EXPECT_FALSE(mag.read(&mag, magData));
+        EXPECT_FALSE(mag.read(&mag, magData));
+    }
+    EXPECT_EQ(3, readStarts);
+    EXPECT_EQ(0, queuedWrites);
+}
+
+TEST(compassAk8963Test, TestReadTakesSampleAndTriggersNext)
+{
+    ak8963Setup();
+    ak8963SetSample(100, -200, 300);
+    int16_t magData[XYZ_AXIS_COUNT];
+
+    EXPECT_FALSE(mag.read(&mag, magData)); // status read started
+    EXPECT_FALSE(mag.read(&mag, magData)); // data ready, data read started
+    EXPECT_EQ(2, readStarts);
+
+    EXPECT_TRUE(mag.read(&mag, magData));
+    EXPECT_EQ(100, magData[X]);
+    EXPECT_EQ(-200, magData[Y]);
+    EXPECT_EQ(300, magData[Z]);
+
+    // the next single measurement is queued rather than written while the task waits
+    EXPECT_EQ(0, blockingWrites);
+    EXPECT_EQ(1, queuedWrites);
+    EXPECT_EQ(AK8963_MAG_REG_CNTL1, queuedWriteReg);
+    EXPECT_EQ(CNTL1_BIT_16_BIT | CNTL1_MODE_ONCE, queuedWriteValue);
+}
+
+TEST(compassAk8963Test, TestReadRetriedWhileBusInUse)
+{
+    ak8963Setup();
+    ak8963SetSample(1, 2, 3);
+    int16_t magData[XYZ_AXIS_COUNT];
+
+    busInUse = true;
+    EXPECT_FALSE(mag.read(&mag, magData));
+    EXPECT_FALSE(mag.read(&mag, magData));
+    EXPECT_EQ(0, readStarts);
+
+    busInUse = false;
+    EXPECT_FALSE(mag.read(&mag, magData));
+
+    // a refused data read does not skip ahead to a sample that was never read
+    busInUse = true;
+    EXPECT_FALSE(mag.read(&mag, magData));
+    busInUse = false;
+    EXPECT_FALSE(mag.read(&mag, magData));
+    EXPECT_TRUE(mag.read(&mag, magData));
+    EXPECT_EQ(1, magData[X]);
+    EXPECT_EQ(2, magData[Y]);
+    EXPECT_EQ(3, magData[Z]);
+}
+
+// STUBS
+
+extern "C" {
+
+void delay(uint32_t) {}
+
+bool busReadRegisterBuffer(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    memcpy(data, &registers[reg], length);
+    return true;
+}
+
+bool busReadRegisterBufferStart(const extDevice_t*, uint8_t reg, uint8_t *data, uint8_t length)
+{
+    if (busInUse) {
+        return false;
+    }
+    memcpy(data, &registers[reg], length);
+    readStarts++;
+    return true;
+}
+
+bool busWriteRegister(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    blockingWrites++;
+    return true;
+}
+
+bool busWriteRegisterStart(const extDevice_t*, uint8_t reg, uint8_t data)
+{
+    registers[reg] = data;
+    queuedWrites++;
+    queuedWriteReg = reg;
+    queuedWriteValue = data;
+    return true;
+}
+
+void busDeviceRegister(const extDevice_t*) {}
+
+}
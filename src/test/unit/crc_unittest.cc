@@ -0,0 +1,148 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "common/crc.h"
+    #include "common/streambuf.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+// Bitwise references, as the CRCs were computed before the lookup tables
+static uint16_t crc16Reference(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int ii = 0; ii < 8; ++ii) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t crc8Reference(uint8_t crc, const uint8_t *data, uint32_t length, uint8_t poly)
+{
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int ii = 0; ii < 8; ++ii) {
+            crc = (crc & 0x80) ? (crc << 1) ^ poly : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static void fillPseudoRandom(uint8_t *data, uint32_t length)
+{
+    uint32_t state = 0x12345678;
+    for (uint32_t i = 0; i < length; i++) {
+        state = state * 1664525 + 1013904223;
+        data[i] = state >> 24;
+    }
+}
+
+TEST(CrcUnittest, TestCheckValues)
+{
+    const char *check = "123456789";
+
+    // CRC-16/XMODEM and CRC-8/DVB-S2 check values
+    EXPECT_EQ(0x31C3, crc16_ccitt_update(0, check, strlen(check)));
+    EXPECT_EQ(0xBC, crc8_dvb_s2_update(0, check, strlen(check)));
+    EXPECT_EQ(0xBC, crc8_update(0, check, strlen(check), 0xD5));
+}
+
+TEST(CrcUnittest, TestSingleByteMatchesReference)
+{
+    for (int crc = 0; crc < 256; crc++) {
+        for (int a = 0; a < 256; a++) {
+            const uint8_t byte = a;
+            EXPECT_EQ(crc8Reference(crc, &byte, 1, 0xD5), crc8_dvb_s2(crc, a));
+            EXPECT_EQ(crc8Reference(crc, &byte, 1, 0xBA), crc8_poly_0xba(crc, a));
+            EXPECT_EQ(crc8Reference(crc, &byte, 1, 0xD5), crc8_calc(crc, a, 0xD5));
+            EXPECT_EQ(crc8Reference(crc, &byte, 1, 0x31), crc8_calc(crc, a, 0x31));
+
+            // the high byte of the register is the one that meets the table
+            const uint16_t crc16 = (crc << 8) | (crc ^ 0x5A);
+            EXPECT_EQ(crc16Reference(crc16, &byte, 1), crc16_ccitt(crc16, a));
+        }
+    }
+}
+
+TEST(CrcUnittest, TestBuffersMatchReference)
+{
+    uint8_t data[300];
+    fillPseudoRandom(data, sizeof(data));
+
+    // every length and alignment, so the slice-by-4 body and its byte-wise tail are both exercised
+    for (uint32_t offset = 0; offset < 4; offset++) {
+        for (uint32_t length = 0; length <= sizeof(data) - offset; length++) {
+            const uint8_t *p = data + offset;
+            EXPECT_EQ(crc16Reference(0, p, length), crc16_ccitt_update(0, p, length));
+            EXPECT_EQ(crc16Reference(0xFFFF, p, length), crc16_ccitt_update(0xFFFF, p, length));
+            EXPECT_EQ(crc8Reference(0, p, length, 0xD5), crc8_dvb_s2_update(0, p, length));
+            EXPECT_EQ(crc8Reference(0x7E, p, length, 0xD5), crc8_dvb_s2_update(0x7E, p, length));
+            EXPECT_EQ(crc8Reference(0, p, length, 0xBA), crc8_update(0, p, length, 0xBA));
+            EXPECT_EQ(crc8Reference(0, p, length, 0x07), crc8_update(0, p, length, 0x07));
+        }
+    }
+}
+
+TEST(CrcUnittest, TestIncrementalUpdate)
+{
+    uint8_t data[64];
+    fillPseudoRandom(data, sizeof(data));
+
+    // a CRC built up over several calls must match one computed in a single pass
+    for (uint32_t split = 0; split <= sizeof(data); split++) {
+        uint16_t crc16 = crc16_ccitt_update(0, data, split);
+        crc16 = crc16_ccitt_update(crc16, data + split, sizeof(data) - split);
+        EXPECT_EQ(crc16Reference(0, data, sizeof(data)), crc16);
+
+        uint8_t crc8 = crc8_dvb_s2_update(0, data, split);
+        crc8 = crc8_dvb_s2_update(crc8, data + split, sizeof(data) - split);
+        EXPECT_EQ(crc8Reference(0, data, sizeof(data), 0xD5), crc8);
+    }
+}
+
+TEST(CrcUnittest, TestSbufAppend)
+{
+    uint8_t buffer[32];
+    sbuf_t sbuf;
+    sbuf_t *dst = sbufInit(&sbuf, buffer, buffer + sizeof(buffer));
+
+    for (int i = 0; i < 20; i++) {
+        sbufWriteU8(dst, i * 13);
+    }
+    crc8_dvb_s2_sbuf_append(dst, buffer);
+    EXPECT_EQ(crc8Reference(0, buffer, 20, 0xD5), buffer[20]);
+
+    crc8_poly_0xba_sbuf_append(dst, buffer);
+    EXPECT_EQ(crc8Reference(0, buffer, 21, 0xBA), buffer[21]);
+
+    crc16_ccitt_sbuf_append(dst, buffer);
+    const uint16_t crc16 = crc16Reference(0, buffer, 22);
+    EXPECT_EQ(crc16 & 0xFF, buffer[22]);
+    EXPECT_EQ(crc16 >> 8, buffer[23]);
+}
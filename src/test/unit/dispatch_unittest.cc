@@ -0,0 +1,197 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "fc/dispatch.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static uint32_t simulatedTime;
+static int dispatchCalls[3];
+static uint32_t dispatchTimes[3];
+static int wakeups;
+
+extern "C" {
+    timeUs_t micros(void) { return simulatedTime; }
+}
+
+static void dispatchA(dispatchEntry_t *) { dispatchTimes[0] = simulatedTime; dispatchCalls[0]++; }
+static void dispatchB(dispatchEntry_t *) { dispatchTimes[1] = simulatedTime; dispatchCalls[1]++; }
+static void dispatchC(dispatchEntry_t *) { dispatchTimes[2] = simulatedTime; dispatchCalls[2]++; }
+
+static void resetCalls(void)
+{
+    for (int i = 0; i < 3; i++) {
+        dispatchCalls[i] = 0;
+        dispatchTimes[i] = 0;
+    }
+}
+
+// Advance time in steps, running the dispatcher only when it reports something due
+static void runFor(uint32_t durationUs, uint32_t stepUs)
+{
+    for (uint32_t elapsed = 0; elapsed < durationUs; elapsed += stepUs) {
+        simulatedTime += stepUs;
+        if (dispatchUpdateCheck(simulatedTime, stepUs)) {
+            wakeups++;
+            dispatchProcess(simulatedTime);
+        }
+    }
+}
+
+TEST(DispatchUnittest, TestOneShotOrderAndDeadline)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+    dispatchEntry_t b = { .dispatch = dispatchB };
+    dispatchEntry_t c = { .dispatch = dispatchC };
+    uint32_t deadlineUs;
+
+    resetCalls();
+    simulatedTime = 1000;
+    EXPECT_FALSE(dispatchGetNextDeadline(&deadlineUs));
+
+    dispatchAdd(&c, 2000000);   // cascades down two levels
+    dispatchAdd(&a, 5000);
+    dispatchAdd(&b, 100000);
+
+    EXPECT_TRUE(dispatchGetNextDeadline(&deadlineUs));
+    EXPECT_GE(deadlineUs, 6000U);
+    EXPECT_LT(deadlineUs, 6000U + 1024);
+
+    wakeups = 0;
+    runFor(3000000, 125);
+    // only woken when an entry is due or a slot needs cascading
+    EXPECT_LT(wakeups, 40);
+
+    // never early, and late by no more than a tick and a step
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(1, dispatchCalls[i]);
+    }
+    EXPECT_GE(dispatchTimes[0], 6000U);
+    EXPECT_LE(dispatchTimes[0], 6000U + 1024 + 125);
+    EXPECT_GE(dispatchTimes[1], 101000U);
+    EXPECT_LE(dispatchTimes[1], 101000U + 1024 + 125);
+    EXPECT_GE(dispatchTimes[2], 2001000U);
+    EXPECT_LE(dispatchTimes[2], 2001000U + 1024 + 125);
+
+    EXPECT_FALSE(a.inQue);
+    EXPECT_FALSE(dispatchGetNextDeadline(&deadlineUs));
+}
+
+TEST(DispatchUnittest, TestCancel)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+    dispatchEntry_t b = { .dispatch = dispatchB };
+
+    resetCalls();
+    simulatedTime = 50000;
+
+    dispatchAdd(&a, 10000);
+    dispatchAdd(&b, 10000);
+    // adding an entry which is already queued has no effect
+    dispatchAdd(&a, 1000);
+    dispatchCancel(&a);
+    EXPECT_FALSE(a.inQue);
+
+    runFor(20000, 100);
+    EXPECT_EQ(0, dispatchCalls[0]);
+    EXPECT_EQ(1, dispatchCalls[1]);
+}
+
+TEST(DispatchUnittest, TestPeriodic)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+
+    resetCalls();
+    simulatedTime = 0xFFFF0000;     // run across the wrap of the microsecond timer
+
+    dispatchAddPeriodic(&a, 10000);
+    runFor(105000, 50);
+    EXPECT_EQ(10, dispatchCalls[0]);
+    EXPECT_TRUE(a.inQue);
+
+    dispatchCancel(&a);
+    runFor(50000, 50);
+    EXPECT_EQ(10, dispatchCalls[0]);
+}
+
+TEST(DispatchUnittest, TestBeyondWheelSpan)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+
+    resetCalls();
+    simulatedTime = 0;
+
+    // longer than the wheel covers, so it is re-added when it reaches the end
+    const int delayUs = 1500000000;
+    dispatchAdd(&a, delayUs);
+    runFor(delayUs - 10000, 5000);
+    EXPECT_EQ(0, dispatchCalls[0]);
+    runFor(20000, 5000);
+    EXPECT_EQ(1, dispatchCalls[0]);
+}
+
+TEST(DispatchUnittest, TestAddWhileWheelLags)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+    dispatchEntry_t c = { .dispatch = dispatchC };
+    uint32_t deadlineUs;
+
+    resetCalls();
+    simulatedTime = 1000;
+
+    // nothing is due for a while, so the wheel isn't processed
+    dispatchAdd(&c, 2000000);
+    simulatedTime = 600000;
+
+    // expect the new entry to be placed relative to now, not where processing last stopped
+    dispatchAdd(&a, 5000);
+    EXPECT_TRUE(dispatchGetNextDeadline(&deadlineUs));
+    EXPECT_GE(deadlineUs, 605000U);
+    EXPECT_LT(deadlineUs, 605000U + 1024);
+
+    runFor(1500000, 125);
+    EXPECT_EQ(1, dispatchCalls[0]);
+    EXPECT_GE(dispatchTimes[0], 605000U);
+    EXPECT_LE(dispatchTimes[0], 605000U + 1024 + 125);
+    EXPECT_EQ(1, dispatchCalls[2]);
+}
+
+TEST(DispatchUnittest, TestPeriodOfOneRevolution)
+{
+    dispatchEntry_t a = { .dispatch = dispatchA };
+
+    resetCalls();
+    simulatedTime = 0;
+
+    // relinked into the slot which is being processed
+    dispatchAddPeriodic(&a, 32 * 1024);
+    runFor(10 * 32 * 1024 + 100, 100);
+    EXPECT_EQ(10, dispatchCalls[0]);
+
+    dispatchCancel(&a);
+}
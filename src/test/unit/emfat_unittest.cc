@@ -0,0 +1,205 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "common/maths.h"
+    #include "common/utils.h"
+
+    #include "msc/emfat.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define SECT 512
+#define CLUST 4096
+#define LOG_COUNT 100
+#define FLASH_SIZE (LOG_COUNT * 3 * CLUST)
+
+static uint8_t flash[FLASH_SIZE];
+static emfat_entry_t entries[LOG_COUNT + 2];
+static char names[LOG_COUNT][13];
+static emfat_t emfat;
+static int readCalls;
+static int readPageSize; // when set, reads stop at page boundaries as they do on W25N01G
+
+static int flashReadProc(uint8_t *dest, int size, uint32_t offset, emfat_entry_t *entry)
+{
+    UNUSED(entry);
+
+    readCalls++;
+    if (readPageSize) {
+        size = MIN(size, (int)(readPageSize - offset % readPageSize));
+    }
+    memcpy(dest, &flash[offset], size);
+    return size;
+}
+
+static uint32_t logSize(int index)
+{
+    // a mix of logs shorter than a cluster and logs spanning several
+    return (index % 3 + 1) * CLUST - index * 7;
+}
+
+static void initFlashEntries(void)
+{
+    for (int i = 0; i < FLASH_SIZE; i++) {
+        flash[i] = i * 31 + (i >> 9);
+    }
+
+    readPageSize = 0;
+
+    memset(entries, 0, sizeof(entries));
+    entries[0].name = "";
+    entries[0].dir = true;
+
+    uint32_t offset = 0;
+    for (int i = 0; i < LOG_COUNT; i++) {
+        emfat_entry_t *entry = &entries[i + 1];
+        snprintf(names[i], sizeof(names[i]), "LOG%05d.BBL", i);
+        entry->name = names[i];
+        entry->level = 1;
+        entry->offset = offset;
+        entry->curr_size = logSize(i);
+        entry->max_size = entry->curr_size;
+        entry->readcb = flashReadProc;
+        offset += entry->curr_size;
+    }
+
+    ASSERT_TRUE(emfat_init(&emfat, "TEST", entries));
+}
+
+static uint32_t clusterSector(uint32_t cluster)
+{
+    return emfat.priv.root_lba + (cluster - 2) * (CLUST / SECT);
+}
+
+TEST(EmfatTest, FatChains)
+{
+    initFlashEntries();
+
+    static uint32_t fat[(LOG_COUNT * 3 + 128) / 128 * 128];
+    const uint32_t fatSectors = emfat.priv.fat2_lba - emfat.priv.fat1_lba;
+    ASSERT_LE(fatSectors * 128, ARRAYLEN(fat));
+    emfat_read(&emfat, (uint8_t *)fat, emfat.priv.fat1_lba, fatSectors);
+
+    for (int i = 0; i <= LOG_COUNT; i++) {
+        const emfat_entry_t *entry = &entries[i];
+        uint32_t cluster = entry->priv.first_clust;
+        while (cluster != entry->priv.last_clust) {
+            EXPECT_EQ(cluster + 1, fat[cluster]);
+            cluster++;
+        }
+        EXPECT_EQ(0x0FFFFFFFU, fat[cluster]);
+    }
+
+    // clusters beyond the last entry are not allocated
+    const uint32_t lastCluster = entries[LOG_COUNT].priv.last_reserved;
+    for (uint32_t cluster = lastCluster + 1; cluster < fatSectors * 128; cluster++) {
+        EXPECT_EQ(0x00000001U, fat[cluster]);
+    }
+
+    // and the second copy matches
+    static uint32_t fat2[ARRAYLEN(fat)];
+    emfat_read(&emfat, (uint8_t *)fat2, emfat.priv.fat2_lba, fatSectors);
+    EXPECT_EQ(0, memcmp(fat, fat2, fatSectors * SECT));
+}
+
+TEST(EmfatTest, ReadLogsInOneCallback)
+{
+    initFlashEntries();
+
+    static uint8_t buffer[3 * CLUST];
+
+    // read the logs from last to first so each lookup has to search the entries
+    for (int i = LOG_COUNT - 1; i >= 0; i--) {
+        const emfat_entry_t *entry = &entries[i + 1];
+        const int sectors = (entry->curr_size + SECT - 1) / SECT;
+
+        readCalls = 0;
+        emfat_read(&emfat, buffer, clusterSector(entry->priv.first_clust), sectors);
+
+        EXPECT_EQ(1, readCalls);
+        EXPECT_EQ(0, memcmp(buffer, &flash[entry->offset], entry->curr_size));
+    }
+}
+
+TEST(EmfatTest, ReadThroughShortReads)
+{
+    initFlashEntries();
+    readPageSize = 2048;
+
+    static uint8_t buffer[3 * CLUST];
+
+    // a log spanning several pages, read starting part way into its first page
+    const emfat_entry_t *entry = &entries[3];
+    const uint32_t startSector = clusterSector(entry->priv.first_clust) + 1;
+    const int sectors = (entry->curr_size - SECT + SECT - 1) / SECT;
+    ASSERT_GT(sectors * SECT, 2 * readPageSize);
+
+    memset(buffer, 0, sizeof(buffer));
+    readCalls = 0;
+    emfat_read(&emfat, buffer, startSector, sectors);
+
+    EXPECT_GT(readCalls, 2);
+    EXPECT_EQ(0, memcmp(buffer, &flash[entry->offset + SECT], entry->curr_size - SECT));
+}
+
+TEST(EmfatTest, ReadAcrossEntries)
+{
+    initFlashEntries();
+
+    static uint8_t buffer[6 * CLUST];
+
+    // a read starting part way into a log's last cluster and continuing into the next log
+    const emfat_entry_t *first = &entries[3];
+    const emfat_entry_t *second = &entries[4];
+    const uint32_t startSector = clusterSector(first->priv.last_clust) + 2;
+    const uint32_t firstSectors = clusterSector(second->priv.first_clust) - startSector;
+
+    readCalls = 0;
+    emfat_read(&emfat, buffer, startSector, firstSectors + 8);
+
+    EXPECT_EQ(2, readCalls);
+    const uint32_t firstOffset = first->offset + (startSector - clusterSector(first->priv.first_clust)) * SECT;
+    EXPECT_EQ(0, memcmp(buffer, &flash[firstOffset], first->offset + first->curr_size - firstOffset));
+    EXPECT_EQ(0, memcmp(&buffer[firstSectors * SECT], &flash[second->offset], 8 * SECT));
+}
+
+TEST(EmfatTest, ReadRootDirectory)
+{
+    initFlashEntries();
+
+    uint8_t sector[SECT];
+    emfat_read(&emfat, sector, clusterSector(2), 1);
+
+    // volume label first, then the logs
+    EXPECT_EQ(0, memcmp(sector, "TEST", 4));
+    EXPECT_EQ(0, memcmp(&sector[32], "LOG00000BBL", 11));
+    EXPECT_EQ(entries[1].priv.first_clust, (uint32_t)(sector[32 + 26] | (sector[32 + 27] << 8)));
+}
@@ -0,0 +1,281 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/flash.h"
+
+    #include "io/flashfs.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define PAGE_SIZE 256
+#define SECTOR_SIZE 4096
+#define SECTOR_COUNT 16
+#define FLASH_SIZE (SECTOR_SIZE * SECTOR_COUNT)
+
+static uint8_t flash[FLASH_SIZE];
+static flashGeometry_t geometry;
+static flashPartition_t partition;
+
+// RAM backed NOR flash whose page programs can be left in flight to model DMA
+static bool flashBusy;
+static bool deferCompletion;
+static void (*programCallback)(uint32_t arg);
+static uint32_t programAddress;
+static uint32_t pendingLength;
+static int programCount;
+static int pageCrossings;
+static uint32_t programLengths[64];
+
+static void completeProgram(void)
+{
+    const uint32_t length = pendingLength;
+    pendingLength = 0;
+    programCallback(length);
+}
+
+static void initFlash(void)
+{
+    memset(flash, 0xff, sizeof(flash));
+
+    geometry.sectors = SECTOR_COUNT;
+    geometry.pageSize = PAGE_SIZE;
+    geometry.sectorSize = SECTOR_SIZE;
+    geometry.totalSize = FLASH_SIZE;
+    geometry.pagesPerSector = SECTOR_SIZE / PAGE_SIZE;
+    geometry.flashType = FLASH_TYPE_NOR;
+
+    partition.type = FLASH_PARTITION_TYPE_FLASHFS;
+    partition.startSector = 0;
+    partition.endSector = SECTOR_COUNT - 1;
+
+    flashBusy = false;
+    deferCompletion = false;
+    pendingLength = 0;
+    programCount = 0;
+    pageCrossings = 0;
+
+    flashfsInit();
+}
+
+static uint8_t pattern(uint32_t offset)
+{
+    return offset * 7 + (offset >> 8);
+}
+
+static void writePattern(uint32_t offset, uint32_t length, bool sync)
+{
+    uint8_t data[1024];
+    for (uint32_t i = 0; i < length; i++) {
+        data[i] = pattern(offset + i);
+    }
+    flashfsWrite(data, length, sync);
+}
+
+TEST(FlashfsTest, WritesWholePages)
+{
+    initFlash();
+
+    writePattern(0, 1000, false);
+
+    // Three complete pages have been programmed, the remainder is still being filled
+    EXPECT_EQ(3, programCount);
+    for (int i = 0; i < programCount; i++) {
+        EXPECT_EQ(PAGE_SIZE, programLengths[i]);
+    }
+    EXPECT_EQ(1000, flashfsGetOffset());
+
+    flashfsFlushSync();
+
+    EXPECT_EQ(4, programCount);
+    EXPECT_EQ(1000 - 3 * PAGE_SIZE, programLengths[3]);
+    EXPECT_EQ(0, pageCrossings);
+    for (uint32_t i = 0; i < 1000; i++) {
+        ASSERT_EQ(pattern(i), flash[i]);
+    }
+    EXPECT_EQ(0xff, flash[1000]);
+}
+
+TEST(FlashfsTest, FillsWhileProgramInFlight)
+{
+    initFlash();
+    deferCompletion = true;
+
+    writePattern(0, PAGE_SIZE, false);
+
+    // The first page is being programmed, the second buffer is free to accept a page of data
+    EXPECT_EQ(1, programCount);
+    EXPECT_EQ(PAGE_SIZE, flashfsGetWriteBufferFreeSpace());
+
+    writePattern(PAGE_SIZE, 200, false);
+    EXPECT_EQ(1, programCount);
+    EXPECT_EQ(PAGE_SIZE - 200, flashfsGetWriteBufferFreeSpace());
+
+    // Overflowing both buffers discards the excess
+    writePattern(PAGE_SIZE + 200, 100, false);
+    EXPECT_EQ(0, flashfsGetWriteBufferFreeSpace());
+    EXPECT_EQ(2 * PAGE_SIZE, flashfsGetOffset());
+
+    completeProgram();
+    EXPECT_EQ(PAGE_SIZE, flashfsGetWriteBufferFreeSpace());
+    EXPECT_FALSE(flashfsFlushAsync(false));
+    EXPECT_EQ(2, programCount);
+    EXPECT_EQ(PAGE_SIZE, flashfsGetWriteBufferFreeSpace());
+
+    completeProgram();
+    EXPECT_TRUE(flashfsFlushAsync(false));
+
+    for (uint32_t i = 0; i < 2 * PAGE_SIZE; i++) {
+        ASSERT_EQ(pattern(i), flash[i]);
+    }
+}
+
+TEST(FlashfsTest, BusyFlashDoesNotStallFilling)
+{
+    initFlash();
+    flashBusy = true;
+
+    writePattern(0, 300, false);
+
+    EXPECT_EQ(0, programCount);
+    EXPECT_EQ(2 * PAGE_SIZE - 300, flashfsGetWriteBufferFreeSpace());
+    EXPECT_FALSE(flashfsFlushAsync(false));
+    EXPECT_EQ(0, programCount);
+
+    flashBusy = false;
+    EXPECT_FALSE(flashfsFlushAsync(false));
+    EXPECT_EQ(1, programCount);
+    EXPECT_EQ(PAGE_SIZE, programLengths[0]);
+
+    // A forced flush writes the partially filled buffer too
+    EXPECT_TRUE(flashfsFlushAsync(true));
+    EXPECT_EQ(2, programCount);
+    EXPECT_EQ(300 - PAGE_SIZE, programLengths[1]);
+    EXPECT_EQ(300, flashfsGetOffset());
+}
+
+TEST(FlashfsTest, BuffersStayPageAligned)
+{
+    initFlash();
+
+    flashfsSeekAbs(100);
+    writePattern(100, 600, true);
+    flashfsFlushSync();
+
+    EXPECT_EQ(PAGE_SIZE - 100, programLengths[0]);
+    EXPECT_EQ(PAGE_SIZE, programLengths[1]);
+
+    // Partial flushes part way through a page must not push later writes across the page boundary
+    const uint32_t offset = flashfsGetOffset();
+    writePattern(offset, 10, false);
+    EXPECT_TRUE(flashfsFlushAsync(true));
+    writePattern(offset + 10, 500, false);
+    flashfsFlushSync();
+
+    EXPECT_EQ(0, pageCrossings);
+    EXPECT_EQ(offset + 510, flashfsGetOffset());
+    for (uint32_t i = 100; i < offset + 510; i++) {
+        ASSERT_EQ(pattern(i), flash[i]);
+    }
+}
+
+// STUBS
+
+extern "C" {
+
+bool flashIsReady(void)
+{
+    return !flashBusy && pendingLength == 0;
+}
+
+void flashEraseSector(uint32_t address)
+{
+    memset(&flash[address], 0xff, SECTOR_SIZE);
+}
+
+void flashEraseCompletely(void)
+{
+    memset(flash, 0xff, sizeof(flash));
+}
+
+void flashPageProgramBegin(uint32_t address, void (*callback)(uint32_t arg))
+{
+    programAddress = address;
+    programCallback = callback;
+}
+
+uint32_t flashPageProgramContinue(const uint8_t **buffers, uint32_t *bufferSizes, uint32_t bufferCount)
+{
+    uint32_t length = 0;
+    for (uint32_t i = 0; i < bufferCount; i++) {
+        for (uint32_t j = 0; j < bufferSizes[i]; j++) {
+            // Programming can only clear bits
+            flash[programAddress + length++] &= buffers[i][j];
+        }
+    }
+
+    if (programAddress / PAGE_SIZE != (programAddress + length - 1) / PAGE_SIZE) {
+        pageCrossings++;
+    }
+    programLengths[programCount++] = length;
+
+    pendingLength = length;
+    if (!deferCompletion) {
+        completeProgram();
+    }
+
+    return length;
+}
+
+void flashPageProgramFinish(void) {}
+
+int flashReadBytes(uint32_t address, uint8_t *buffer, uint32_t length)
+{
+    memcpy(buffer, &flash[address], length);
+    return length;
+}
+
+void flashFlush(void) {}
+
+const flashGeometry_t *flashGetGeometry(void)
+{
+    return &geometry;
+}
+
+flashPartition_t *flashPartitionFindByType(flashPartitionType_e type)
+{
+    UNUSED(type);
+    return &partition;
+}
+
+int flashPartitionCount(void)
+{
+    return 1;
+}
+
+}
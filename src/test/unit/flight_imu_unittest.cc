@@ -65,6 +65,7 @@ extern "C" {
     extern quaternion q;
     extern float rMat[3][3];
     extern bool attitudeIsEstablished;
+    extern gyro_t gyro;
 
     PG_REGISTER(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
     PG_REGISTER(barometerConfig_t, barometerConfig, PG_BAROMETER_CONFIG, 0);
@@ -214,6 +215,74 @@ TEST(FlightImuTest, TestSmallAngle)
     EXPECT_FALSE(isUpright());
 }
 
+TEST(FlightImuTest, TestPropagateAttitude)
+{
+    // given
+    imuConfigMutable()->imu_propagate_denom = 2;
+    imuConfigure(0, 0);
+    attitudeIsEstablished = true;
+    q.w = 1.0f;
+    q.x = 0.0f;
+    q.y = 0.0f;
+    q.z = 0.0f;
+    imuComputeRotationMatrix();
+    imuUpdateEulerAngles();
+
+    gyro.gyroADCf[FD_ROLL] = 90.0f;
+    gyro.gyroADCf[FD_PITCH] = 0.0f;
+    gyro.gyroADCf[FD_YAW] = 0.0f;
+
+    // when, a single PID loop is below the propagation rate
+    imuPropagateAttitude(0.001f);
+
+    // expect
+    EXPECT_FLOAT_EQ(1.0f, q.w);
+
+    // when, rolling at 90deg/s for half a second of 1kHz PID loops
+    for (int i = 1; i < 500; i++) {
+        imuPropagateAttitude(0.001f);
+    }
+
+    // expect the quaternion and tilt to follow, with rMat and Euler angles only updated on demand
+    EXPECT_NEAR(cosf(DEGREES_TO_RADIANS(45)), getCosTiltAngle(), 1e-3);
+    EXPECT_FLOAT_EQ(1.0f, rMat[2][2]);
+    EXPECT_EQ(0, attitude.values.roll);
+
+    imuRefreshAttitude();
+
+    EXPECT_NEAR(cosf(DEGREES_TO_RADIANS(45)), rMat[2][2], 1e-3);
+    EXPECT_NEAR(450, attitude.values.roll, 2);
+    EXPECT_EQ(0, attitude.values.pitch);
+
+    // when, the correction step runs it no longer integrates the gyro itself
+    imuMahonyAHRSupdate(0.01f, DEGREES_TO_RADIANS(90), 0, 0, false, 0, 0, 0, false, 0, 0, 0);
+    imuUpdateEulerAngles();
+
+    // expect
+    EXPECT_NEAR(450, attitude.values.roll, 2);
+
+    // when, the rate changes between the loops of one propagation interval
+    q.w = 1.0f;
+    q.x = 0.0f;
+    q.y = 0.0f;
+    q.z = 0.0f;
+    for (int i = 0; i < 250; i++) {
+        gyro.gyroADCf[FD_ROLL] = 180.0f;
+        imuPropagateAttitude(0.001f);
+        gyro.gyroADCf[FD_ROLL] = 0.0f;
+        imuPropagateAttitude(0.001f);
+    }
+    imuRefreshAttitude();
+
+    // expect the average of 90deg/s to be integrated, not the latest sample
+    EXPECT_NEAR(450, attitude.values.roll, 2);
+
+    // cleanup
+    gyro.gyroADCf[FD_ROLL] = 0.0f;
+    imuConfigMutable()->imu_propagate_denom = 0;
+    imuConfigure(0, 0);
+}
+
 testing::AssertionResult DoubleNearWrapPredFormat(const char* expr1, const char* expr2,
                                                   const char* abs_error_expr, const char* wrap_expr, double val1,
                                                   double val2, double abs_error, double wrap) {
@@ -381,6 +450,7 @@ extern "C" {
     mag_t mag;
 
     gpsSolutionData_t gpsSol;
+    gpsData_t gpsData;
 
     uint8_t debugMode;
     int16_t debug[DEBUG16_VALUE_COUNT];
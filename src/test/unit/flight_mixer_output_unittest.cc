@@ -0,0 +1,323 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <float.h>
+#include <math.h>
+
+extern "C" {
+    #include "platform.h"
+    #include "build/debug.h"
+
+    #include "common/axis.h"
+    #include "common/maths.h"
+
+    #include "config/config.h"
+    #include "config/feature.h"
+
+    #include "drivers/motor.h"
+
+    #include "fc/controlrate_profile.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
+    #include "fc/runtime_config.h"
+
+    #include "flight/failsafe.h"
+    #include "flight/mixer.h"
+    #include "flight/mixer_init.h"
+    #include "flight/mixer_tricopter.h"
+    #include "flight/pid.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+    #include "pg/rx.h"
+
+    #include "rx/rx.h"
+
+    PG_REGISTER(rxConfig_t, rxConfig, PG_RX_CONFIG, 0);
+    PG_REGISTER(flight3DConfig_t, flight3DConfig, PG_MOTOR_3D_CONFIG, 0);
+    PG_REGISTER(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 0);
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define MOTOR_OUTPUT_LOW 1000.0f
+#define MOTOR_OUTPUT_HIGH 2000.0f
+#define MOTOR_DISARMED 900.0f
+
+static bool testAirmode;
+static bool testFailsafe;
+static bool testDshot;
+static float testThrustLinearization;
+
+typedef struct mixerInput_s {
+    float roll;                             // PID sums, in the mixer scale of +-1
+    float pitch;
+    float yaw;
+    float throttle;                         // 0 to 1
+} mixerInput_t;
+
+// The mixer as it was before it was compiled into columns, kept as the reference the current mixer must match.
+// Runs the same steps in the same order as the old mixTable() did for an armed craft without 3D mode.
+static void referenceMixTable(const motorMixer_t *mixer, int motorCount, const mixerInput_t *input, float *out)
+{
+    const float motorOutputMin = MOTOR_OUTPUT_LOW;
+    const float motorRangeMin = MOTOR_OUTPUT_LOW;
+    const float motorRangeMax = MOTOR_OUTPUT_HIGH;
+    const float motorOutputRange = MOTOR_OUTPUT_HIGH - MOTOR_OUTPUT_LOW;
+    float throttle = input->throttle;
+
+    float motorMix[MAX_SUPPORTED_MOTORS];
+    float motorMixMax = 0, motorMixMin = 0;
+    for (int i = 0; i < motorCount; i++) {
+        float mix =
+            input->roll  * mixer[i].roll +
+            input->pitch * mixer[i].pitch +
+            -input->yaw  * mixer[i].yaw;
+
+        if (mix > motorMixMax) {
+            motorMixMax = mix;
+        } else if (mix < motorMixMin) {
+            motorMixMin = mix;
+        }
+        motorMix[i] = mix;
+    }
+
+    const float motorMixRange = motorMixMax - motorMixMin;
+    float airmodeTransitionPercent = 1.0f;
+    if (mixerConfig()->mixer_type > MIXER_LEGACY) {
+        float motorDeltaScale = 0.5f;
+        if (!testAirmode && throttle < 0.5f) {
+            airmodeTransitionPercent = scaleRangef(throttle, 0.0f, 0.5f, 0.5f, 1.0f);
+            motorDeltaScale *= airmodeTransitionPercent;
+        }
+        const float motorMixNormalizationFactor = motorMixRange > 1.0f ? airmodeTransitionPercent / motorMixRange : airmodeTransitionPercent;
+        const float motorMixDelta = motorDeltaScale * motorMixRange;
+
+        float minMotor = FLT_MAX;
+        float maxMotor = FLT_MIN;
+        for (int i = 0; i < motorCount; ++i) {
+            if (mixerConfig()->mixer_type == MIXER_LINEAR) {
+                motorMix[i] = scaleRangef(throttle, 0.0f, 1.0f, motorMix[i] + motorMixDelta, motorMix[i] - motorMixDelta);
+            } else {
+                motorMix[i] = scaleRangef(throttle, 0.0f, 1.0f, motorMix[i] + fabsf(motorMix[i]), motorMix[i] - fabsf(motorMix[i]));
+            }
+            motorMix[i] *= motorMixNormalizationFactor;
+
+            maxMotor = MAX(motorMix[i], maxMotor);
+            minMotor = MIN(motorMix[i], minMotor);
+        }
+        throttle = constrainf(throttle, -minMotor, 1.0f - maxMotor);
+    } else {
+        if (!testAirmode && throttle < 0.5f) {
+            airmodeTransitionPercent = scaleRangef(throttle, 0.0f, 0.5f, 0.5f, 1.0f);
+        }
+        const float motorMixNormalizationFactor = motorMixRange > 1.0f ? airmodeTransitionPercent / motorMixRange : airmodeTransitionPercent;
+        for (int i = 0; i < motorCount; i++) {
+            motorMix[i] *= motorMixNormalizationFactor;
+        }
+        throttle = constrainf(throttle, -motorMixMin * motorMixNormalizationFactor, 1.0f - motorMixMax * motorMixNormalizationFactor);
+    }
+
+    for (int i = 0; i < motorCount; i++) {
+        float motorOutput = motorMix[i] + throttle * mixer[i].throttle;
+        motorOutput *= 1.0f + testThrustLinearization * sq(1.0f - motorOutput);
+        motorOutput = motorOutputMin + motorOutputRange * motorOutput;
+
+        if (mixerIsTricopter()) {
+            motorOutput += mixerTricopterMotorCorrection(i);
+        }
+        if (testFailsafe) {
+            if (testDshot) {
+                motorOutput = (motorOutput < motorRangeMin) ? MOTOR_DISARMED : motorOutput;
+            }
+            motorOutput = constrainf(motorOutput, MOTOR_DISARMED, motorRangeMax);
+        } else {
+            motorOutput = constrainf(motorOutput, motorRangeMin, motorRangeMax);
+        }
+        out[i] = motorOutput;
+    }
+}
+
+static void runMixTable(const mixerInput_t *input)
+{
+    pidData[FD_ROLL].Sum = input->roll * PID_MIXER_SCALING;
+    pidData[FD_PITCH].Sum = input->pitch * PID_MIXER_SCALING;
+    pidData[FD_YAW].Sum = input->yaw * PID_MIXER_SCALING;
+    rcCommand[THROTTLE] = PWM_RANGE_MIN + input->throttle * PWM_RANGE;
+    mixTable(0);
+}
+
+static const mixerInput_t inputs[] = {
+    { 0.0f, 0.0f, 0.0f, 0.0f },
+    { 0.0f, 0.0f, 0.0f, 0.5f },
+    { 0.0f, 0.0f, 0.0f, 1.0f },
+    { 0.1f, -0.05f, 0.02f, 0.3f },
+    { -0.2f, 0.1f, 0.1f, 0.05f },
+    { 0.3f, 0.3f, -0.2f, 0.7f },
+    { 0.5f, -0.4f, 0.3f, 0.95f },
+    { -0.5f, 0.5f, -0.5f, 0.2f },           // mix range over 1, normalised
+    { 0.05f, 0.0f, 0.4f, 0.45f },
+};
+
+static void expectMatchesReference(mixerMode_e mixerMode)
+{
+    mixerInit(mixerMode);
+    const int motorCount = getMotorCount();
+    ASSERT_GT(motorCount, 0);
+
+    for (mixerType_e type = MIXER_LEGACY; type <= MIXER_DYNAMIC; type = (mixerType_e)(type + 1)) {
+        mixerConfigMutable()->mixer_type = type;
+        for (int airmode = 0; airmode < 2; airmode++) {
+            testAirmode = airmode;
+            for (unsigned j = 0; j < ARRAYLEN(inputs); j++) {
+                float expected[MAX_SUPPORTED_MOTORS];
+                referenceMixTable(mixers[mixerMode].motor, motorCount, &inputs[j], expected);
+                runMixTable(&inputs[j]);
+
+                for (int i = 0; i < motorCount; i++) {
+                    // the linear mixers now take the throttle spread as a multiply-add instead of scaleRangef()
+                    EXPECT_NEAR(expected[i], motor[i], 0.01f) << "mixer " << mixerMode << " type " << type
+                        << " airmode " << airmode << " input " << j << " motor " << i;
+                }
+            }
+        }
+    }
+}
+
+class MixerOutputTest : public ::testing::Test {
+protected:
+    virtual void SetUp() {
+        memset(pidData, 0, sizeof(pidData));
+        pidProfile.pidSumLimit = PIDSUM_LIMIT_MAX;
+        pidProfile.pidSumLimitYaw = PIDSUM_LIMIT_MAX;
+        currentPidProfile = &pidProfile;
+        controlRateProfile.throttle_limit_type = THROTTLE_LIMIT_TYPE_OFF;
+        currentControlRateProfile = &controlRateProfile;
+        mixerConfigMutable()->yaw_motors_reversed = false;
+
+        testAirmode = false;
+        testFailsafe = false;
+        testDshot = false;
+        testThrustLinearization = 0.0f;
+        ENABLE_ARMING_FLAG(ARMED);
+    }
+
+    pidProfile_t pidProfile;
+    controlRateConfig_t controlRateProfile;
+};
+
+TEST_F(MixerOutputTest, QuadXMatchesReference)
+{
+    expectMatchesReference(MIXER_QUADX);
+}
+
+TEST_F(MixerOutputTest, HexMatchesReference)
+{
+    expectMatchesReference(MIXER_HEX6X);
+}
+
+TEST_F(MixerOutputTest, OctoMatchesReference)
+{
+    expectMatchesReference(MIXER_OCTOFLATX);
+}
+
+TEST_F(MixerOutputTest, TricopterMatchesReference)
+{
+    expectMatchesReference(MIXER_TRI);
+}
+
+TEST_F(MixerOutputTest, ThrustLinearizationMatchesReference)
+{
+    testThrustLinearization = 0.4f;
+    expectMatchesReference(MIXER_QUADX);
+}
+
+TEST_F(MixerOutputTest, FailsafeMatchesReference)
+{
+    testFailsafe = true;
+    expectMatchesReference(MIXER_QUADX);
+
+    testDshot = true;
+    expectMatchesReference(MIXER_QUADX);
+}
+
+TEST_F(MixerOutputTest, DisarmedHoldsDisarmedOutput)
+{
+    mixerInit(MIXER_QUADX);
+    DISABLE_ARMING_FLAG(ARMED);
+
+    runMixTable(&inputs[5]);
+    for (int i = 0; i < getMotorCount(); i++) {
+        EXPECT_EQ(MOTOR_DISARMED, motor[i]);
+    }
+}
+
+// STUBS
+
+extern "C" {
+    uint8_t armingFlags;
+    uint16_t flightModeFlags;
+    uint8_t stateFlags;
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    float rcCommand[4];
+    float rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+    pidProfile_t *currentPidProfile;
+    controlRateConfig_t *currentControlRateProfile;
+    pidAxisData_t pidData[XYZ_AXIS_COUNT];
+
+    bool featureIsEnabled(const uint32_t) { return false; }
+    bool IS_RC_MODE_ACTIVE(boxId_e) { return false; }
+    bool airmodeIsEnabled(void) { return testAirmode; }
+    bool isAirmodeActivated(void) { return testAirmode; }
+    bool failsafeIsActive(void) { return testFailsafe; }
+    bool isMotorProtocolDshot(void) { return testDshot; }
+    bool isFlipOverAfterCrashActive(void) { return false; }
+    bool isLaunchControlActive(void) { return false; }
+    bool isMotorsReversed(void) { return false; }
+
+    float pidGetThrustLinearization(void) { return testThrustLinearization; }
+    float pidCompensateThrustLinearization(float throttle) { return throttle; }
+    void pidUpdateAntiGravityThrottleFilter(float) {}
+    void pidUpdateTpaFactor(float) {}
+    void pidResetIterm(void) {}
+    float getRcDeflection(int) { return 0.0f; }
+    float getRcDeflectionAbs(int) { return 0.0f; }
+
+    // the tail motor of a tricopter takes a yaw servo correction
+    float mixerTricopterMotorCorrection(int motor) { return motor == 0 ? 25.0f : 0.0f; }
+    void mixerTricopterInit(void) {}
+
+    void motorInitEndpoints(const motorConfig_t *, float, float *outputLow, float *outputHigh, float *disarm, float *deadbandMotor3DHigh, float *deadbandMotor3DLow)
+    {
+        *outputLow = MOTOR_OUTPUT_LOW;
+        *outputHigh = MOTOR_OUTPUT_HIGH;
+        *disarm = MOTOR_DISARMED;
+        *deadbandMotor3DHigh = 1514;
+        *deadbandMotor3DLow = 1486;
+    }
+    void motorWriteAll(float *) {}
+    void motorWriteAllAtPhase(float *, timeUs_t) {}
+    void delay(uint32_t) {}
+}
@@ -314,7 +314,7 @@ void ws2811LedStripInit(ioTag_t ioTag)
     UNUSED(ioTag);
 }
 
-void ws2811UpdateStrip(ledStripFormatRGB_e, uint8_t) {}
+bool ws2811UpdateStrip(ledStripFormatRGB_e, uint8_t) { return true; }
 
 void setLedValue(uint16_t index, const uint8_t value)
 {
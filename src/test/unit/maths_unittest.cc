@@ -21,6 +21,7 @@
 #include <limits.h>
 
 #include <math.h>
+#include <string.h>
 
 #define USE_BARO
 
@@ -249,4 +250,141 @@ TEST(MathsUnittest, TestFastTrigonometryACos)
     printf("acos_approx maximum absolute error = %e rads (%e degree)\n", error, error / M_PI * 180.0f);
     EXPECT_LE(error, 1e-4);
 }
+
+// Exhaustive sweeps over every MATHS_SWEEP_STRIDE'th float of each domain, below MATHS_SWEEP_MIN all tiers
+// are exact to well within their bounds. These verify the error bounds documented in maths.h
+#define MATHS_SWEEP_STRIDE 256
+#define MATHS_SWEEP_MIN 1e-6f
+
+typedef float (*unaryApprox_t)(float);
+typedef float (*binaryApprox_t)(float, float);
+
+static float floatFromBits(uint32_t bits)
+{
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+static uint32_t bitsFromFloat(float f)
+{
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// calls check for every MATHS_SWEEP_STRIDE'th positive float in min..max
+template <typename F>
+static void sweepFloats(float min, float max, F check)
+{
+    for (uint32_t bits = bitsFromFloat(min); bits <= bitsFromFloat(max); bits += MATHS_SWEEP_STRIDE) {
+        check(floatFromBits(bits));
+    }
+}
+
+static double maxAbsoluteError(unaryApprox_t approx, double (*reference)(double), float limit)
+{
+    double error = 0;
+    sweepFloats(MATHS_SWEEP_MIN, limit, [&](float x) {
+        error = MAX(error, fabs(approx(x) - reference(x)));
+        error = MAX(error, fabs(approx(-x) - reference(-x)));
+    });
+    return error;
+}
+
+static double maxAtan2Error(binaryApprox_t approx)
+{
+    // every octant, for every ratio of the smaller to the larger argument
+    double error = 0;
+    sweepFloats(MATHS_SWEEP_MIN, 1.0f, [&](float r) {
+        const float args[8][2] = { { r, 1 }, { 1, r }, { -r, 1 }, { 1, -r }, { r, -1 }, { -1, r }, { -r, -1 }, { -1, -r } };
+        for (int i = 0; i < 8; i++) {
+            error = MAX(error, fabs(approx(args[i][0], args[i][1]) - atan2(args[i][0], args[i][1])));
+        }
+    });
+    return error;
+}
+
+static double maxExpError(unaryApprox_t approx)
+{
+    double error = 0;
+    sweepFloats(MATHS_SWEEP_MIN, 10.0f, [&](float x) {
+        error = MAX(error, fabs(approx(x) / exp(x) - 1.0));
+        error = MAX(error, fabs(approx(-x) / exp(-x) - 1.0));
+    });
+    return error;
+}
+
+static double maxLogError(unaryApprox_t approx)
+{
+    double error = 0;
+    sweepFloats(1e-3f, 1e3f, [&](float x) {
+        error = MAX(error, fabs(approx(x) - log(x)));
+    });
+    return error;
+}
+
+#define EXPECT_APPROX_ERROR(name, error, bound) \
+    printf("%-22s maximum error = %.2e (bound %.1e)\n", name, error, bound); \
+    EXPECT_LE(error, bound)
+
+TEST(MathsUnittest, TestApproxTiersSinCos)
+{
+    EXPECT_APPROX_ERROR("sin_approx_fast", maxAbsoluteError(sin_approx_fast, sin, M_PIf), 7.0e-5);
+    EXPECT_APPROX_ERROR("sin_approx", maxAbsoluteError(sin_approx, sin, M_PIf), 1.0e-6);
+    EXPECT_APPROX_ERROR("sin_approx_precise", maxAbsoluteError(sin_approx_precise, sin, M_PIf), 2.0e-7);
+    EXPECT_APPROX_ERROR("cos_approx_fast", maxAbsoluteError(cos_approx_fast, cos, M_PIf), 7.0e-5);
+    EXPECT_APPROX_ERROR("cos_approx", maxAbsoluteError(cos_approx, cos, M_PIf), 1.0e-6);
+    EXPECT_APPROX_ERROR("cos_approx_precise", maxAbsoluteError(cos_approx_precise, cos, M_PIf), 2.0e-7);
+}
+
+TEST(MathsUnittest, TestApproxTiersAtan2)
+{
+    EXPECT_APPROX_ERROR("atan2_approx_fast", maxAtan2Error(atan2_approx_fast), 6.2e-4);
+    EXPECT_APPROX_ERROR("atan2_approx", maxAtan2Error(atan2_approx), 7.5e-7);
+    EXPECT_APPROX_ERROR("atan2_approx_precise", maxAtan2Error(atan2_approx_precise), 5.0e-7);
+}
+
+TEST(MathsUnittest, TestApproxTiersAcos)
+{
+    EXPECT_APPROX_ERROR("acos_approx_fast", maxAbsoluteError(acos_approx_fast, acos, 1.0f), 3.3e-3);
+    EXPECT_APPROX_ERROR("acos_approx", maxAbsoluteError(acos_approx, acos, 1.0f), 7.0e-5);
+    EXPECT_APPROX_ERROR("acos_approx_precise", maxAbsoluteError(acos_approx_precise, acos, 1.0f), 3.5e-7);
+}
+
+TEST(MathsUnittest, TestApproxTiersExpLog)
+{
+    EXPECT_APPROX_ERROR("exp_approx_fast", maxExpError(exp_approx_fast), 1.8e-3);
+    EXPECT_APPROX_ERROR("exp_approx", maxExpError(exp_approx), 1.0e-5);
+    EXPECT_APPROX_ERROR("exp_approx_precise", maxExpError(exp_approx_precise), 6.5e-7);
+    EXPECT_APPROX_ERROR("log_approx_fast", maxLogError(log_approx_fast), 5.5e-4);
+    EXPECT_APPROX_ERROR("log_approx", maxLogError(log_approx), 1.4e-5);
+    EXPECT_APPROX_ERROR("log_approx_precise", maxLogError(log_approx_precise), 5.0e-7);
+}
+
+TEST(MathsUnittest, TestSinCosBatched)
+{
+    // sine and cosine share the range reduction, so check across several turns and the fold points
+    float maxSinError = 0.0f;
+    float maxCosError = 0.0f;
+    for (float a = -20.0f; a < 20.0f; a += 4 * 0.01f) {
+        const float x[4] = { a, a + 0.01f, a + 0.02f, a + 0.03f };
+        float sinX[4], cosX[4];
+
+        sin_cos_approx4(x, sinX, cosX);
+        for (int i = 0; i < 4; i++) {
+            EXPECT_FLOAT_EQ(sin_approx(x[i]), sinX[i]);
+            maxSinError = fmaxf(maxSinError, fabsf(sinX[i] - sinf(x[i])));
+            maxCosError = fmaxf(maxCosError, fabsf(cosX[i] - cosf(x[i])));
+        }
+
+        sin_cos_approx3(x, sinX, cosX);
+        for (int i = 0; i < 3; i++) {
+            EXPECT_FLOAT_EQ(sin_approx(x[i]), sinX[i]);
+            EXPECT_NEAR(cos_approx(x[i]), cosX[i], 5e-6);
+        }
+    }
+    EXPECT_APPROX_ERROR("sin_cos_approx4 sin", maxSinError, 3.0e-6);
+    EXPECT_APPROX_ERROR("sin_cos_approx4 cos", maxCosError, 3.0e-6);
+}
 #endif
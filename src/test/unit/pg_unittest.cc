@@ -35,11 +35,19 @@ extern "C" {
 PG_REGISTER_WITH_RESET_TEMPLATE(motorConfig_t, motorConfig, PG_MOTOR_CONFIG, 1);
 
 PG_RESET_TEMPLATE(motorConfig_t, motorConfig,
+    .dev = {.motorPwmRate = 400},
     .minthrottle = 1150,
     .maxthrottle = 1850,
     .mincommand = 1000,
-    .dev = {.motorPwmRate = 400}
 );
+
+typedef struct testConfig_s {
+    uint8_t value;
+} testConfig_t;
+
+// registered out of PGN order around the motor config
+PG_REGISTER(testConfig_t, testHighConfig, 4000, 0);
+PG_REGISTER(testConfig_t, testLowConfig, 2, 0);
 }
 
 
@@ -84,6 +92,21 @@ TEST(ParameterGroupsfTest, Test_pgFind)
     EXPECT_EQ(400, motorConfig3.dev.motorPwmRate);
 }
 
+TEST(ParameterGroupsfTest, Test_pgFindIndexed)
+{
+    EXPECT_EQ(&testLowConfig_Registry, pgFind(2));
+    EXPECT_EQ(&testHighConfig_Registry, pgFind(4000));
+    EXPECT_EQ(PG_MOTOR_CONFIG, pgN(pgFind(PG_MOTOR_CONFIG)));
+
+    EXPECT_EQ(NULL, pgFind(1));
+    EXPECT_EQ(NULL, pgFind(3));
+    EXPECT_EQ(NULL, pgFind(4095));
+
+    for (int i = 0; i < PG_REGISTRY_SIZE; i++) {
+        EXPECT_EQ(i, pgRegistryIndex(pgN(&__pg_registry_start[i])));
+    }
+}
+
 // STUBS
 
 extern "C" {
@@ -103,6 +103,8 @@ extern "C" {
         return maxRate;
     }
     void initRcProcessing(void) { }
+    void imuPropagateAttitude(float) { }
+    void imuRefreshAttitude(void) { }
 }
 
 pidProfile_t *pidProfile;
@@ -944,3 +946,112 @@ TEST(pidControllerTest, testLaunchControl)
     EXPECT_NEAR(44.84,  pidData[FD_YAW].P,   calculateTolerance(44.84));
     EXPECT_NEAR(1.56,   pidData[FD_YAW].I,  calculateTolerance(1.56));
 }
+
+// Drives the PID controller with a deterministic pseudo random sequence of setpoints and gyro rates
+// with most of the profile dependent features enabled, sampling the outputs at regular intervals
+#define EQUIVALENCE_LOOPS 400
+#define EQUIVALENCE_SAMPLE_INTERVAL 50
+#define EQUIVALENCE_SAMPLES (EQUIVALENCE_LOOPS / EQUIVALENCE_SAMPLE_INTERVAL)
+
+static void runEquivalenceScenario(float samples[EQUIVALENCE_SAMPLES][XYZ_AXIS_COUNT][5])
+{
+    unitLaunchControlMode = LAUNCH_CONTROL_MODE_NORMAL;
+    resetTest();
+    pidProfile->iterm_relax = ITERM_RELAX_RP;
+    pidProfile->iterm_relax_type = ITERM_RELAX_SETPOINT;
+    pidProfile->abs_control_gain = 10;
+    pidProfile->yaw_lowpass_hz = 100;
+    pidProfile->dterm_lpf2_static_hz = 150;
+    pidInit(pidProfile);
+    ENABLE_ARMING_FLAG(ARMED);
+    pidStabilisationState(PID_STABILISATION_ON);
+    pidRuntime.tpaFactor = 0.8f;
+    pidSetAntiGravityState(true);
+
+    uint32_t seed = 12345;
+    for (int loop = 0; loop < EQUIVALENCE_LOOPS; loop++) {
+        for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+            seed = seed * 1664525 + 1013904223;
+            const float stick = ((seed >> 8) & 0xffff) / 32768.0f - 1.0f;
+            setStickPosition(axis, stick * 0.3f);
+            seed = seed * 1664525 + 1013904223;
+            gyro.gyroADCf[axis] = simulatedSetpointRate[axis] + (((seed >> 8) & 0xffff) / 65536.0f - 0.5f) * 200.0f;
+        }
+        seed = seed * 1664525 + 1013904223;
+        simulatedMotorMixRange = ((seed >> 8) & 0xffff) / 65536.0f;
+        pidRuntime.antiGravityThrottleD = simulatedMotorMixRange;
+
+        pidController(pidProfile, currentTestTime());
+
+        if ((loop + 1) % EQUIVALENCE_SAMPLE_INTERVAL == 0) {
+            for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+                float *sample = samples[(loop + 1) / EQUIVALENCE_SAMPLE_INTERVAL - 1][axis];
+                sample[0] = pidData[axis].P;
+                sample[1] = pidData[axis].I;
+                sample[2] = pidData[axis].D;
+                sample[3] = pidData[axis].F;
+                sample[4] = pidData[axis].Sum;
+            }
+        }
+    }
+    pidSetAntiGravityState(false);
+}
+
+// Outputs of the per-axis controller the lockstep implementation replaced, for the scenario above
+static const float equivalenceExpected[EQUIVALENCE_SAMPLES][XYZ_AXIS_COUNT][5] = {
+    {
+        { 27.4266701f, -14.8592529f, -1269.06592f, 8.72865009f, -1247.7699f },
+        { 95.3949356f, -2.66640949f, 922.392273f, -3.75802088f, 1011.36279f },
+        { -428.032898f, -82.8488846f, -354.475494f, 2.59763098f, -862.759644f },
+    },
+    {
+        { -12.9915142f, -3.63666201f, -390.099487f, 1.64777291f, -405.079895f },
+        { 88.7446518f, 42.8081169f, -969.322083f, 5.27843761f, -832.490845f },
+        { -26.9396973f, 2.10796022f, 459.002899f, -4.00875664f, 430.162415f },
+    },
+    {
+        { -76.0664291f, -14.9874878f, 7.5178237f, -1.72136343f, -85.2574615f },
+        { -59.4714165f, 36.3680763f, 442.737518f, -1.96497917f, 417.66922f },
+        { 37.7378273f, -143.51088f, -95.2144775f, 1.15661597f, -199.830917f },
+    },
+    {
+        { -50.7124481f, 13.7699013f, 1063.36951f, -7.77916908f, 1018.64783f },
+        { 13.3958178f, -39.2364731f, 1303.50818f, -7.13940907f, 1270.52808f },
+        { -367.874695f, -27.8947296f, -294.885162f, 3.02196503f, -687.632568f },
+    },
+    {
+        { 0.991944969f, 32.9683723f, 32.0988274f, -0.452499747f, 65.6066437f },
+        { 147.910645f, -38.0083389f, 450.983154f, -0.502075791f, 560.383362f },
+        { 62.3418579f, -94.8300171f, 534.216248f, -6.14929628f, 495.578796f },
+    },
+    {
+        { -101.33979f, 8.40717888f, -224.6586f, 1.34605181f, -316.245178f },
+        { 30.1877995f, -47.7293358f, -1736.42078f, 8.55370426f, -1745.40857f },
+        { -138.567444f, -113.749741f, -359.958405f, 3.98369837f, -608.29187f },
+    },
+    {
+        { -85.4878235f, -51.9905548f, -330.824524f, 2.22799683f, -466.074921f },
+        { 82.7206573f, 38.8729668f, 137.276001f, 0.290135235f, 259.15976f },
+        { 242.690369f, 150.0f, -509.481293f, 4.74375534f, -112.047165f },
+    },
+    {
+        { -99.9635544f, -51.8375969f, -266.364807f, 0.365219086f, -417.800751f },
+        { -58.4588242f, 25.0780392f, -152.396698f, 1.21761978f, -184.55986f },
+        { -343.802582f, 123.535057f, 10.4342861f, -1.25070071f, -211.083939f },
+    },
+};
+
+TEST(pidControllerTest, testLockstepEquivalence)
+{
+    float samples[EQUIVALENCE_SAMPLES][XYZ_AXIS_COUNT][5];
+    runEquivalenceScenario(samples);
+
+    for (int i = 0; i < EQUIVALENCE_SAMPLES; i++) {
+        for (int axis = FD_ROLL; axis <= FD_YAW; axis++) {
+            for (int term = 0; term < 5; term++) {
+                const float expected = equivalenceExpected[i][axis][term];
+                EXPECT_NEAR(expected, samples[i][axis][term], fabsf(expected) * 1e-4f + 1e-4f) << "sample " << i << " axis " << axis << " term " << term;
+            }
+        }
+    }
+}
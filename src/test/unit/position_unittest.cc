@@ -0,0 +1,244 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <math.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+    #include "build/debug.h"
+
+    #include "common/axis.h"
+    #include "common/maths.h"
+
+    #include "pg/pg.h"
+    #include "pg/pg_ids.h"
+
+    #include "fc/runtime_config.h"
+
+    #include "flight/imu.h"
+    #include "flight/position.h"
+
+    #include "io/gps.h"
+
+    #include "sensors/acceleration.h"
+    #include "sensors/barometer.h"
+    #include "sensors/sensors.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define ACC_1G 4096
+#define GRAVITY_CMSS 980.665f
+#define ACC_RATE_HZ 1000
+#define ACC_BIAS_CMSS 15.0f
+#define BARO_NOISE_CM 50.0f
+
+static bool accPresent;
+static bool baroPresent;
+static float baroAltitudeCm;
+static uint32_t noiseSeed;
+
+// deterministic, roughly gaussian noise with unit standard deviation
+static float gaussianNoise(void)
+{
+    float sum = 0.0f;
+    for (int i = 0; i < 12; i++) {
+        noiseSeed = noiseSeed * 1664525 + 1013904223;
+        sum += (noiseSeed >> 8) / (float)(1 << 24);
+    }
+    return sum - 6.0f;
+}
+
+static void initEstimator(bool withAcc)
+{
+    positionConfigMutable()->altitude_source = 0;
+    positionConfigMutable()->altitude_prefer_baro = 100;
+    positionConfigMutable()->altitude_baro_noise = BARO_NOISE_CM;
+    positionConfigMutable()->altitude_acc_noise = 10;
+    positionInit();
+
+    accPresent = withAcc;
+    baroPresent = true;
+    acc.dev.acc_1G_rec = 1.0f / ACC_1G;
+    acc.isAccelUpdatedAtLeastOnce = true;
+    memset(rMat, 0, sizeof(rMat));
+    rMat[0][0] = rMat[1][1] = rMat[2][2] = 1.0f;
+    noiseSeed = 1;
+    DISABLE_ARMING_FLAG(ARMED);
+}
+
+// Replays a vertical flight profile at the ACC rate with noisy baro at the altitude task rate
+typedef float (*profileFn)(float t);
+
+typedef struct varioError_s {
+    float mean;                             // signed, the lag of the vario behind the true climb rate
+    float worst;
+} varioError_t;
+
+static varioError_t flyProfile(timeUs_t *timeUs, profileFn acceleration, float startS, float durationS, float *altitudeCm, float *velocityCmS)
+{
+    varioError_t error = { 0.0f, 0.0f };
+    int samples = 0;
+    const int steps = durationS * ACC_RATE_HZ;
+    const float dt = 1.0f / ACC_RATE_HZ;
+
+    for (int i = 0; i < steps; i++) {
+        const float a = acceleration(startS + i * dt);
+        *altitudeCm += (*velocityCmS + 0.5f * a * dt) * dt;
+        *velocityCmS += a * dt;
+
+        *timeUs += 1000000 / ACC_RATE_HZ;
+        acc.accADC[Z] = (1.0f + (a + ACC_BIAS_CMSS) / GRAVITY_CMSS) * ACC_1G;
+        if (accPresent) {
+            positionUpdateAcceleration(*timeUs);
+        }
+
+        if (i % (ACC_RATE_HZ / TASK_ALTITUDE_RATE_HZ) == 0) {
+            baroAltitudeCm = *altitudeCm + BARO_NOISE_CM * gaussianNoise();
+            calculateEstimatedAltitude();
+
+            const float varioError = *velocityCmS - getAltitudeDerivative();
+            error.mean += varioError;
+            error.worst = MAX(error.worst, fabsf(varioError));
+            samples++;
+        }
+    }
+    error.mean /= samples;
+
+    return error;
+}
+
+static float stationary(float t)
+{
+    UNUSED(t);
+    return 0.0f;
+}
+
+// climb at 1m/s/s for a second, hold 1m/s, then brake to a hover
+static float climb(float t)
+{
+    if (t < 1.0f) {
+        return 100.0f;
+    } else if (t < 3.0f) {
+        return 0.0f;
+    } else if (t < 4.0f) {
+        return -100.0f;
+    }
+    return 0.0f;
+}
+
+TEST(PositionUnittest, AccelerometerAidedVarioTracksClimb)
+{
+    initEstimator(true);
+    timeUs_t timeUs = 0;
+    float altitudeCm = 0.0f;
+    float velocityCmS = 0.0f;
+
+    // on the ground the accelerometer bias is learnt from the stationary craft
+    flyProfile(&timeUs, stationary, 0.0f, 5.0f, &altitudeCm, &velocityCmS);
+    EXPECT_EQ(0.0f, getAltitude());
+
+    ENABLE_ARMING_FLAG(ARMED);
+
+    // a differentiated baro through the 1Hz derivative lowpass lags a 1m/s/s ramp by about 25cm/s
+    const varioError_t rampError = flyProfile(&timeUs, climb, 0.0f, 1.0f, &altitudeCm, &velocityCmS);
+    EXPECT_NEAR(0.0f, rampError.mean, 5.0f);
+    EXPECT_LT(rampError.worst, 20.0f);
+
+    const varioError_t error = flyProfile(&timeUs, climb, 1.0f, 5.0f, &altitudeCm, &velocityCmS);
+    EXPECT_NEAR(0.0f, error.mean, 5.0f);
+    EXPECT_LT(error.worst, 20.0f);
+    EXPECT_NEAR(altitudeCm, getAltitude(), 30.0f);
+    EXPECT_NEAR(0.0f, getAltitudeDerivative(), 10.0f);
+
+    // fused altitude is more certain than a single baro sample
+    EXPECT_LT(getAltitudeAccuracyCm(), BARO_NOISE_CM);
+    EXPECT_GT(getAltitudeAccuracyCm(), 0.0f);
+}
+
+TEST(PositionUnittest, BaroOnlyFollowsClimb)
+{
+    initEstimator(false);
+    timeUs_t timeUs = 0;
+    float altitudeCm = 0.0f;
+    float velocityCmS = 0.0f;
+
+    flyProfile(&timeUs, stationary, 0.0f, 2.0f, &altitudeCm, &velocityCmS);
+    ENABLE_ARMING_FLAG(ARMED);
+
+    // without an accelerometer the vario is noisier and lags, but still converges to the climb rate
+    flyProfile(&timeUs, climb, 0.0f, 3.0f, &altitudeCm, &velocityCmS);
+    EXPECT_NEAR(velocityCmS, getAltitudeDerivative(), 50.0f);
+    EXPECT_NEAR(altitudeCm, getAltitude(), 100.0f);
+}
+
+// a vibration induced offset the accelerometer bias learnt on the ground does not cover
+static float vibration(float t)
+{
+    UNUSED(t);
+    return 20.0f;
+}
+
+TEST(PositionUnittest, HoldsAltitudeWithoutSource)
+{
+    // GPS only craft armed without a fix, nothing can correct the accelerometer prediction
+    initEstimator(true);
+    baroPresent = false;
+    timeUs_t timeUs = 0;
+    float altitudeCm = 0.0f;
+    float velocityCmS = 0.0f;
+
+    flyProfile(&timeUs, stationary, 0.0f, 5.0f, &altitudeCm, &velocityCmS);
+    ENABLE_ARMING_FLAG(ARMED);
+
+    // integrating the offset alone would be 360m away after a minute
+    flyProfile(&timeUs, vibration, 0.0f, 60.0f, &altitudeCm, &velocityCmS);
+    EXPECT_NEAR(0.0f, getAltitude(), 50.0f);
+    EXPECT_NEAR(0.0f, getAltitudeDerivative(), 10.0f);
+    EXPECT_EQ(0, getEstimatedVario());
+}
+
+// STUBS
+
+extern "C" {
+    uint8_t armingFlags;
+    uint8_t stateFlags;
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+
+    acc_t acc;
+    float rMat[3][3];
+    gpsSolutionData_t gpsSol;
+    gpsData_t gpsData;
+
+    bool sensors(uint32_t mask)
+    {
+        return (baroPresent && (mask & SENSOR_BARO)) || (accPresent && (mask & SENSOR_ACC));
+    }
+
+    float getBaroAltitude(void)
+    {
+        return baroAltitudeCm;
+    }
+}
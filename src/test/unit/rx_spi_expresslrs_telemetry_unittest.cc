@@ -28,6 +28,7 @@
 extern "C" {
     #include "platform.h"
 
+    #include "build/debug.h"
     #include "build/version.h"
     #include "common/printf.h"
 
@@ -40,6 +41,14 @@ extern "C" {
     #include "msp/msp.h"
     #include "msp/msp_serial.h"
 
+    #include "fc/controlrate_profile.h"
+    #include "fc/rc.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
+
+    #include "flight/failsafe.h"
+    #include "flight/pid.h"
+
     #include "telemetry/telemetry.h"
     #include "telemetry/msp_shared.h"
     #include "rx/crsf_protocol.h"
@@ -56,8 +65,7 @@ extern "C" {
 
     #include "msp/msp_protocol.h"
 
-    extern uint8_t tlmSensors;
-    extern uint8_t currentPayloadIndex;
+    extern uint8_t tlmScheduleCount;
 
     extern volatile bool mspReplyPending;
     extern volatile bool deviceInfoReplyPending;
@@ -70,16 +78,42 @@ extern "C" {
 
     PG_REGISTER(telemetryConfig_t, telemetryConfig, PG_TELEMETRY_CONFIG, 0);
     PG_REGISTER(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 0);
+    PG_REGISTER(rxConfig_t, rxConfig, PG_RX_CONFIG, 0);
+    PG_REGISTER(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
+    PG_REGISTER(flight3DConfig_t, flight3DConfig, PG_MOTOR_3D_CONFIG, 0);
 }
 
 #include "unittest_macros.h"
 #include "gtest/gtest.h"
 
 //make clean test_rx_spi_expresslrs_telemetry_unittest
+static uint32_t testTimeUs = 0;
+
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestInit)
 {
+    uint8_t *payload = 0;
+    uint8_t payloadSize = 0;
+
     initTelemetry();
-    EXPECT_EQ(tlmSensors, 15);
+    EXPECT_EQ(4, tlmScheduleCount);
+
+    // no budget until the telemetry ratio is known
+    testTimeUs += 1000000;
+    EXPECT_FALSE(getNextTelemetryPayload(&payloadSize, &payload));
+    EXPECT_EQ(0, payloadSize);
+}
+
+// Runs the scheduler until it picks a frame of the given type
+static bool getNextTelemetryFrame(uint8_t frameType, uint8_t *payloadSize, uint8_t **payload)
+{
+    updateTelemetryRate(500, 2, 1);
+    for (int i = 0; i < 1000; i++) {
+        testTimeUs += 10000;
+        if (getNextTelemetryPayload(payloadSize, payload) && (*payload)[2] == frameType) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static void testSetDataToTransmit(uint8_t payloadSize, uint8_t *payload)
@@ -113,7 +147,6 @@ static void testSetDataToTransmit(uint8_t payloadSize, uint8_t *payload)
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestGps)
 {
     initTelemetry();
-    currentPayloadIndex = 0;
 
     gpsSol.llh.lat = 56 * GPS_DEGREES_DIVIDER;
     gpsSol.llh.lon = 163 * GPS_DEGREES_DIVIDER;
@@ -125,8 +158,7 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestGps)
     uint8_t *payload = 0;
     uint8_t payloadSize = 0;
 
-    getNextTelemetryPayload(&payloadSize, &payload);
-    EXPECT_EQ(currentPayloadIndex, 1);
+    ASSERT_TRUE(getNextTelemetryFrame(CRSF_FRAMETYPE_GPS, &payloadSize, &payload));
 
     int32_t lattitude = payload[3] << 24 | payload[4] << 16 | payload[5] << 8 | payload[6];
     EXPECT_EQ(560000000, lattitude);
@@ -147,7 +179,6 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestGps)
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestBattery)
 {
     initTelemetry();
-    currentPayloadIndex = 1;
 
     testBatteryVoltage = 330; // 3.3V = 3300 mv
     testAmperage = 2960; // = 29.60A = 29600mA - amperage is in 0.01A steps
@@ -156,8 +187,7 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestBattery)
     uint8_t *payload = 0;
     uint8_t payloadSize = 0;
 
-    getNextTelemetryPayload(&payloadSize, &payload);
-    EXPECT_EQ(currentPayloadIndex, 2);
+    ASSERT_TRUE(getNextTelemetryFrame(CRSF_FRAMETYPE_BATTERY_SENSOR, &payloadSize, &payload));
 
     uint16_t voltage = payload[3] << 8 | payload[4]; // mV * 100
     EXPECT_EQ(33, voltage);
@@ -174,7 +204,6 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestBattery)
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestAttitude)
 {
     initTelemetry();
-    currentPayloadIndex = 2;
 
     attitude.values.pitch = 678; // decidegrees == 1.183333232852155 rad
     attitude.values.roll = 1495; // 2.609267231731523 rad
@@ -183,8 +212,7 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestAttitude)
     uint8_t *payload = 0;
     uint8_t payloadSize = 0;
 
-    getNextTelemetryPayload(&payloadSize, &payload);
-    EXPECT_EQ(currentPayloadIndex, 3);
+    ASSERT_TRUE(getNextTelemetryFrame(CRSF_FRAMETYPE_ATTITUDE, &payloadSize, &payload));
 
     int16_t pitch = payload[3] << 8 | payload[4]; // rad / 10000
     EXPECT_EQ(11833, pitch);
@@ -199,15 +227,13 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestAttitude)
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestFlightMode)
 {
     initTelemetry();
-    currentPayloadIndex = 3;
 
     airMode = false;
 
     uint8_t *payload = 0;
     uint8_t payloadSize = 0;
 
-    getNextTelemetryPayload(&payloadSize, &payload);
-    EXPECT_EQ(currentPayloadIndex, 0);
+    ASSERT_TRUE(getNextTelemetryFrame(CRSF_FRAMETYPE_FLIGHT_MODE, &payloadSize, &payload));
 
     EXPECT_EQ('W', payload[3]);
     EXPECT_EQ('A', payload[4]);
@@ -219,6 +245,63 @@ TEST(RxSpiExpressLrsTelemetryUnitTest, TestFlightMode)
     testSetDataToTransmit(payloadSize, payload);
 }
 
+TEST(RxSpiExpressLrsTelemetryUnitTest, TestBudgetFromTelemetryRatio)
+{
+    uint8_t *payload = 0;
+    uint8_t payloadSize = 0;
+
+    // 250Hz at 1:8 with a burst of one, a frame packet every 16 packets: 78 bytes/s
+    initTelemetry();
+    updateTelemetryRate(250, 8, 1);
+    uint32_t bytesSent = 0;
+    for (int i = 0; i < 2500; i++) {
+        testTimeUs += 4000;
+        attitude.values.roll++;
+        if (getNextTelemetryPayload(&payloadSize, &payload)) {
+            bytesSent += payloadSize;
+        }
+    }
+    EXPECT_LE(bytesSent, 780 + 2 * (CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD));
+    EXPECT_GE(bytesSent, 780 - 2 * (CRSF_FRAME_GPS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD));
+
+    // 1:2 carries four times as much
+    updateTelemetryRate(250, 2, 1);
+    bytesSent = 0;
+    for (int i = 0; i < 2500; i++) {
+        testTimeUs += 4000;
+        attitude.values.roll++;
+        if (getNextTelemetryPayload(&payloadSize, &payload)) {
+            bytesSent += payloadSize;
+        }
+    }
+    EXPECT_GE(bytesSent, 3 * 780);
+}
+
+TEST(RxSpiExpressLrsTelemetryUnitTest, TestWeightedShare)
+{
+    uint8_t *payload = 0;
+    uint8_t payloadSize = 0;
+    int attitudeFrames = 0;
+    int gpsFrames = 0;
+
+    initTelemetry();
+    updateTelemetryRate(250, 8, 1);
+    for (int i = 0; i < 2500; i++) {
+        testTimeUs += 4000;
+        // keep every frame changing so they all compete for the link
+        attitude.values.roll++;
+        gpsSol.llh.lat++;
+        testBatteryVoltage++;
+        if (getNextTelemetryPayload(&payloadSize, &payload)) {
+            attitudeFrames += payload[2] == CRSF_FRAMETYPE_ATTITUDE;
+            gpsFrames += payload[2] == CRSF_FRAMETYPE_GPS;
+        }
+    }
+    // attitude has twice the weight of GPS and half the frame size
+    EXPECT_GT(gpsFrames, 0);
+    EXPECT_GT(attitudeFrames, 3 * gpsFrames);
+}
+
 TEST(RxSpiExpressLrsTelemetryUnitTest, TestMspVersionRequest)
 { 
     uint8_t request[15] = {238, 12, 122, 200, 234, 48, 0, 1, 1, 0, 0, 0, 0, 128, 0};
@@ -397,6 +480,7 @@ extern "C" {
     uint8_t stateFlags;
     uint16_t flightModeFlags;
 
+    uint32_t micros(void) {return testTimeUs; }
     uint32_t microsISR(void) {return 0; }
 
     void beeperConfirmationBeeps(uint8_t ) {}
@@ -419,6 +503,19 @@ extern "C" {
 
     bool airmodeIsEnabled(void) {return airMode; }
 
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+    float rcCommand[4];
+    float rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+    controlRateConfig_t *currentControlRateProfile;
+    pidRuntime_t pidRuntime;
+
+    bool IS_RC_MODE_ACTIVE(boxId_e) { return false; }
+    bool failsafeIsActive(void) { return false; }
+    const lowVoltageCutoff_t *getLowVoltageCutoff(void) { return NULL; }
+    void imuQuaternionHeadfreeTransformVectorEarthToBody(t_fp_vector_def *) {}
+    timeDelta_t rxGetFrameDelta(timeDelta_t *frameAgeUs) { *frameAgeUs = 0; return 20000; }
+
     bool isBatteryVoltageConfigured(void) { return true; }
     bool isAmperageConfigured(void) { return true; }
 
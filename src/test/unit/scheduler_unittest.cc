@@ -101,6 +101,12 @@ extern "C" {
     bool osdUpdateCheck(timeUs_t, timeDelta_t) { simulatedTime += TEST_UPDATE_OSD_CHECK_TIME; return false; }
     void osdUpdate(timeUs_t) { simulatedTime += TEST_UPDATE_OSD_TIME; }
 
+    // each stack sample reports a depth one deeper than the last
+    int stackSampleCount = 0;
+    void stackSampleBegin(void) {}
+    uint32_t stackSampleEnd(void) { return ++stackSampleCount; }
+    void taskStackCheckUpdate(timeUs_t) { schedulerSampleNextTaskStack(); }
+
     void resetGyroTaskTestFlags(void) {
         taskGyroRan = false;
         taskFilterRan = false;
@@ -181,6 +187,12 @@ extern "C" {
             .desiredPeriodUs = TASK_PERIOD_HZ(50),
             .staticPriority = TASK_PRIORITY_MEDIUM,
         },
+        [TASK_STACK_CHECK] = {
+            .taskName = "STACKCHECK",
+            .taskFunc = taskStackCheckUpdate,
+            .desiredPeriodUs = TASK_PERIOD_HZ(10),
+            .staticPriority = TASK_PRIORITY_LOWEST,
+        },
         [TASK_OSD] = {
             .taskName = "OSD",
             .checkFunc = osdUpdateCheck,
@@ -633,3 +645,103 @@ TEST(SchedulerUnittest, TestGyroTask)
     EXPECT_EQ(static_cast<task_t*>(0), unittest_scheduler_selectedTask);
 }
 
+TEST(SchedulerUnittest, TestTaskHistogram)
+{
+    schedulerResetTaskHistogram(TASK_ACCEL);
+    tasks[TASK_ACCEL].lastExecutedAtUs = 1000;
+    tasks[TASK_ACCEL].lastStatsAtUs = 1000;
+    // task is due at 2000us, so run it 50us late
+    simulatedTime = 2050;
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+
+    taskHistogram_t histogram;
+    getTaskHistogram(TASK_ACCEL, &histogram);
+    // both the 32us execution time and the 50us start latency fall into the [32, 64) bucket
+    for (int i = 0; i < TASK_HISTOGRAM_BUCKET_COUNT; i++) {
+        EXPECT_EQ(i == 6 ? 1 : 0, histogram.execTime[i]);
+        EXPECT_EQ(i == 6 ? 1 : 0, histogram.startLatency[i]);
+    }
+    EXPECT_EQ(64, taskHistogramPercentileUs(histogram.execTime, 50));
+    EXPECT_EQ(64, taskHistogramPercentileUs(histogram.startLatency, 99));
+
+    schedulerResetTaskHistogram(TASK_ACCEL);
+    getTaskHistogram(TASK_ACCEL, &histogram);
+    EXPECT_EQ(0, histogram.execTime[6]);
+    EXPECT_EQ(0, histogram.startLatency[6]);
+    EXPECT_EQ(0, taskHistogramPercentileUs(histogram.execTime, 99));
+}
+
+TEST(SchedulerUnittest, TestTaskHistogramPercentile)
+{
+    uint16_t buckets[TASK_HISTOGRAM_BUCKET_COUNT] = { 0 };
+
+    // 98 samples at [2, 4)us and two outliers at [1024, 2048)us
+    buckets[2] = 98;
+    buckets[11] = 2;
+    EXPECT_EQ(4, taskHistogramPercentileUs(buckets, 50));
+    EXPECT_EQ(4, taskHistogramPercentileUs(buckets, 98));
+    EXPECT_EQ(2048, taskHistogramPercentileUs(buckets, 99));
+    EXPECT_EQ(2048, taskHistogramPercentileUs(buckets, 100));
+}
+
+TEST(SchedulerUnittest, TestStackSampleRotation)
+{
+    for (int taskId = 0; taskId < TASK_COUNT; ++taskId) {
+        setTaskEnabled(static_cast<taskId_e>(taskId), false);
+    }
+    setTaskEnabled(TASK_ACCEL, true);
+    setTaskEnabled(TASK_ATTITUDE, true);
+    setTaskEnabled(TASK_STACK_CHECK, true);
+    tasks[TASK_ACCEL].stackPeakBytes = 0;
+    tasks[TASK_ATTITUDE].stackPeakBytes = 0;
+    tasks[TASK_STACK_CHECK].stackPeakBytes = 0;
+    stackSampleCount = 0;
+    simulatedTime = 100000;
+
+    // when, the stack check task arms a sample for the next enabled task
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+
+    // then, only the armed task is sampled, and only once
+    EXPECT_EQ(1, tasks[TASK_ACCEL].stackPeakBytes);
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+    schedulerExecuteTask(&tasks[TASK_ATTITUDE], simulatedTime);
+    EXPECT_EQ(1, stackSampleCount);
+
+    // when, the rotation moves on through the enabled tasks
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    schedulerExecuteTask(&tasks[TASK_ATTITUDE], simulatedTime);
+    EXPECT_EQ(2, tasks[TASK_ATTITUDE].stackPeakBytes);
+
+    // then, it includes the stack check task itself
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    EXPECT_EQ(3, tasks[TASK_STACK_CHECK].stackPeakBytes);
+
+    // and wraps back to the first, armed by the next run of the stack check task
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+    EXPECT_EQ(1, tasks[TASK_ACCEL].stackPeakBytes);
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+    EXPECT_EQ(4, tasks[TASK_ACCEL].stackPeakBytes);
+
+    // when, the armed task doesn't run, it keeps the sample for a while
+    schedulerSampleNextTaskStack();
+    for (int i = 1; i < 10; i++) {
+        schedulerSampleNextTaskStack();
+    }
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+    EXPECT_EQ(4, stackSampleCount);
+
+    // then, the sample moves on to the next task
+    schedulerSampleNextTaskStack();
+    schedulerExecuteTask(&tasks[TASK_ATTITUDE], simulatedTime);
+    EXPECT_EQ(4, stackSampleCount);
+    schedulerExecuteTask(&tasks[TASK_STACK_CHECK], simulatedTime);
+    EXPECT_EQ(5, tasks[TASK_STACK_CHECK].stackPeakBytes);
+
+    // the peak is kept
+    tasks[TASK_ACCEL].stackPeakBytes = 100;
+    schedulerExecuteTask(&tasks[TASK_ACCEL], simulatedTime);
+    EXPECT_EQ(100, tasks[TASK_ACCEL].stackPeakBytes);
+}
@@ -0,0 +1,233 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/serial.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define TEST_BUFFER_SIZE 16
+
+static uint8_t rxBuffer[TEST_BUFFER_SIZE];
+static uint8_t txBuffer[TEST_BUFFER_SIZE];
+
+static uint32_t testRxWaiting(const serialPort_t *instance)
+{
+    return (instance->rxBufferHead - instance->rxBufferTail + instance->rxBufferSize) % instance->rxBufferSize;
+}
+
+static uint32_t testTxFree(const serialPort_t *instance)
+{
+    return instance->txBufferSize - 1 - (instance->txBufferHead - instance->txBufferTail + instance->txBufferSize) % instance->txBufferSize;
+}
+
+static uint8_t testRead(serialPort_t *instance)
+{
+    const uint8_t ch = instance->rxBuffer[instance->rxBufferTail];
+    instance->rxBufferTail = (instance->rxBufferTail + 1) % instance->rxBufferSize;
+    return ch;
+}
+
+static void testWrite(serialPort_t *instance, uint8_t ch)
+{
+    instance->txBuffer[instance->txBufferHead] = ch;
+    instance->txBufferHead = (instance->txBufferHead + 1) % instance->txBufferSize;
+}
+
+static uint32_t testRxSpan(serialPort_t *instance, const uint8_t **data)
+{
+    return serialRingRxSpan(instance, data);
+}
+
+static uint32_t testTxSpan(serialPort_t *instance, uint8_t **data)
+{
+    return serialRingTxSpan(instance, testTxFree(instance), data);
+}
+
+static const struct serialPortVTable testVTable = {
+    .serialWrite = testWrite,
+    .serialTotalRxWaiting = testRxWaiting,
+    .serialTotalTxFree = testTxFree,
+    .serialRead = testRead,
+    .serialSetBaudRate = NULL,
+    .isSerialTransmitBufferEmpty = NULL,
+    .setMode = NULL,
+    .setCtrlLineStateCb = NULL,
+    .setBaudRateCb = NULL,
+    .writeBuf = NULL,
+    .beginWrite = NULL,
+    .endWrite = NULL,
+    .rxSpan = testRxSpan,
+    .rxConsume = serialRingRxConsume,
+    .txSpan = testTxSpan,
+    .txCommit = serialRingTxCommit,
+};
+
+// The same port without span access
+static const struct serialPortVTable testBytewiseVTable = {
+    .serialWrite = testWrite,
+    .serialTotalRxWaiting = testRxWaiting,
+    .serialTotalTxFree = testTxFree,
+    .serialRead = testRead,
+    .serialSetBaudRate = NULL,
+    .isSerialTransmitBufferEmpty = NULL,
+    .setMode = NULL,
+    .setCtrlLineStateCb = NULL,
+    .setBaudRateCb = NULL,
+    .writeBuf = NULL,
+    .beginWrite = NULL,
+    .endWrite = NULL,
+    .rxSpan = NULL,
+    .rxConsume = NULL,
+    .txSpan = NULL,
+    .txCommit = NULL,
+};
+
+static void initPort(serialPort_t *port, const struct serialPortVTable *vTable, uint32_t start)
+{
+    memset(port, 0, sizeof(*port));
+    port->vTable = vTable;
+    port->rxBuffer = rxBuffer;
+    port->txBuffer = txBuffer;
+    port->rxBufferSize = TEST_BUFFER_SIZE;
+    port->txBufferSize = TEST_BUFFER_SIZE;
+    // start part way through the rings so that transfers wrap
+    port->rxBufferHead = port->rxBufferTail = start;
+    port->txBufferHead = port->txBufferTail = start;
+}
+
+static void receive(serialPort_t *port, const uint8_t *data, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        port->rxBuffer[port->rxBufferHead] = data[i];
+        port->rxBufferHead = (port->rxBufferHead + 1) % port->rxBufferSize;
+    }
+}
+
+TEST(SerialUnittest, TestRxSpanWraps)
+{
+    serialPort_t port;
+    initPort(&port, &testVTable, 12);
+
+    const uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7 };
+    receive(&port, data, sizeof(data));
+
+    // the span stops at the end of the buffer, the remainder follows from the start
+    const uint8_t *span;
+    EXPECT_EQ(4, serialRxSpan(&port, &span));
+    EXPECT_EQ(0, memcmp(span, data, 4));
+
+    serialRxConsume(&port, 4);
+    EXPECT_EQ(3, serialRxSpan(&port, &span));
+    EXPECT_EQ(rxBuffer, span);
+    EXPECT_EQ(0, memcmp(span, data + 4, 3));
+
+    serialRxConsume(&port, 3);
+    EXPECT_EQ(0, serialRxSpan(&port, &span));
+    EXPECT_EQ(0, serialRxBytesWaiting(&port));
+}
+
+TEST(SerialUnittest, TestReadBuf)
+{
+    const uint8_t data[] = { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 };
+    const struct serialPortVTable *vTables[] = { &testVTable, &testBytewiseVTable };
+
+    for (const struct serialPortVTable *vTable : vTables) {
+        serialPort_t port;
+        initPort(&port, vTable, 9);
+        receive(&port, data, sizeof(data));
+
+        uint8_t out[16];
+        EXPECT_EQ(3, serialReadBuf(&port, out, 3));
+        EXPECT_EQ(0, memcmp(out, data, 3));
+
+        // asking for more than is waiting returns what there is
+        EXPECT_EQ(7, serialReadBuf(&port, out, sizeof(out)));
+        EXPECT_EQ(0, memcmp(out, data + 3, 7));
+        EXPECT_EQ(0, serialRxBytesWaiting(&port));
+    }
+}
+
+TEST(SerialUnittest, TestWriteBufThroughTxSpan)
+{
+    const uint8_t data[] = { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30 };
+
+    serialPort_t port;
+    initPort(&port, &testVTable, 10);
+
+    serialWriteBuf(&port, data, sizeof(data));
+
+    EXPECT_EQ(5, port.txBufferHead);
+    for (uint32_t i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(data[i], txBuffer[(10 + i) % TEST_BUFFER_SIZE]);
+    }
+
+    // the span is limited by the free space as well as by the end of the buffer
+    uint8_t *span;
+    EXPECT_EQ(TEST_BUFFER_SIZE - 1 - sizeof(data), serialTxSpan(&port, &span));
+    EXPECT_EQ(&txBuffer[5], span);
+}
+
+TEST(SerialUnittest, TestRxEventDelimiterAndWatermark)
+{
+    serialPort_t port;
+    serialRxEvent_t event = { .pending = false };
+    initPort(&port, &testVTable, 14);
+
+    // ports are polled unless the driver can raise the event
+    EXPECT_FALSE(serialSetRxEvent(&port, &event, '\n', 8));
+    port.rxEventCapable = true;
+    EXPECT_TRUE(serialSetRxEvent(&port, &event, '\n', 8));
+
+    const uint8_t line[] = { 'a', 'b', '\n' };
+    for (uint32_t i = 0; i < sizeof(line); i++) {
+        EXPECT_FALSE(event.pending);
+        receive(&port, &line[i], 1);
+        serialRxEventCheck(&port, line[i]);
+    }
+    EXPECT_TRUE(event.pending);
+
+    // the watermark counts across the wrap of the ring
+    event.pending = false;
+    const uint8_t data = 'x';
+    for (int i = 0; i < 4; i++) {
+        receive(&port, &data, 1);
+        serialRxEventCheck(&port, data);
+    }
+    EXPECT_FALSE(event.pending);
+    receive(&port, &data, 1);
+    serialRxEventCheck(&port, data);
+    EXPECT_TRUE(event.pending);
+
+    // no signals once the consumer has gone
+    event.pending = false;
+    serialSetRxEvent(&port, NULL, -1, 0);
+    serialRxEventSignal(&port);
+    EXPECT_FALSE(event.pending);
+}
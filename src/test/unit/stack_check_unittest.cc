@@ -0,0 +1,173 @@
+/*
+ * This file is part of Betaflight.
+ *
+ * Betaflight is free software. You can redistribute this software
+ * and/or modify this software under the terms of the GNU General
+ * Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * Betaflight is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "drivers/stack_check.h"
+
+    char _estack;
+    char _Min_Stack_Size;
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+#define STACK_WORDS 1024
+
+static uint32_t stack[STACK_WORDS];
+static stackScan_t scan;
+
+// Paint the whole stack, then mark the words from index down to the top as used
+static void initStack(int usedFrom)
+{
+    memset(stack, STACK_FILL_CHAR, sizeof(stack));
+    for (int i = usedFrom; i < STACK_WORDS; i++) {
+        stack[i] = i;
+    }
+    stackScanInit(&scan, stack, stack + STACK_WORDS);
+}
+
+TEST(StackCheckTest, UsedSizeBeforeFirstUpdate)
+{
+    initStack(STACK_WORDS);
+
+    EXPECT_EQ(0U, stackScanUsedSize(&scan));
+}
+
+TEST(StackCheckTest, WatermarkFollowsTheStackPointer)
+{
+    initStack(STACK_WORDS - 16);
+
+    stackScanUpdate(&scan, &stack[STACK_WORDS - 16]);
+
+    EXPECT_EQ(&stack[STACK_WORDS - 16], scan.watermark);
+    EXPECT_EQ(16 * sizeof(uint32_t), stackScanUsedSize(&scan));
+}
+
+TEST(StackCheckTest, IncrementalScanFindsDeeperUse)
+{
+    // the stack pointer is near the top, but something went deep into the stack earlier
+    initStack(STACK_WORDS - 16);
+    stack[300] = 0;
+
+    // each update only examines part of the painted region, resuming where the last one stopped
+    stackScanUpdate(&scan, &stack[STACK_WORDS - 16]);
+    EXPECT_EQ(&stack[STACK_WORDS - 16], scan.watermark);
+    EXPECT_EQ(&stack[256], scan.cursor);
+
+    stackScanUpdate(&scan, &stack[STACK_WORDS - 16]);
+    EXPECT_EQ(&stack[300], scan.watermark);
+    EXPECT_EQ((STACK_WORDS - 300) * sizeof(uint32_t), stackScanUsedSize(&scan));
+
+    // and starts over from the bottom once it has reached the watermark
+    EXPECT_EQ(stack, scan.cursor);
+}
+
+TEST(StackCheckTest, ScanStopsAtTheWatermark)
+{
+    initStack(STACK_WORDS - 16);
+
+    for (int i = 0; i < 8; i++) {
+        stackScanUpdate(&scan, &stack[STACK_WORDS - 16]);
+        EXPECT_LE(scan.cursor, scan.watermark);
+    }
+
+    EXPECT_EQ(&stack[STACK_WORDS - 16], scan.watermark);
+}
+
+TEST(StackCheckTest, SampleMeasuresDepthOfCall)
+{
+    initStack(STACK_WORDS - 200);
+    stackScanUpdate(&scan, &stack[STACK_WORDS - 200]);
+
+    // no sample before it has begun
+    EXPECT_EQ(0U, stackScanSampleEnd(&scan, &stack[STACK_WORDS - 200]));
+
+    // the stack left over from earlier calls is repainted, except for the guard below the stack pointer
+    uint32_t * const current = &stack[STACK_WORDS - 8];
+    stack[STACK_WORDS - 100] = 0;
+    stackScanSampleBegin(&scan, current);
+    EXPECT_EQ(STACK_FILL_WORD, stack[STACK_WORDS - 100]);
+    EXPECT_EQ(STACK_FILL_WORD, stack[STACK_WORDS - 73]);
+    EXPECT_NE(STACK_FILL_WORD, stack[STACK_WORDS - 72]);
+
+    // a call from a shallower stack pointer goes deeper than anything seen so far
+    stack[STACK_WORDS - 240] = 0;
+
+    EXPECT_EQ(240 * sizeof(uint32_t), stackScanSampleEnd(&scan, current));
+    EXPECT_EQ(&stack[STACK_WORDS - 240], scan.watermark);
+
+    // the sample is consumed
+    EXPECT_EQ(0U, stackScanSampleEnd(&scan, current));
+}
+
+TEST(StackCheckTest, SampleRecordsUseTheScanHasNotReached)
+{
+    initStack(STACK_WORDS - 16);
+    stackScanUpdate(&scan, &stack[STACK_WORDS - 16]);
+
+    // used just below the watermark, before the scan got there
+    stack[STACK_WORDS - 20] = 0;
+    stackScanSampleBegin(&scan, &stack[STACK_WORDS - 16]);
+
+    EXPECT_EQ(&stack[STACK_WORDS - 20], scan.watermark);
+
+    // the use is within the guard below the stack pointer, so it is not repainted and counts towards the sample
+    EXPECT_EQ(20 * sizeof(uint32_t), stackScanSampleEnd(&scan, &stack[STACK_WORDS - 16]));
+    EXPECT_EQ(20 * sizeof(uint32_t), stackScanUsedSize(&scan));
+}
+
+#define LIVE_FRAME_WORDS 16
+
+// Begins a sample the way stackSampleBegin() does on the target. The words just below the stack pointer
+// stand in for the frames of the calls that do the painting, which are live while it runs
+static __attribute__((noinline)) bool sampleBeginFromHere(stackScan_t *liveScan)
+{
+    uint32_t frame[LIVE_FRAME_WORDS];
+    for (int i = 0; i < LIVE_FRAME_WORDS; i++) {
+        frame[i] = i;
+    }
+
+    stackScanSampleBegin(liveScan, &frame[LIVE_FRAME_WORDS]);
+
+    for (int i = 0; i < LIVE_FRAME_WORDS; i++) {
+        if (frame[i] != (uint32_t)i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(StackCheckTest, SampleLeavesTheLiveFrameAlone)
+{
+    // scan the stack of this thread, so the calls that paint it run inside the scanned region
+    uint32_t top;
+    uint32_t * const high = &top;
+    stackScanInit(&scan, high - STACK_WORDS, high);
+    stackScanUpdate(&scan, high - STACK_WORDS / 2);
+
+    EXPECT_TRUE(sampleBeginFromHere(&scan));
+    EXPECT_EQ(STACK_FILL_WORD, *(high - STACK_WORDS / 2));
+}
@@ -43,14 +43,21 @@ extern "C" {
     #include "drivers/serial.h"
     #include "drivers/system.h"
 
+    #include "fc/controlrate_profile.h"
+    #include "fc/rc.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
     #include "fc/runtime_config.h"
     #include "config/config.h"
+    #include "flight/failsafe.h"
     #include "flight/imu.h"
+    #include "flight/pid.h"
 
     #include "io/serial.h"
     #include "io/gps.h"
 
     #include "msp/msp.h"
+    #include "msp/msp_protocol.h"
     #include "msp/msp_serial.h"
 
     #include "rx/rx.h"
@@ -60,6 +67,7 @@ extern "C" {
     #include "sensors/sensors.h"
 
     #include "telemetry/telemetry.h"
+    #include "telemetry/crsf.h"
     #include "telemetry/msp_shared.h"
     #include "telemetry/smartport.h"
     #include "sensors/acceleration.h"
@@ -85,14 +93,17 @@ extern "C" {
     PG_REGISTER(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 0);
     PG_REGISTER(rxConfig_t, rxConfig, PG_RX_CONFIG, 0);
     PG_REGISTER(accelerometerConfig_t, accelerometerConfig, PG_ACCELEROMETER_CONFIG,0);
+    PG_REGISTER(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
+    PG_REGISTER(flight3DConfig_t, flight3DConfig, PG_MOTOR_3D_CONFIG, 0);
 
     extern bool crsfFrameDone;
     extern crsfFrame_t crsfFrame;
     extern uint8_t requestBuffer[MSP_TLM_INBUF_SIZE];
     extern struct mspPacket_s requestPacket;
-    extern struct mspPacket_s responsePacket;
+    extern mspTlmResponse_t responses[MSP_TLM_RESPONSE_COUNT];
 
     uint32_t dummyTimeUs;
+    int mspProcessCount;
 
 }
 
@@ -142,7 +153,7 @@ TEST(CrossFireMSPTest, ResponsePacketTest)
     uint8_t *frameStart = (uint8_t *)&crsfFrame.frame.payload + 2;
     handleMspFrame(frameStart, CRSF_FRAME_RX_MSP_FRAME_SIZE, NULL);
     for (unsigned int ii=1; ii<30; ii++) {
-        EXPECT_EQ(ii, sbufReadU8(&responsePacket.buf));
+        EXPECT_EQ(ii, sbufReadU8(&responses[0].packet.buf));
     }
 }
 
@@ -250,13 +261,132 @@ TEST(CrossFireMSPTest, SendMspReply)
     }
 }
 
+// MSPv1 request for the given function, with a single byte of payload when it is a write
+static void bufferMspRequest(uint8_t function, bool write)
+{
+    uint8_t request[CRSF_FRAME_RX_MSP_FRAME_SIZE] = { 0x30, write ? (uint8_t)1 : (uint8_t)0, function };
+    bufferCrsfMspFrame(request, sizeof(request));
+}
+
+static uint8_t sentFunctions[16];
+static uint8_t sentStatus[16];
+static int sentCount;
+
+static void recordMspResponse(uint8_t *payload, const uint8_t)
+{
+    sentStatus[sentCount] = payload[0];
+    sentFunctions[sentCount] = payload[2];
+    sentCount++;
+}
+
+static void initPipeline(void)
+{
+    initSharedMsp();
+    initCrsfMspBuffer();
+    sentCount = 0;
+    mspProcessCount = 0;
+}
+
+TEST(CrossFireMSPTest, PipelinedRequests)
+{
+    initPipeline();
+
+    // More requests in flight than there are response slots
+    bufferMspRequest(MSP_STATUS, false);
+    bufferMspRequest(MSP_RAW_IMU, false);
+    bufferMspRequest(MSP_ANALOG, false);
+    bufferMspRequest(MSP_ATTITUDE, false);
+
+    EXPECT_TRUE(handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(3, mspProcessCount);
+    EXPECT_EQ(1, sentCount);
+
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+
+    // The held back request is handled once a slot frees up, and replies keep the request order
+    EXPECT_EQ(4, mspProcessCount);
+    EXPECT_EQ(4, sentCount);
+    EXPECT_EQ(MSP_STATUS, sentFunctions[0]);
+    EXPECT_EQ(MSP_RAW_IMU, sentFunctions[1]);
+    EXPECT_EQ(MSP_ANALOG, sentFunctions[2]);
+    EXPECT_EQ(MSP_ATTITUDE, sentFunctions[3]);
+    for (int i = 1; i < sentCount; i++) {
+        EXPECT_EQ((sentStatus[i - 1] + 1) & 0x0f, sentStatus[i] & 0x0f);
+    }
+    EXPECT_FALSE(hasPendingMspReply());
+}
+
+TEST(CrossFireMSPTest, CachesReadOnlyResponses)
+{
+    initPipeline();
+
+    bufferMspRequest(MSP_BOARD_INFO, false);
+    bufferMspRequest(MSP_BOARD_INFO, false);
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(2, sentCount);
+    EXPECT_EQ(1, mspProcessCount);
+    EXPECT_EQ(MSP_BOARD_INFO, sentFunctions[1]);
+
+    // Live data is never cached
+    bufferMspRequest(MSP_STATUS, false);
+    bufferMspRequest(MSP_STATUS, false);
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(3, mspProcessCount);
+
+    // Nor is configuration which may be changed from outside this link
+    bufferMspRequest(MSP_PID, false);
+    bufferMspRequest(MSP_PID, false);
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(5, mspProcessCount);
+
+    // The cached response survives reads, but not a write
+    bufferMspRequest(MSP_BOARD_INFO, false);
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(5, mspProcessCount);
+    bufferMspRequest(MSP_SET_BOARD_INFO, true);
+    bufferMspRequest(MSP_BOARD_INFO, false);
+    while (handleCrsfMspFrameBuffer(&recordMspResponse));
+    EXPECT_EQ(7, mspProcessCount);
+    EXPECT_EQ(9, sentCount);
+}
+
+TEST(CrossFireMSPTest, RefusesRequestsWhileTheQueueIsFull)
+{
+    initPipeline();
+
+    // Requests handed straight to the shared MSP handler, the way a link that does not hold them back would
+    uint8_t apiVersion[] = { 0x30, 0x00, MSP_API_VERSION };
+    for (int i = 0; i < MSP_TLM_RESPONSE_COUNT; i++) {
+        EXPECT_TRUE(handleMspFrame(apiVersion, sizeof(apiVersion), NULL));
+    }
+    EXPECT_TRUE(isMspReplyQueueFull());
+    EXPECT_EQ(1, mspProcessCount);
+
+    // A repeated cached read and a request that would have to be run are both refused
+    EXPECT_FALSE(handleMspFrame(apiVersion, sizeof(apiVersion), NULL));
+    uint8_t status[] = { 0x30, 0x00, MSP_STATUS };
+    EXPECT_FALSE(handleMspFrame(status, sizeof(status), NULL));
+    EXPECT_EQ(1, mspProcessCount);
+
+    // Only the queued replies go out
+    while (sendMspReply(CRSF_FRAME_TX_MSP_FRAME_SIZE, &recordMspResponse));
+    EXPECT_EQ(MSP_TLM_RESPONSE_COUNT, sentCount);
+    for (int i = 0; i < sentCount; i++) {
+        EXPECT_EQ(MSP_API_VERSION, sentFunctions[i]);
+    }
+    EXPECT_FALSE(hasPendingMspReply());
+
+    // and requests are handled again once there is room
+    EXPECT_TRUE(handleMspFrame(status, sizeof(status), NULL));
+    EXPECT_EQ(2, mspProcessCount);
+}
+
 // STUBS
 
 extern "C" {
 
     gpsSolutionData_t gpsSol;
     attitudeEulerAngles_t attitude = { { 0, 0, 0 } };
-    uint8_t responseBuffer[MSP_TLM_OUTBUF_SIZE];
 
     uint32_t micros(void) {return dummyTimeUs;}
     uint32_t microsISR(void) {return micros();}
@@ -289,6 +419,19 @@ extern "C" {
 
     bool airmodeIsEnabled(void) {return true;}
 
+    int16_t debug[DEBUG16_VALUE_COUNT];
+    uint8_t debugMode;
+    float rcCommand[4];
+    float rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+    controlRateConfig_t *currentControlRateProfile;
+    pidRuntime_t pidRuntime;
+
+    bool IS_RC_MODE_ACTIVE(boxId_e) { return false; }
+    bool failsafeIsActive(void) { return false; }
+    const lowVoltageCutoff_t *getLowVoltageCutoff(void) { return NULL; }
+    void imuQuaternionHeadfreeTransformVectorEarthToBody(t_fp_vector_def *) {}
+    timeDelta_t rxGetFrameDelta(timeDelta_t *frameAgeUs) { *frameAgeUs = 0; return 20000; }
+
     mspDescriptor_t mspDescriptorAlloc(void) {return 0;}
 
     mspResult_e mspFcProcessCommand(mspDescriptor_t srcDesc, mspPacket_t *cmd, mspPacket_t *reply, mspPostProcessFnPtr *mspPostProcessFn) {
@@ -296,6 +439,8 @@ extern "C" {
         UNUSED(srcDesc);
         UNUSED(mspPostProcessFn);
 
+        mspProcessCount++;
+
         sbuf_t *dst = &reply->buf;
         const uint8_t cmdMSP = cmd->cmd;
         reply->cmd = cmd->cmd;
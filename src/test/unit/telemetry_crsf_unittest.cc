@@ -38,12 +38,18 @@ extern "C" {
     #include "pg/pg_ids.h"
     #include "pg/rx.h"
 
+    #include "drivers/persistent.h"
     #include "drivers/serial.h"
     #include "drivers/system.h"
 
     #include "config/config.h"
+    #include "fc/controlrate_profile.h"
+    #include "fc/rc.h"
+    #include "fc/rc_controls.h"
+    #include "fc/rc_modes.h"
     #include "fc/runtime_config.h"
 
+    #include "flight/failsafe.h"
     #include "flight/pid.h"
     #include "flight/imu.h"
 
@@ -69,6 +75,10 @@ extern "C" {
     uint16_t testBatteryVoltage = 0;
     int32_t testAmperage = 0;
     int32_t testmAhDrawn = 0;
+    timeDelta_t testRxFrameDeltaUs = 20000;
+    serialPort_t testSerialPort;
+    serialPortConfig_t testSerialPortConfig;
+    int testFramesWritten[UINT8_MAX + 1];
 
     serialPort_t *telemetrySharedPort;
 
@@ -79,6 +89,8 @@ extern "C" {
     PG_REGISTER(systemConfig_t, systemConfig, PG_SYSTEM_CONFIG, 0);
     PG_REGISTER(rxConfig_t, rxConfig, PG_RX_CONFIG, 0);
     PG_REGISTER(accelerometerConfig_t, accelerometerConfig, PG_ACCELEROMETER_CONFIG, 0);
+    PG_REGISTER(rcControlsConfig_t, rcControlsConfig, PG_RC_CONTROLS_CONFIG, 0);
+    PG_REGISTER(flight3DConfig_t, flight3DConfig, PG_MOTOR_3D_CONFIG, 0);
 }
 
 #include "unittest_macros.h"
@@ -299,6 +311,52 @@ TEST(TelemetryCrsfTest, TestFlightMode)
     EXPECT_EQ(crfsCrc(frame, frameLen), frame[7]);
 }
 
+TEST(TelemetryCrsfTest, TestRxRateValid)
+{
+    // a 50Hz link is a valid rx interval
+    testRxFrameDeltaUs = 20000;
+    updateRcRefreshRate(1000000);
+    EXPECT_TRUE(getRxRateValid());
+    EXPECT_EQ(20000, getCurrentRxIntervalUs());
+
+    // a frame gap beyond the longest rx interval is clipped and marked invalid
+    testRxFrameDeltaUs = 100000;
+    updateRcRefreshRate(1100000);
+    EXPECT_FALSE(getRxRateValid());
+
+    testRxFrameDeltaUs = 20000;
+    updateRcRefreshRate(1120000);
+    EXPECT_TRUE(getRxRateValid());
+}
+
+TEST(TelemetryCrsfTest, TestLowRateScheduling)
+{
+    rxRuntimeState_t rxRuntimeState;
+    memset(testFramesWritten, 0, sizeof(testFramesWritten));
+
+    // an invalid rx rate falls back to the smallest telemetry budget
+    testRxFrameDeltaUs = 100000;
+    updateRcRefreshRate(3000000);
+    EXPECT_FALSE(getRxRateValid());
+
+    sensorsSet(SENSOR_ACC);
+    crsfRxInit(rxConfig(), &rxRuntimeState);
+    initCrsfTelemetry();
+
+    for (timeUs_t currentTimeUs = 3000000; currentTimeUs < 5000000; currentTimeUs += 1000) {
+        attitude.values.roll = currentTimeUs / 1000 % 1800;
+        handleCrsfTelemetry(currentTimeUs);
+    }
+
+    // heartbeats fill the idle slots without eating into the budget of the scheduled frames
+    EXPECT_GT(testFramesWritten[CRSF_FRAMETYPE_HEARTBEAT], 0);
+    EXPECT_GE(testFramesWritten[CRSF_FRAMETYPE_ATTITUDE], 10);
+    EXPECT_GE(testFramesWritten[CRSF_FRAMETYPE_BATTERY_SENSOR], 1);
+
+    testRxFrameDeltaUs = 20000;
+    sensorsClear(SENSOR_ACC);
+}
+
 // STUBS
 
 extern "C" {
@@ -326,13 +384,19 @@ uint32_t serialRxBytesWaiting(const serialPort_t *) {return 0;}
 uint32_t serialTxBytesFree(const serialPort_t *) {return 0;}
 uint8_t serialRead(serialPort_t *) {return 0;}
 void serialWrite(serialPort_t *, uint8_t) {}
-void serialWriteBuf(serialPort_t *, const uint8_t *, int) {}
+void serialWriteBuf(serialPort_t *, const uint8_t *data, int count)
+{
+    if (count > 2) {
+        testFramesWritten[data[2]]++;
+    }
+}
 void serialSetMode(serialPort_t *, portMode_e) {}
-serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return NULL;}
+void serialSetBaudRate(serialPort_t *, uint32_t) {}
+serialPort_t *openSerialPort(serialPortIdentifier_e, serialPortFunction_e, serialReceiveCallbackPtr, void *, uint32_t, portMode_e, portOptions_e) {return &testSerialPort;}
 void closeSerialPort(serialPort_t *) {}
 bool isSerialTransmitBufferEmpty(const serialPort_t *) { return true; }
 
-const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) {return NULL;}
+const serialPortConfig_t *findSerialPortConfig(serialPortFunction_e) {return &testSerialPortConfig;}
 
 bool telemetryDetermineEnabledState(portSharing_e) {return true;}
 bool telemetryCheckRxPortShared(const serialPortConfig_t *, SerialRXType) {return true;}
@@ -342,6 +406,18 @@ portSharing_e determinePortSharing(const serialPortConfig_t *, serialPortFunctio
 
 bool airmodeIsEnabled(void) {return airMode;}
 
+uint8_t debugMode;
+float rcCommand[4];
+float rcData[MAX_SUPPORTED_RC_CHANNEL_COUNT];
+controlRateConfig_t *currentControlRateProfile;
+pidRuntime_t pidRuntime;
+
+bool IS_RC_MODE_ACTIVE(boxId_e) { return false; }
+bool failsafeIsActive(void) { return false; }
+const lowVoltageCutoff_t *getLowVoltageCutoff(void) { return NULL; }
+void imuQuaternionHeadfreeTransformVectorEarthToBody(t_fp_vector_def *) {}
+timeDelta_t rxGetFrameDelta(timeDelta_t *frameAgeUs) { *frameAgeUs = 0; return testRxFrameDeltaUs; }
+
 int32_t getAmperage(void)
 {
     return testAmperage;
@@ -384,6 +460,11 @@ int32_t getMAhDrawn(void)
 
 bool sendMspReply(uint8_t, mspResponseFnPtr) { return false; }
 bool handleMspFrame(uint8_t *, uint8_t, uint8_t *)  { return false; }
+bool hasPendingMspReply(void) { return false; }
+bool isMspReplyQueueFull(void) { return false; }
+bool isEepromWriteInProgress(void) { return false; }
+uint32_t persistentObjectRead(persistentObjectId_e) { return 0; }
+void persistentObjectWrite(persistentObjectId_e, uint32_t) {}
 bool isBatteryVoltageConfigured(void) { return true; }
 bool isAmperageConfigured(void) { return true; }
 timeUs_t rxFrameTimeUs(void) { return 0; }
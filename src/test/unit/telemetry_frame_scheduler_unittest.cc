@@ -0,0 +1,161 @@
+/*
+ * This file is part of Cleanflight and Betaflight.
+ *
+ * Cleanflight and Betaflight are free software. You can redistribute
+ * this software and/or modify this software under the terms of the
+ * GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * Cleanflight and Betaflight are distributed in the hope that they
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software.
+ *
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+extern "C" {
+    #include "platform.h"
+
+    #include "telemetry/frame_scheduler.h"
+}
+
+#include "unittest_macros.h"
+#include "gtest/gtest.h"
+
+static frameScheduler_t scheduler;
+static int sentCount[FRAME_SCHEDULER_ENTRY_COUNT_MAX];
+static uint16_t contents[FRAME_SCHEDULER_ENTRY_COUNT_MAX];
+
+// Offers the link a frame every millisecond for the given time, as the telemetry task would
+static void run(timeUs_t *currentTimeUs, timeDelta_t durationUs, bool changing)
+{
+    for (timeDelta_t t = 0; t < durationUs; t += 1000) {
+        *currentTimeUs += 1000;
+        const int index = frameSchedulerNext(&scheduler, *currentTimeUs);
+        if (index >= 0) {
+            if (changing) {
+                contents[index]++;
+            }
+            if (frameSchedulerCommit(&scheduler, index, *currentTimeUs, contents[index])) {
+                frameSchedulerCharge(&scheduler, scheduler.entries[index].cost);
+                sentCount[index]++;
+            }
+        }
+    }
+}
+
+static void initScheduler(uint32_t bytesPerSecond)
+{
+    frameSchedulerInit(&scheduler, bytesPerSecond);
+    memset(sentCount, 0, sizeof(sentCount));
+    memset(contents, 0, sizeof(contents));
+}
+
+TEST(TelemetryFrameSchedulerTest, SharesLinkByWeight)
+{
+    initScheduler(1000);
+    EXPECT_EQ(0, frameSchedulerAdd(&scheduler, 4, 10, 0, 1000000));
+    EXPECT_EQ(1, frameSchedulerAdd(&scheduler, 1, 10, 0, 1000000));
+
+    timeUs_t currentTimeUs = 1;
+    run(&currentTimeUs, 10000000, true);
+
+    // 1000 bytes/s of 10 byte frames for 10s, split 4:1
+    EXPECT_NEAR(1000, sentCount[0] + sentCount[1], 10);
+    EXPECT_NEAR(800, sentCount[0], 10);
+    EXPECT_NEAR(200, sentCount[1], 10);
+}
+
+TEST(TelemetryFrameSchedulerTest, RespectsMinimumInterval)
+{
+    initScheduler(10000);
+    frameSchedulerAdd(&scheduler, 4, 10, 100000, 1000000);
+    frameSchedulerAdd(&scheduler, 1, 10, 0, 1000000);
+
+    timeUs_t currentTimeUs = 1;
+    run(&currentTimeUs, 1000000, true);
+
+    // The heavier frame is capped at 10Hz and the other frame gets the rest of the link
+    EXPECT_NEAR(10, sentCount[0], 1);
+    EXPECT_GT(sentCount[1], 500);
+}
+
+TEST(TelemetryFrameSchedulerTest, SkipsUnchangedFrames)
+{
+    initScheduler(1000);
+    frameSchedulerAdd(&scheduler, 4, 10, 20000, 500000);
+    frameSchedulerAdd(&scheduler, 1, 10, 20000, 500000);
+
+    timeUs_t currentTimeUs = 1;
+    run(&currentTimeUs, 2000000, false);
+
+    // Unchanged frames only go out when their maximum interval expires
+    EXPECT_NEAR(4, sentCount[0], 1);
+    EXPECT_NEAR(4, sentCount[1], 1);
+
+    // A change is sent within the minimum interval
+    contents[1]++;
+    const int sent = sentCount[1];
+    run(&currentTimeUs, 25000, false);
+    EXPECT_EQ(sent + 1, sentCount[1]);
+}
+
+TEST(TelemetryFrameSchedulerTest, FollowsTheLinkRate)
+{
+    initScheduler(200);
+    frameSchedulerAdd(&scheduler, 1, 10, 0, 1000000);
+
+    timeUs_t currentTimeUs = 1;
+    run(&currentTimeUs, 1000000, true);
+    EXPECT_NEAR(20, sentCount[0], 2);
+
+    // The link got faster
+    frameSchedulerSetRate(&scheduler, 1000);
+    sentCount[0] = 0;
+    run(&currentTimeUs, 1000000, true);
+    EXPECT_NEAR(100, sentCount[0], 2);
+}
+
+TEST(TelemetryFrameSchedulerTest, UnscheduledFramesUseTheBudget)
+{
+    initScheduler(1000);
+    frameSchedulerAdd(&scheduler, 1, 10, 0, 1000000);
+
+    timeUs_t currentTimeUs = 1;
+    for (int i = 0; i < 1000; i++) {
+        run(&currentTimeUs, 1000, true);
+        // Half of the link is taken by ad-hoc frames such as MSP responses
+        if (i % 20 == 0) {
+            frameSchedulerCharge(&scheduler, 10);
+        }
+    }
+
+    EXPECT_NEAR(50, sentCount[0], 5);
+}
+
+TEST(TelemetryFrameSchedulerTest, BurstOfUnscheduledFramesDoesNotStarve)
+{
+    initScheduler(1000);
+    frameSchedulerAdd(&scheduler, 1, 10, 0, 1000000);
+
+    timeUs_t currentTimeUs = 1;
+    run(&currentTimeUs, 100000, true);
+
+    // A burst of MSP responses worth several seconds of the budget
+    for (int i = 0; i < 500; i++) {
+        frameSchedulerCharge(&scheduler, 10);
+    }
+
+    // Scheduled frames resume after a few frame times, not after the burst has been paid off
+    const int sent = sentCount[0];
+    run(&currentTimeUs, 50000, true);
+    EXPECT_GT(sentCount[0], sent);
+}
@@ -153,6 +153,7 @@ extern "C" {
     void pidStabilisationState(pidStabilisationState_e) {}
     void mixTable(timeUs_t) {};
     void writeMotors(void) {};
+    void writeMotorsAtPhase(timeUs_t) {};
     void writeServos(void) {};
     bool calculateRxChannelsAndUpdateFailsafe(timeUs_t) { return true; }
     bool isMixerUsingServos(void) { return false; }
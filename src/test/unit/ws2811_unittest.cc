@@ -32,6 +32,7 @@ extern "C" {
 
 extern "C" {
     void updateLEDDMABuffer(ledStripFormatRGB_e ledFormat, rgbColor24bpp_t *color, unsigned ledIndex);
+    extern volatile bool ws2811LedDataTransferInProgress;
     void schedulerIgnoreTaskExecTime(void) {}
     void schedulerIgnoreTaskStateTime(void) {}
 }
@@ -78,11 +79,108 @@ TEST(WS2812, updateDMABuffer)
     byteIndex++;
 }
 
+TEST(WS2812, updateDMABufferCompareValues)
+{
+    // given
+    BIT_COMPARE_1 = 17;
+    BIT_COMPARE_0 = 9;
+    rgbColor24bpp_t color1 = { .raw = {0x12,0x34,0x56} };
+
+    // when
+    updateLEDDMABuffer(LED_RGB, &color1, 1);
+
+    // then
+    const uint32_t packed = 0x123456;
+    for (unsigned bit = 0; bit < 24; bit++) {
+        const uint16_t expected = (packed & (1 << (23 - bit))) ? 17 : 9;
+        EXPECT_EQ(expected, ledStripDMABuffer[24 + bit]);
+    }
+
+    // and when the compare values change
+    BIT_COMPARE_1 = 5;
+    BIT_COMPARE_0 = 3;
+    updateLEDDMABuffer(LED_RGB, &color1, 1);
+
+    // then
+    for (unsigned bit = 0; bit < 24; bit++) {
+        const uint16_t expected = (packed & (1 << (23 - bit))) ? 5 : 3;
+        EXPECT_EQ(expected, ledStripDMABuffer[24 + bit]);
+    }
+}
+
+static int hsvToRgb24Calls;
+
+TEST(WS2812, updateStripOnlyEncodesChangedLeds)
+{
+    // given
+    ws2811LedStripInit(IO_TAG_NONE);
+    setUsedLedCount(4);
+    ws2811LedStripEnable();
+    ws2811LedDataTransferInProgress = false;
+
+    const hsvColor_t red = { 0, 255, 255 };
+    const hsvColor_t blue = { 240, 255, 255 };
+    setStripColor(&red);
+
+    // when
+    hsvToRgb24Calls = 0;
+    ws2811UpdateStrip(LED_GRB, 100);
+    ws2811LedDataTransferInProgress = false;
+
+    // then the change of format from the enable refreshes the whole buffer
+    EXPECT_EQ(WS2811_DATA_BUFFER_SIZE, hsvToRgb24Calls);
+
+    // when
+    hsvToRgb24Calls = 0;
+    setLedHsv(2, &blue);
+    ws2811UpdateStrip(LED_GRB, 100);
+    ws2811LedDataTransferInProgress = false;
+
+    // then
+    EXPECT_EQ(1, hsvToRgb24Calls);
+
+    // when the brightness changes
+    hsvToRgb24Calls = 0;
+    ws2811UpdateStrip(LED_GRB, 50);
+    ws2811LedDataTransferInProgress = false;
+
+    // then
+    EXPECT_EQ(4, hsvToRgb24Calls);
+
+    // when the format changes
+    hsvToRgb24Calls = 0;
+    ws2811UpdateStrip(LED_RGB, 50);
+    ws2811LedDataTransferInProgress = false;
+
+    // then
+    EXPECT_EQ(WS2811_DATA_BUFFER_SIZE, hsvToRgb24Calls);
+
+    // when a transfer is still in progress
+    hsvToRgb24Calls = 0;
+    setLedHsv(1, &blue);
+    ws2811LedDataTransferInProgress = true;
+
+    // then the update is skipped and reported as such
+    EXPECT_FALSE(ws2811UpdateStrip(LED_RGB, 50));
+    EXPECT_EQ(0, hsvToRgb24Calls);
+
+    // and the change is sent by the next update
+    ws2811LedDataTransferInProgress = false;
+    EXPECT_TRUE(ws2811UpdateStrip(LED_RGB, 50));
+    EXPECT_EQ(1, hsvToRgb24Calls);
+}
+
 extern "C" {
 rgbColor24bpp_t* hsvToRgb24(const hsvColor_t *c)
 {
-    UNUSED(c);
-    return NULL;
+    static rgbColor24bpp_t rgb;
+
+    hsvToRgb24Calls++;
+    rgb.rgb.r = c->h;
+    rgb.rgb.g = c->s;
+    rgb.rgb.b = c->v;
+
+    return &rgb;
 }
 
 bool ws2811LedStripHardwareInit(ioTag_t ioTag)
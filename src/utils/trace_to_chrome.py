@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# Drains the flight controller hot path trace ring over MSP (MSP2_GET_TRACE) and writes
+# a Chrome trace event JSON file which can be loaded into chrome://tracing or
+# https://ui.perfetto.dev
+#
+# Usage:
+#   trace_to_chrome.py --port /dev/ttyACM0 --seconds 5 -o trace.json
+#   trace_to_chrome.py --tcp localhost:5761 --seconds 5 -o trace.json    (SITL)
+#
+# Task names may be supplied with --tasks, pointing at a file holding the output of the CLI
+# 'tasks' command; otherwise tasks are labelled by their id.
+
+import argparse
+import json
+import re
+import socket
+import struct
+import sys
+import time
+
+MSP2_GET_TRACE = 0x300C
+
+TRACE_TYPE_TASK_START = 0
+TRACE_TYPE_TASK_END = 1
+TRACE_TYPE_EVENT = 2
+
+EVENT_NAMES = [
+    "GYRO_EXTI",
+    "SPI_DMA_COMPLETE",
+    "RX_FRAME",
+]
+
+RECORD_FORMAT = "<IBBH"
+RECORD_SIZE = struct.calcsize(RECORD_FORMAT)
+
+
+def crc8_dvb_s2(crc, data):
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0xD5) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class SerialLink:
+    def __init__(self, device, baud):
+        import serial
+        self.port = serial.Serial(device, baud, timeout=1)
+
+    def write(self, data):
+        self.port.write(data)
+
+    def read(self, size):
+        data = self.port.read(size)
+        if len(data) != size:
+            raise IOError("timeout waiting for MSP reply")
+        return data
+
+
+class TcpLink:
+    def __init__(self, address):
+        host, port = address.rsplit(":", 1)
+        self.sock = socket.create_connection((host, int(port)), timeout=1)
+
+    def write(self, data):
+        self.sock.sendall(data)
+
+    def read(self, size):
+        data = b""
+        while len(data) < size:
+            chunk = self.sock.recv(size - len(data))
+            if not chunk:
+                raise IOError("connection closed")
+            data += chunk
+        return data
+
+
+def msp_v2_request(link, command, payload=b""):
+    header = struct.pack("<BHH", 0, command, len(payload))
+    frame = b"$X<" + header + payload
+    link.write(frame + bytes([crc8_dvb_s2(0, header + payload)]))
+
+    while link.read(1) != b"$":
+        pass
+    if link.read(2) != b"X>":
+        raise IOError("unexpected MSP reply")
+    header = link.read(5)
+    _, reply_command, size = struct.unpack("<BHH", header)
+    payload = link.read(size)
+    if link.read(1)[0] != crc8_dvb_s2(0, header + payload):
+        raise IOError("MSP checksum error")
+    if reply_command != command:
+        raise IOError("MSP reply to unexpected command 0x%04x" % reply_command)
+    return payload
+
+
+def read_task_names(path):
+    # Parses the CLI 'tasks' output, rows look like "01 - (      GYRO) ..." or "01 - (   SYSTEM) ..."
+    names = {}
+    with open(path) as f:
+        for line in f:
+            match = re.match(r"\s*(\d+)\s+-\s+\(\s*([^)]+?)\s*\)", line)
+            if match:
+                names[int(match.group(1))] = match.group(2)
+    return names
+
+
+def drain(link, seconds):
+    records = []
+    sequence = 0
+    cycles_per_us = 1
+    lost = 0
+    deadline = time.time() + seconds
+    while time.time() < deadline:
+        reply = msp_v2_request(link, MSP2_GET_TRACE, struct.pack("<I", sequence))
+        cycles_per_us, first, count = struct.unpack_from("<IIB", reply)
+        if records:
+            lost += first - sequence
+        offset = 9
+        for _ in range(count):
+            records.append(struct.unpack_from(RECORD_FORMAT, reply, offset))
+            offset += RECORD_SIZE
+        sequence = first + count
+        if count == 0:
+            time.sleep(0.01)
+    return records, max(cycles_per_us, 1), lost
+
+
+def to_chrome(records, cycles_per_us, task_names):
+    events = []
+    last_cycles = None
+    unwrapped = 0
+    for cycles, record_type, record_id, arg in records:
+        # unwrap the 32 bit cycle counter using the signed difference to the previous record, records
+        # written from interrupts can be a little out of order and a step back is not a wrap
+        if last_cycles is None:
+            unwrapped = cycles
+        else:
+            delta = (cycles - last_cycles) & 0xFFFFFFFF
+            if delta & 0x80000000:
+                delta -= 1 << 32
+            unwrapped += delta
+        last_cycles = cycles
+        ts = unwrapped / cycles_per_us
+        if record_type in (TRACE_TYPE_TASK_START, TRACE_TYPE_TASK_END):
+            events.append({
+                "name": task_names.get(record_id, "task %d" % record_id),
+                "cat": "task",
+                "ph": "B" if record_type == TRACE_TYPE_TASK_START else "E",
+                "ts": ts,
+                "pid": 0,
+                "tid": 0,
+            })
+        elif record_type == TRACE_TYPE_EVENT:
+            name = EVENT_NAMES[record_id] if record_id < len(EVENT_NAMES) else "event %d" % record_id
+            events.append({
+                "name": name,
+                "cat": "event",
+                "ph": "i",
+                "s": "g",
+                "ts": ts,
+                "pid": 0,
+                "tid": 1,
+                "args": {"arg": arg},
+            })
+    # restore the time order of records written from interrupts, sort is stable for equal times
+    events.sort(key=lambda event: event["ts"])
+    return {"traceEvents": events, "displayTimeUnit": "ns"}
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert the flight controller trace ring to Chrome trace JSON")
+    link_group = parser.add_mutually_exclusive_group(required=True)
+    link_group.add_argument("--port", help="serial port of the flight controller")
+    link_group.add_argument("--tcp", help="host:port of a SITL MSP socket")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--seconds", type=float, default=5.0, help="capture duration")
+    parser.add_argument("--tasks", help="file holding the CLI 'tasks' output used to name tasks")
+    parser.add_argument("-o", "--output", default="trace.json")
+    args = parser.parse_args()
+
+    link = SerialLink(args.port, args.baud) if args.port else TcpLink(args.tcp)
+    task_names = read_task_names(args.tasks) if args.tasks else {}
+
+    records, cycles_per_us, lost = drain(link, args.seconds)
+    with open(args.output, "w") as f:
+        json.dump(to_chrome(records, cycles_per_us, task_names), f)
+
+    print("%d records written to %s, %d lost to ring overrun" % (len(records), args.output, lost), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()